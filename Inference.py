@@ -46,8 +46,10 @@ try:
                         break
                     data.extend(packet)
 
+                # 클라이언트가 연결을 끊었으면 다음 연결을 받는다 (continue하면 끊긴 소켓에서 계속 빈 데이터만 받는다)
                 if len(data) < BUFFER_SIZE:
-                    continue
+                    print("Client disconnected")
+                    break
 
                 matrix_data = np.frombuffer(data, dtype=np.uint8).reshape(120, 160, 2)
 
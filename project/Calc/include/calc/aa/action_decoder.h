@@ -0,0 +1,61 @@
+#ifndef ACTION_DECODER_H
+#define ACTION_DECODER_H
+
+#include "calc/aa/model_metadata.h"
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace calc
+{
+namespace aa
+{
+
+// ControlData로 보내는 값 (조향 [-1, 1], 스로틀 [0, 1])
+struct ControlCommand
+{
+    float steering = 0.0f;
+    float throttle = 0.0f;
+};
+
+// 네트워크 출력 -> ControlCommand 변환기
+// model_metadata.json의 action space로 시작 시 한 번 만들어 두고, 프레임마다는 선택된 변환 함수만 호출한다.
+//   continuous: 출력 (steering, speed)를 그대로 MapSteering/MapThrottle에 넘긴다 (기존 Calc와 같은 매핑).
+//   discrete:   행동의 조향각/속도를 action space 안의 최대 절댓값으로 나눠 [-1, 1]로 맞춘 뒤
+//               조향/스로틀을 표로 미리 계산해 두고, 출력의 최댓값 위치로 찾는다.
+class ActionDecoder
+{
+public:
+    explicit ActionDecoder(const ModelMetadata& metadata);
+
+    // output: OutputSize()개의 네트워크 출력
+    ControlCommand Decode(const float* output) const
+    {
+        return m_decode(*this, output);
+    }
+
+    // 기대하는 네트워크 출력 개수
+    size_t OutputSize() const;
+
+    // 로그용 설명 (예: "continuous steering [-18, 23] speed [0.5, 1.5]")
+    const std::string& Description() const;
+
+private:
+    using DecodeFn = ControlCommand (*)(const ActionDecoder&, const float*);
+
+    static ControlCommand DecodeContinuous(const ActionDecoder& decoder, const float* output);
+    static ControlCommand DecodeDiscrete(const ActionDecoder& decoder, const float* output);
+
+    DecodeFn m_decode;
+    size_t m_outputSize;
+    std::string m_description;
+
+    // discrete: 행동 인덱스 -> ControlCommand
+    std::vector<ControlCommand> m_table;
+};
+
+} /// namespace aa
+} /// namespace calc
+
+#endif // ACTION_DECODER_H
@@ -19,12 +19,23 @@
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////
 #include "calc/aa/port/controldata.h"
 #include "calc/aa/port/rawdata.h"
+#include "calc/aa/inference_backend.h"
+#include "calc/aa/action_decoder.h"
+#include "calc/aa/calc_config.h"
+#include "calc/aa/deadline_monitor.h"
+#include "calc/aa/frame_inference.h"
+#include "calc/aa/frame_mailbox.h"
+#include "calc/aa/shadow_evaluator.h"
+#include "calc/aa/thread_autotune.h"
  
 #include "para/swc/port_pool.h"
  
-#include <inference_engine.hpp>
 #include <opencv2/opencv.hpp>
 #include <iostream>
+#include <memory>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
 
 namespace calc
 {
@@ -46,22 +57,55 @@ public:
     /// @brief Start software component
     void Start();
 
-    /// @brief Terminate software component
+    /// @brief Terminate software component (Start를 호출한 스레드에서 종료 요청을 받은 뒤 호출된다)
     void Terminate();
 
+    /// @brief 종료 요청 (시그널 핸들러에서 호출 가능). 정리는 Start를 호출한 스레드가 한다.
+    void RequestStop();
+
+    /// @brief 레이어별 추론 시간을 다음 프레임에서 내보내도록 요청 (시그널 핸들러에서 호출 가능)
+    void RequestProfileDump();
+
 private:
+    // 추론 엔진과 그 모델의 출력 변환기 (모델 교체 시 함께 바뀐다)
+    // 엔진(과 진행 중 요청의 콜백)이 변환기보다 먼저 해제되도록 변환기를 먼저 선언한다.
+    struct LoadedModel
+    {
+        ActionDecoder decoder;
+        std::shared_ptr<InferenceBackend> engine;
+        uint64_t generation; // 로드 순번 (주/대체/교체 모델마다 다르다, 변화 감지 기준 프레임을 모델별로 구분)
+    };
+
     void Run(); // Run software component
     void TaskReceiveREventCyclic();
     void TaskReceiveNotifyRFieldCyclic();
+    void TaskInferenceCyclic();
+    void TaskModelWatchCyclic();
+    void FrameTaskExited();
+    std::shared_ptr<LoadedModel> LoadModel(const std::string &modelPath, const std::string &metadataPath, const std::string &backend);
+    std::string MetadataPath() const;
+    ActionDecoder LoadDecoder(const std::string &metadataPath, const char *where);
+    void ReservePrimaryCpus();
+    void KeepOffShadowCpus();
+    void ResolveThreading();
+    void StartShadow();
+    void ReloadModel();
     void OnReceiveREvent(const deepracer::service::rawdata::proxy::events::REvent::SampleType &sample);
-    
-    float mapsteering(float input_value);
-    float mapThrottle(float input_value);
-
-    std::vector<float> dataProcess(std::vector<uint8_t> input_vector);
+    void OnInferenceComplete(const InferenceBackend::AsyncResult &result, int64_t frameSequence, const ActionDecoder &decoder,
+                             bool fallback, std::chrono::steady_clock::time_point arrival);
+    void RecordDeadline(bool fallback, std::chrono::steady_clock::time_point arrival);
+    void ReportDeadlines(const char *where);
+    void ReportShadow(const char *where);
+    void DumpProfile(const LoadedModel &model, const char *where);
+    void PublishControl(const ControlCommand &command);
 
 private:
-    bool m_running;          // Flag to indicate if the component is running
+    std::atomic<bool> m_running; // Flag to indicate if the component is running (작업 스레드가 읽고 메인 스레드가 바꾼다)
+
+    // 추론/모델 감시 작업 중 아직 끝나지 않은 수 (Terminate는 이 작업들이 끝난 뒤에 엔진과 포트를 정리한다)
+    std::mutex m_frameTaskMutex;
+    std::condition_variable m_frameTaskCv;
+    int m_frameTasks;
 
     ::para::swc::PortPool m_workers; // Pool of port workers
     ara::log::Logger &m_logger;      // Logger for logging messages
@@ -69,6 +113,27 @@ private:
     std::shared_ptr<calc::aa::port::ControlData> m_ControlData; // ControlData port instance
     std::shared_ptr<calc::aa::port::RawData> m_RawData;         // RawData port instance
 
+    CalcConfig m_config; // 환경 변수로 지정된 실행 옵션
+    ThreadingConfig m_threading; // 추론 스레드 구성 (지정값, 캐시된 자동 조정 결과 또는 시작 시 측정값)
+
+    std::shared_ptr<LoadedModel> m_model;         // 현재 모델 (모델 교체 시 std::atomic_load/atomic_exchange로 접근)
+    std::mutex m_modelUseMutex;                   // 추론 스레드가 프레임 하나를 처리하는 동안 잡는다 (ReloadModel이 이전 모델 사용 종료를 기다린다)
+    std::shared_ptr<LoadedModel> m_fallbackModel; // 주 모델이 기한을 계속 넘길 때 쓰는 경량 모델 (Initialize 이후 바뀌지 않는다)
+    std::atomic<int64_t> m_lastPublishedSequence; // 비동기 모드에서 마지막으로 출력한 프레임 순번
+    int64_t m_nextFrameSequence;                  // 추론 스레드가 매기는 프레임 순번 (엔진이 바뀌어도 이어진다)
+    std::atomic<uint64_t> m_modelGenerations;     // LoadModel이 마지막으로 매긴 모델 로드 순번
+
+    FrameMailbox m_mailbox;  // 수신 스레드 -> 추론 스레드 최신 프레임 전달
+    uint64_t m_staleFrames;  // 추론 스레드가 처리하지 못하고 건너뛴 프레임 수
+    std::atomic<uint64_t> m_droppedResults; // 더 최신 프레임이 먼저 나가서 버린 비동기 결과 수 (완료 스레드에서 센다)
+
+    FrameInference m_frameInference;      // 프레임별 변화 감지와 동기 추론 (추론 스레드 전용, calc_bench allocs와 같은 코드)
+    DeadlineMonitor m_deadlineMonitor;    // 프레임별 기한 초과 집계 및 대체 모델 전환 판단
+    std::atomic<bool> m_profileRequested; // SIGUSR1로 요청된 프로파일 내보내기
+    int m_stopFd;                         // SIGTERM/SIGINT 종료 요청을 Run에 알리는 eventfd
+    ShadowEvaluator m_shadow;             // 후보 모델 평가 (CALC_SHADOW_MODEL_PATH, 출력하지 않음)
+    std::vector<int> m_shadowCpus;        // 섀도 모델 전용 코어
+    std::vector<int> m_primaryCpus;       // 섀도 모델이 있을 때 주 경로 스레드가 쓰는 코어 (비어 있으면 제한하지 않음)
 
 };
  
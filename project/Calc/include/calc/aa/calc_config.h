@@ -0,0 +1,121 @@
+#ifndef CALC_CONFIG_H
+#define CALC_CONFIG_H
+
+#include "calc/aa/inference_backend.h"
+
+#include <cstddef>
+#include <string>
+
+namespace calc
+{
+namespace aa
+{
+
+// Calc 실행 옵션
+// 실행 매니페스트(Calc.json)의 environment-variables 또는 쉘 환경 변수로 지정한다.
+struct CalcConfig
+{
+    // CALC_BACKEND: 추론 백엔드 "openvino", "native" 또는 "remote" (기본: 빌드에 OpenVINO가 포함되어 있으면 openvino)
+    std::string backend = DefaultInferenceBackend();
+
+    // remote 백엔드 (Inference.py 서버로 추론을 넘긴다). 파이프라이닝은 CALC_ASYNC_REQUESTS로 켠다.
+    // CALC_REMOTE_ADDRESS: 서버 주소 host:port
+    std::string remoteAddress = "127.0.0.1:8080";
+    // CALC_REMOTE_DEADLINE_MS: 요청별 응답 기한. 넘기거나 연결이 없으면 로컬 백엔드로 추론한다.
+    size_t remoteDeadlineMs = 50;
+    // CALC_REMOTE_FALLBACK: 대체 추론 백엔드 (기본: 빌드 기본값)
+    std::string remoteFallback = DefaultInferenceBackend();
+
+    // CALC_MODEL_PATH: 로드할 IR 모델 (.xml, 같은 위치에 .bin). tools/quantize_model.py로 만든 INT8 IR도 그대로 사용 가능
+    std::string modelPath = "./model.xml";
+
+    // CALC_MODEL_METADATA: 센서 구성/전처리/action space를 정의한 model_metadata.json.
+    // 비어 있으면 모델과 같은 디렉토리의 model_metadata.json을 사용한다.
+    std::string metadataPath;
+
+    // CALC_CACHE_DIR: 컴파일된 네트워크 캐시 위치. 빈 문자열로 지정하면 캐시를 사용하지 않는다.
+    std::string cacheDir = "./model_cache";
+
+    // CALC_MODEL_POLL_MS: 모델 파일(.xml/.bin) 변경 확인 주기. 변경되면 재시작 없이 새 모델로 교체한다. 0이면 감시하지 않는다.
+    size_t modelPollMs = 1000;
+
+    // CALC_ASYNC_REQUESTS: 0이면 추론 스레드(FrameMailbox에서 최신 프레임을 받는다)에서 동기 추론, 2 이상이면 해당 개수의 InferRequest로 비동기 파이프라인 추론
+    size_t asyncRequests = 0;
+
+    // CALC_SKIP_THRESHOLD: 마지막으로 추론한 프레임과의 격자 픽셀당 평균 절대 차이(그레이 레벨)가 이 값 미만이면
+    // 추론을 생략하고 이전 조향/스로틀을 유지한다. 0이면 항상 추론한다.
+    float skipThreshold = 0.0f;
+
+    // CALC_SKIP_MAX_FRAMES: 연속으로 생략할 수 있는 최대 프레임 수
+    size_t skipMaxFrames = 2;
+
+    // CALC_FRAME_DEADLINE_MS: 프레임 도착부터 조향/스로틀 기록까지의 기한. ControlData는 100 ms마다 보내므로 그보다 늦은 결과는
+    // 한 주기를 놓친다. 기한 초과율과 대체 모델 전환 구간을 로그로 남긴다. 0이면 감시하지 않는다.
+    size_t frameDeadlineMs = 100;
+
+    // CALC_FALLBACK_MODEL_PATH: 주 모델이 기한을 계속 넘길 때 대신 쓸 경량 IR 모델 (같은 입력, 메타데이터는 그 모델 옆의
+    // model_metadata.json). 비어 있으면 전환하지 않고 집계만 한다. 모델 파일 감시 대상은 아니다.
+    std::string fallbackModelPath;
+
+    // CALC_FALLBACK_BACKEND: 대체 모델 백엔드 (기본: 빌드 기본값)
+    std::string fallbackBackend = DefaultInferenceBackend();
+
+    // CALC_DEADLINE_MISS_LIMIT: 주 모델의 최근 20프레임 중 이만큼 기한을 넘기면 대체 모델로 전환한다.
+    size_t deadlineMissLimit = 5;
+
+    // CALC_FALLBACK_HOLD_MS: 전환 후 주 모델을 다시 시도하기까지의 시간 (곧바로 다시 전환되면 최대 8배까지 늘어난다)
+    size_t fallbackHoldMs = 2000;
+
+    // CALC_CPU_THREADING: OpenVINO CPU 플러그인 스레드 구성 직접 지정 "threads=N streams=N bind=YES|NO|NUMA"
+    // (지정하면 자동 조정을 하지 않는다. 빠진 항목은 플러그인 기본값)
+    std::string cpuThreading;
+
+    // CALC_THREAD_AUTOTUNE: 1이면 시작 시 스레드 수/스트림/코어 고정 후보를 실제 모델로 측정해 가장 빠른 구성을 쓴다 (openvino 백엔드).
+    // 측정은 수 초가 걸려 실행 매니페스트의 startup-timeout을 넘길 수 있으므로 기본은 0이다.
+    // 결과는 CALC_CACHE_DIR에 머신과 모델별로 저장되고, 저장된 결과는 0이어도 사용한다. 없으면 플러그인 기본값
+    size_t threadAutotune = 0;
+
+    // CALC_CPU_BUDGET: 추론에 쓸 수 있는 최대 코어 수. 0이면 논리 코어 수 - 1 (Sensor 캡처와 포트 워커 몫)
+    size_t cpuBudget = 0;
+
+    // CALC_PROFILE: 1이면 레이어별 추론 시간을 모은다 (OpenVINO는 플러그인 성능 카운터 사용). 시간 표는 로그로,
+    // JSON은 CALC_PROFILE_PATH로 내보낸다. 내보내기는 CALC_PROFILE_EVERY 프레임마다, SIGUSR1을 받을 때, 종료 시 한다.
+    bool profiling = false;
+
+    // CALC_PROFILE_WINDOW: 통계를 낼 최근 추론 수
+    size_t profileWindow = 100;
+
+    // CALC_PROFILE_EVERY: 주기적으로 내보낼 프레임 간격 (0이면 SIGUSR1과 종료 시에만)
+    size_t profileEvery = 0;
+
+    // CALC_PROFILE_PATH: JSON 출력 파일 (내보낼 때마다 덮어쓴다)
+    std::string profilePath = "./calc_profile.json";
+
+    // CALC_SHADOW_MODEL_PATH: 실차 평가용 후보 IR 모델 (메타데이터는 그 모델 옆의 model_metadata.json). 같은 프레임을 낮은 우선순위로
+    // 추론해 주 모델 출력과의 차이와 추론 시간을 로그로 남기고, 결과는 ControlData로 보내지 않는다. 비어 있으면 사용하지 않는다.
+    std::string shadowModelPath;
+
+    // CALC_SHADOW_BACKEND: 섀도 모델 백엔드 (기본: 빌드 기본값)
+    std::string shadowBackend = DefaultInferenceBackend();
+
+    // CALC_SHADOW_CPUS: 섀도 모델을 고정할 코어 목록 "2,3" (비어 있으면 코어가 2개 이상일 때 마지막 코어)
+    // 주 모델과 Calc 작업 스레드는 이 코어를 쓰지 않는다.
+    std::string shadowCpus;
+
+    // CALC_SHADOW_NICE: 섀도 스레드 nice 값 (0~19, 클수록 주 경로에 양보)
+    size_t shadowNice = 10;
+
+    // CALC_SHADOW_HOLD_MS: 주 모델 기한이 위험할 때 섀도 추론을 멈추는 시간. 세 번 멈추면 섀도 모델을 내려놓는다.
+    size_t shadowHoldMs = 5000;
+
+    // CALC_INPUT_PRECISION: FP32(기본) 또는 U8 (U8이면 float 변환을 컴파일된 네트워크에서 수행)
+    InputPrecision inputPrecision = InputPrecision::FP32;
+
+    // 환경 변수에서 설정을 읽는다. 지정되지 않았거나 잘못된 값은 기본값을 사용한다.
+    static CalcConfig FromEnvironment();
+};
+
+} /// namespace aa
+} /// namespace calc
+
+#endif // CALC_CONFIG_H
@@ -0,0 +1,37 @@
+#ifndef CONTROL_MAPPING_H
+#define CONTROL_MAPPING_H
+
+#include <algorithm>
+#include <cmath>
+
+namespace calc
+{
+namespace aa
+{
+
+// 네트워크 출력([-1, 1]) -> ControlData 값 매핑
+// Calc와 오프라인 평가 도구(calc_eval)가 같은 결과를 내도록 한 곳에서 정의한다.
+// 차량의 조향/스로틀은 이 매핑에 맞춰 조정되어 있다. 모델마다 다른 출력 해석은 ActionDecoder(model_metadata.json 기반)가 맡는다.
+
+// 속도(m/s) -> 스로틀 이차 함수 계수 (y = kThrottleQuadratic * x^2 + kThrottleLinear * x)
+constexpr float kThrottleQuadratic = -0.133333f;
+constexpr float kThrottleLinear = 0.733333f;
+
+// 조향: [-1, 1]로 제한
+inline float MapSteering(float input_value)
+{
+    return std::max(-1.0f, std::min(1.0f, input_value));
+}
+
+// 스로틀: 이차 함수에 따라 매핑 후 [0, 1]로 제한
+inline float MapThrottle(float input_value)
+{
+    float input = std::fabs(input_value);
+    float output = kThrottleQuadratic * input * input + kThrottleLinear * input;
+    return std::max(0.0f, std::min(1.0f, output));
+}
+
+} /// namespace aa
+} /// namespace calc
+
+#endif // CONTROL_MAPPING_H
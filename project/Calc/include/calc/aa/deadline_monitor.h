@@ -0,0 +1,96 @@
+#ifndef DEADLINE_MONITOR_H
+#define DEADLINE_MONITOR_H
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+namespace calc
+{
+namespace aa
+{
+
+// 프레임별 기한 감시 및 대체(경량) 모델 전환 판단기
+//
+// 프레임이 도착한 시각부터 조향/스로틀이 기록된 시각까지를 기한(deadline)과 비교한다.
+// 주 모델이 최근 window 프레임 중 missLimit 프레임 이상 기한을 넘기면 대체 모델로 전환(degraded)하고,
+// hold 동안 대체 모델을 쓴 뒤 주 모델을 다시 시도한다. 다시 시도하자마자 또 전환되면 hold를 두 배씩(최대 kMaxHoldScale배) 늘린다.
+// 추론 스레드와 비동기 완료 콜백에서 함께 호출되므로 내부에서 잠근다.
+class DeadlineMonitor
+{
+public:
+    using Clock = std::chrono::steady_clock;
+
+    struct Settings
+    {
+        std::chrono::milliseconds deadline{0}; // 0이면 감시하지 않는다
+        size_t window = 20;
+        size_t missLimit = 5;
+        std::chrono::milliseconds hold{2000};
+        bool fallbackAvailable = false;        // false면 기한 초과만 집계하고 전환하지 않는다
+    };
+
+    enum class Event
+    {
+        None,
+        Degraded,  // 주 모델 -> 대체 모델
+        Recovered  // 대체 모델 -> 주 모델
+    };
+
+    struct Stats
+    {
+        uint64_t frames = 0;          // 기한을 확인한 프레임 (주 + 대체)
+        uint64_t misses = 0;
+        uint64_t fallbackFrames = 0;
+        uint64_t fallbackMisses = 0;
+        uint64_t episodes = 0;        // 대체 모델로 전환한 횟수
+        double fallbackMs = 0.0;      // 끝난 전환 구간의 누적 길이
+        double lastEpisodeMs = 0.0;   // 마지막으로 끝난 전환 구간의 길이와 그동안 처리한 프레임 수
+        uint64_t lastEpisodeFrames = 0;
+        bool degraded = false;
+        double worstLatencyMs = 0.0;
+    };
+
+    static constexpr uint32_t kMaxHoldScale = 8;
+
+    DeadlineMonitor();
+
+    DeadlineMonitor(const DeadlineMonitor&) = delete;
+    DeadlineMonitor& operator=(const DeadlineMonitor&) = delete;
+
+    // 설정을 바꾸고 통계를 초기화한다 (Initialize에서 한 번).
+    void Configure(const Settings& settings);
+
+    bool Enabled() const;
+
+    // 추론 스레드: 이번 프레임을 대체 모델로 추론할지. hold가 지났으면 주 모델로 돌아가며 event에 Recovered가 들어간다.
+    bool UseFallback(Clock::time_point now, Event& event);
+
+    // 결과가 기록된(또는 실패한) 시각을 기록한다. fallback은 그 프레임을 추론한 쪽. 주 모델이 한도를 넘기면 Degraded를 반환한다.
+    Event Record(bool fallback, Clock::time_point arrival, Clock::time_point completed);
+
+    Stats GetStats() const;
+
+private:
+    void EndEpisode(Clock::time_point now);
+
+    mutable std::mutex m_mutex;
+    Settings m_settings;
+    std::vector<uint8_t> m_recent; // 주 모델의 최근 window개 기한 초과 여부 (고정 크기 링 버퍼, 프레임마다 할당하지 않는다)
+    size_t m_recentCount;
+    size_t m_recentNext;
+    size_t m_recentMisses;
+    bool m_degraded;
+    Clock::time_point m_degradedSince;
+    uint64_t m_episodeFrames;
+    uint32_t m_holdScale;
+    uint64_t m_primarySinceRecovery; // 주 모델로 돌아온 뒤 기록한 프레임 수 (곧바로 다시 전환되는지 판단)
+    Stats m_stats;
+};
+
+} /// namespace aa
+} /// namespace calc
+
+#endif // DEADLINE_MONITOR_H
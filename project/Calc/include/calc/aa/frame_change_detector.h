@@ -0,0 +1,73 @@
+#ifndef FRAME_CHANGE_DETECTOR_H
+#define FRAME_CHANGE_DETECTOR_H
+
+#include "calc/aa/stereo_preprocess.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace calc
+{
+namespace aa
+{
+
+// 변화 감지용 격자: 좌/우 평면에서 kChangeGridRowStep 줄마다 한 줄씩 (한 줄은 전체 폭)
+constexpr size_t kChangeGridRowStep = 4;
+constexpr size_t kChangeGridRows = kStereoFrameSize / kStereoWidth / kChangeGridRowStep;
+constexpr size_t kChangeGridSize = kChangeGridRows * kStereoWidth;
+
+// 스테레오 프레임(좌측 평면 뒤에 우측 평면)에서 격자 줄만 grid(kChangeGridSize 바이트)로 복사한다.
+void SampleChangeGrid(const uint8_t* frame, uint8_t* grid);
+
+// 프레임의 격자 줄과 grid의 절대 차이 합 (SAD). 실행 CPU가 지원하는 가장 넓은 psadbw 구현(AVX2 > SSE2 > 스칼라)을 쓴다.
+uint64_t ChangeGridSad(const uint8_t* frame, const uint8_t* grid);
+
+// 검증 및 벤치마크 기준용 스칼라 구현
+uint64_t ChangeGridSadReference(const uint8_t* frame, const uint8_t* grid);
+
+// ChangeGridSad가 사용하는 구현 이름 ("avx2", "sse2", "scalar")
+const char* ChangeGridIsa();
+
+// 연속 프레임 추론 생략 판단기
+// 마지막으로 추론한 프레임(기준 프레임)과 격자 픽셀당 평균 절대 차이가 threshold 미만이면 추론을 생략하고
+// 이전 조향/스로틀을 그대로 쓰도록 한다. 생략은 최대 maxConsecutiveSkips 프레임까지만 연속으로 허용한다.
+// 기준 프레임은 추론할 때만 바뀌므로 조금씩 변하는 장면도 누적 차이로 감지된다. 단일 스레드(추론 스레드) 전용
+class FrameChangeDetector
+{
+public:
+    // threshold: 격자 픽셀당 평균 절대 차이 (그레이 레벨 0~255). 0이면 항상 추론한다.
+    FrameChangeDetector(float threshold = 0.0f, uint32_t maxConsecutiveSkips = 0);
+
+    bool Enabled() const;
+
+    // true면 추론을 생략한다. false면 호출자가 이 프레임을 추론하며, 이 프레임이 새 기준 프레임이 된다.
+    bool ShouldSkip(const uint8_t* frame);
+
+    // 기준 프레임을 버린다 (모델 교체, 추론 실패 등 이전 결과를 재사용하면 안 될 때). 다음 프레임은 반드시 추론한다.
+    void Reset();
+
+    // 마지막 판단에서의 격자 픽셀당 평균 절대 차이
+    float LastDifference() const;
+
+    uint64_t FrameCount() const;
+    uint64_t SkippedCount() const;
+
+    // 생략한 프레임 비율 (0~1)
+    double SkipRate() const;
+
+private:
+    uint64_t m_thresholdSad; // threshold * kChangeGridSize (프레임마다 정수 비교만 하도록 미리 계산)
+    uint32_t m_maxSkips;
+    std::vector<uint8_t> m_reference;
+    bool m_hasReference;
+    uint32_t m_consecutiveSkips;
+    uint64_t m_lastSad;
+    uint64_t m_frames;
+    uint64_t m_skipped;
+};
+
+} /// namespace aa
+} /// namespace calc
+
+#endif // FRAME_CHANGE_DETECTOR_H
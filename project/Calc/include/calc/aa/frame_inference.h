@@ -0,0 +1,58 @@
+#ifndef FRAME_INFERENCE_H
+#define FRAME_INFERENCE_H
+
+#include "calc/aa/action_decoder.h"
+#include "calc/aa/frame_change_detector.h"
+#include "calc/aa/inference_backend.h"
+
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+namespace calc
+{
+namespace aa
+{
+
+// 추론 스레드의 프레임 처리 (Calc::TaskInferenceCyclic과 calc_bench allocs가 같은 코드를 쓴다)
+//
+// 모델이 바뀌면 기준 프레임을 버리고 출력 버퍼 용량을 확보한다. 마지막으로 추론한 프레임과 거의 같은 프레임은 건너뛰고,
+// 동기 엔진이면 추론해 조향/스로틀로 변환한다. 포트 출력, 기한 기록, 섀도 모델 전달은 호출자가 한다.
+// 추론 스레드 전용이며, InvalidateReference만 다른 스레드(비동기 완료 콜백)에서 호출할 수 있다.
+class FrameInference
+{
+public:
+    enum class Outcome
+    {
+        Skipped,  // 바뀌지 않은 프레임: 이전 조향/스로틀을 유지한다
+        Submit,   // 비동기 엔진: 호출자가 submitAsync로 제출한다
+        Inferred  // command에 결과
+    };
+
+    FrameInference();
+
+    // 변화 감지 설정 (CALC_SKIP_THRESHOLD, CALC_SKIP_MAX_FRAMES). 추론 스레드 시작 전에 호출한다.
+    void Configure(float skipThreshold, uint32_t skipMaxFrames);
+
+    // modelGeneration: 모델을 로드할 때마다 새로 매기는 번호 (1부터, 바뀌면 기준 프레임을 버린다).
+    // 해제된 모델의 주소를 새 모델이 다시 받을 수 있으므로 포인터 대신 번호로 구분한다.
+    // 추론이 실패하면 기준 프레임을 버리고 예외를 다시 던진다.
+    Outcome Process(const std::vector<uint8_t>& frame, uint64_t modelGeneration, InferenceBackend& engine, const ActionDecoder& decoder,
+                    ControlCommand& command);
+
+    // 기준 프레임의 결과가 ControlData로 나가지 못했을 때 (실패, 순서가 밀려 버린 결과). 다음 프레임은 추론한다.
+    void InvalidateReference();
+
+    const FrameChangeDetector& Detector() const;
+
+private:
+    FrameChangeDetector m_detector;
+    uint64_t m_modelGeneration; // 0: 아직 처리한 모델 없음
+    std::atomic<bool> m_referenceStale;
+    std::vector<float> m_output; // 동기 추론 출력 버퍼 (모델이 바뀔 때 용량을 확보해 프레임마다 할당하지 않는다)
+};
+
+} /// namespace aa
+} /// namespace calc
+
+#endif // FRAME_INFERENCE_H
@@ -0,0 +1,65 @@
+#ifndef FRAME_MAILBOX_H
+#define FRAME_MAILBOX_H
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+namespace calc
+{
+namespace aa
+{
+
+// 단일 생산자 / 단일 소비자용 "최신 프레임 우선" 1칸 우편함
+//
+// 세 개의 고정 버퍼를 원자적 인덱스 교환으로 돌려 쓰는 트리플 버퍼로, 생산자와 소비자가 서로를 막지 않는다.
+// 소비자가 아직 가져가지 않은 프레임은 새 프레임으로 덮어쓰며, 소비자는 항상 가장 최근 프레임만 받는다.
+// 뮤텍스/조건 변수는 소비자를 깨우는 용도로만 쓰이고 프레임 데이터 경로에는 관여하지 않는다.
+class FrameMailbox
+{
+public:
+    explicit FrameMailbox(size_t frameSize);
+
+    // 생산자: 빈 버퍼에 프레임을 복사해 게시한다. size는 생성 시 지정한 frameSize와 같아야 한다.
+    void Publish(const uint8_t* data, size_t size);
+
+    // 소비자: 새 프레임이 있으면 true를 반환하고 frame을 최신 프레임에 연결한다.
+    // frame은 다음 Take 호출 전까지 유효하다. skipped에는 가져가지 못하고 덮어쓰인 프레임 수가 들어간다.
+    bool TryTake(const std::vector<uint8_t>*& frame, uint64_t& skipped);
+
+    // TryTake와 같으나 새 프레임이 올 때까지 최대 timeout 동안 대기한다.
+    bool WaitTake(const std::vector<uint8_t>*& frame, uint64_t& skipped, std::chrono::milliseconds timeout);
+
+    // 지금까지 게시된 프레임 수
+    uint64_t PublishedCount() const;
+
+    // 소비자: 마지막으로 가져간 프레임이 게시된 시각 (프레임별 기한의 기준)
+    std::chrono::steady_clock::time_point TakenPublishTime() const;
+
+private:
+    static constexpr uint32_t kIndexMask = 0x3;
+    static constexpr uint32_t kFresh = 0x4;
+
+    std::vector<uint8_t> m_buffers[3];
+    uint64_t m_sequences[3];
+    std::chrono::steady_clock::time_point m_publishTimes[3];
+
+    std::atomic<uint32_t> m_middle; // 생산자와 소비자가 교환하는 버퍼 인덱스 (+ 새 프레임 표시)
+    uint32_t m_back;                // 생산자 전용 버퍼 인덱스
+    uint32_t m_front;               // 소비자 전용 버퍼 인덱스
+
+    std::atomic<uint64_t> m_published;
+    uint64_t m_lastTaken;           // 소비자가 마지막으로 가져간 프레임 순번
+
+    std::mutex m_waitMutex;
+    std::condition_variable m_waitCv;
+};
+
+} /// namespace aa
+} /// namespace calc
+
+#endif // FRAME_MAILBOX_H
@@ -0,0 +1,122 @@
+#ifndef INFERENCE_BACKEND_H
+#define INFERENCE_BACKEND_H
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+// 네트워크 입력 정밀도
+enum class InputPrecision {
+    FP32, // 전처리에서 float로 변환해 Blob에 기록
+    U8    // 카메라 데이터(uint8)를 그대로 Blob에 기록, float 변환과 정규화는 컴파일된 네트워크 안에서 수행
+};
+
+// 모델 로드 옵션 (네트워크 컴파일 전에 결정되어야 하는 값)
+struct InferenceOptions {
+    InputPrecision precision = InputPrecision::FP32;
+    float inputScale = 1.0f;  // 입력 정규화: x * inputScale + inputOffset
+    float inputOffset = 0.0f;
+    std::string cacheDir;     // 컴파일된 네트워크 캐시 디렉터리 (비어 있으면 캐시 사용 안 함)
+    size_t threads = 0;       // 추론 스레드 수 (0이면 백엔드 기본값, native 백엔드는 무시)
+    size_t streams = 0;       // OpenVINO CPU 스트림 수 (처리량 모드, 0이면 플러그인 기본값). native는 enableAsync 요청 수만큼 워커 스레드를 쓴다.
+    std::string bindThreads;  // OpenVINO 추론 스레드 코어 고정 "YES", "NO", "NUMA" (비어 있으면 플러그인 기본값, native 백엔드는 무시)
+    size_t batch = 1;         // 한 번에 추론할 프레임 수. 입력은 batch개의 프레임을 이어 붙인 것, 출력도 프레임 순서대로 이어진다.
+
+    // 프로파일링 모드: 추론마다 레이어별 실행 시간을 모아 최근 profileWindow번의 통계를 layerProfile()로 제공한다.
+    // OpenVINO는 플러그인 성능 카운터(KEY_PERF_COUNT)를 켜므로 추론이 약간 느려진다.
+    bool profiling = false;
+    size_t profileWindow = 100;
+
+    // remote 백엔드 전용
+    std::string remoteAddress = "127.0.0.1:8080"; // Inference.py 서버 주소 (host:port)
+    double remoteDeadlineMs = 50.0;               // 요청별 응답 기한. 넘기면 로컬 백엔드로 대체 추론
+    std::string remoteFallback;                   // 대체 추론 백엔드 이름 (비어 있으면 DefaultInferenceBackend())
+};
+
+// 추론 백엔드 인터페이스
+// Calc와 calc_bench는 이 인터페이스만 사용하며, 실제 구현은 CreateInferenceBackend로 선택한다.
+//   - "openvino": OpenVINO Inference Engine (InferenceEngineWrapper, CALC_WITH_OPENVINO 빌드에서만 사용 가능)
+//   - "native"  : 외부 라이브러리 없이 IR(.xml/.bin)을 직접 실행하는 CPU 엔진 (NativeInferenceEngine)
+//                 DEEP_CONVOLUTIONAL_NETWORK_SHALLOW 구조면 shape 특화 커널을 사용한다.
+//   - "native-generic": 특화 커널 없이 일반 연산만 사용하는 NativeInferenceEngine (비교용)
+//   - "remote"  : Inference.py 서버로 추론을 넘기고, 기한 초과나 연결 끊김 시 로컬 백엔드로 대체 (RemoteInferenceClient)
+class InferenceBackend {
+public:
+    // 비동기 추론 결과
+    struct AsyncResult {
+        bool ok;                    // 추론 성공 여부
+        uint64_t sequence;          // submitAsync 호출 순번 (0부터 증가)
+        std::vector<float> output;  // 네트워크 출력
+        double queuedMs;            // 제출부터 완료 콜백까지 걸린 시간
+        size_t inFlight;            // 완료 시점에 진행 중이던 요청 수 (자기 자신 포함)
+        bool fallback = false;      // remote 백엔드가 원격 결과 대신 로컬 대체 추론 결과를 낸 경우
+        std::string error;          // 실패 이유 (ok가 false일 때, 호출자가 로그로 남긴다)
+    };
+    using CompletionCallback = std::function<void(const AsyncResult&)>;
+
+    // 레이어별 실행 시간 (프로파일링 모드, 최근 창 기준)
+    struct LayerTiming {
+        std::string name;
+        std::string type;       // 레이어 종류
+        std::string execType;   // 실제 실행한 구현
+        double meanUs = 0.0;
+        double maxUs = 0.0;
+        double share = 0.0;     // 레이어 평균 합에서 차지하는 비율 (0~1)
+        uint64_t samples = 0;   // 창 안의 추론 수
+    };
+
+    virtual ~InferenceBackend() = default;
+
+    // 백엔드 이름 (로그 출력용)
+    virtual std::string name() const = 0;
+
+    // 입력: Sensor가 보낸 좌/우 평면 프레임 (kStereoFrameSize 바이트) x options().batch
+    virtual void setInputData(const std::vector<uint8_t>& inputData) = 0;
+    virtual std::vector<float> runInference() = 0;
+
+    // runInference와 같으나 결과를 호출자의 버퍼에 쓴다. output의 용량이 충분하면 추론마다 힙 할당을 하지 않는다
+    // (native, openvino). 기본 구현은 runInference 결과를 복사한다.
+    virtual void runInferenceInto(std::vector<float>& output);
+
+    virtual const InferenceOptions& options() const = 0;
+
+    // 모델 로드 결과: 캐시에서 가져왔는지 여부와 로드에 걸린 시간
+    virtual bool loadedFromCache() const { return false; }
+    virtual double loadTimeMs() const = 0;
+
+    // 캐시를 가져오거나 저장하지 못한 이유 (로드는 계속되므로 경고용, 문제가 없으면 빈 문자열)
+    virtual std::string cacheWarning() const { return std::string(); }
+
+    // 비동기 파이프라인. 지원하지 않는 백엔드는 enableAsync를 무시하고(isAsync() == false),
+    // submitAsync는 호출 스레드에서 동기로 추론한 뒤 콜백을 호출한다.
+    virtual void enableAsync(size_t numRequests) { (void)numRequests; }
+    virtual bool isAsync() const { return false; }
+    virtual uint64_t submitAsync(const std::vector<uint8_t>& inputData, CompletionCallback callback);
+    virtual size_t inFlight() const { return 0; }
+    virtual void waitAll() {}
+
+    // 누적 지연 통계 (로그용, 통계를 모으지 않는 백엔드는 빈 문자열)
+    virtual std::string latencyReport() const { return std::string(); }
+
+    // 프로파일링 모드의 레이어별 실행 시간 (평균 내림차순). 프로파일링이 꺼져 있거나 지원하지 않으면 비어 있다.
+    virtual std::vector<LayerTiming> layerProfile() const { return std::vector<LayerTiming>(); }
+
+private:
+    uint64_t syncSequence = 0;
+};
+
+// 컴파일된 로컬 백엔드 목록 (CreateInferenceBackend에 전달 가능한 이름, 서버가 필요한 "remote"는 제외)
+std::vector<std::string> AvailableInferenceBackends();
+
+// 기본 백엔드 이름: OpenVINO가 빌드에 포함되어 있으면 "openvino", 아니면 "native"
+std::string DefaultInferenceBackend();
+
+// backendName에 해당하는 백엔드를 만든다. deviceName은 OpenVINO 백엔드에서만 사용한다.
+// 알 수 없거나 빌드에 포함되지 않은 백엔드면 std::invalid_argument, 모델 로드 실패는 각 백엔드의 예외를 그대로 던진다.
+std::unique_ptr<InferenceBackend> CreateInferenceBackend(const std::string& backendName, const std::string& modelPath,
+                                                         const std::string& deviceName, const InferenceOptions& options = InferenceOptions());
+
+#endif // INFERENCE_BACKEND_H
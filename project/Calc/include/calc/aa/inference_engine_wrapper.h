@@ -1,29 +1,104 @@
 #ifndef INFERENCE_ENGINE_WRAPPER_H
 #define INFERENCE_ENGINE_WRAPPER_H
 
+#include "calc/aa/inference_backend.h"
+#include "calc/aa/layer_profiler.h"
+
 #include <inference_engine.hpp> // Inference Engine API 헤더
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
 #include <string>
 #include <vector>
 
-class InferenceEngineWrapper {
+// OpenVINO Inference Engine 백엔드
+class InferenceEngineWrapper : public InferenceBackend {
 public:
-    InferenceEngineWrapper(const std::string& modelPath, const std::string& deviceName);
-    ~InferenceEngineWrapper();
+    InferenceEngineWrapper(const std::string& modelPath, const std::string& deviceName, const InferenceOptions& options = InferenceOptions());
+    ~InferenceEngineWrapper() override;
+
+    std::string name() const override;
+
+    // 입력: Sensor가 보낸 좌/우 평면 프레임 (kStereoFrameSize 바이트)
+    void setInputData(const std::vector<uint8_t>& inputData) override;
+    std::vector<float> runInference() override;
+    void runInferenceInto(std::vector<float>& output) override;
+
+    const InferenceOptions& options() const override;
+
+    // 모델 로드 결과: 캐시에서 가져왔는지 여부와 로드(읽기 + 컴파일 또는 가져오기)에 걸린 시간
+    bool loadedFromCache() const override;
+    double loadTimeMs() const override;
+    std::string cacheWarning() const override;
+
+    // 비동기 모드: numRequests개의 InferRequest를 만들어 파이프라인으로 사용한다.
+    // 한 요청이 추론 중인 동안 다음 프레임의 전처리를 다른 요청에서 진행할 수 있다.
+    void enableAsync(size_t numRequests) override;
+    bool isAsync() const override;
+
+    // 유휴 요청에 입력을 채우고 StartAsync 한다. 유휴 요청이 없으면 하나가 완료될 때까지 대기한다.
+    // callback은 추론 완료 시 Inference Engine 스레드에서 호출된다.
+    uint64_t submitAsync(const std::vector<uint8_t>& inputData, CompletionCallback callback) override;
 
-    void setInputData(const std::vector<uint8_t>& inputData);
-    std::vector<float> runInference();
+    // 현재 진행 중인 비동기 요청 수
+    size_t inFlight() const override;
+
+    // 진행 중인 비동기 요청이 모두 끝날 때까지 대기
+    void waitAll() override;
+
+    // 프로파일링 모드: 플러그인 성능 카운터(GetPerformanceCounts)의 레이어별 실행 시간 + 입력 전처리 시간
+    std::vector<LayerTiming> layerProfile() const override;
 
 private:
+    struct AsyncSlot {
+        InferenceEngine::InferRequest request;
+        CompletionCallback callback;
+        uint64_t sequence = 0;
+        std::chrono::steady_clock::time_point submitTime;
+        double fillUs = 0.0; // 프로파일링 모드의 입력 전처리 시간
+    };
+
     InferenceEngine::Core ie;                          // Inference Engine Core 객체
     InferenceEngine::ExecutableNetwork executableNet; // 컴파일된 네트워크
     InferenceEngine::InferRequest inferRequest;       // 추론 요청 객체
-    InferenceEngine::InputsDataMap inputInfo;         // 입력 정보
-    InferenceEngine::OutputsDataMap outputInfo;       // 출력 정보
+    std::string inputName;                            // 입력 이름
+    std::string outputName;                           // 출력 이름
 
     std::string modelPath;
     std::string deviceName;
 
+    InferenceOptions opts;
+
+    bool fromCache = false;
+    std::string cacheError; // 캐시 가져오기/저장 실패 이유 (Calc가 로그로 남긴다)
+    double loadMs = 0.0;
+
+    std::unique_ptr<calc::aa::LayerProfiler> profiler; // opts.profiling일 때만 생성
+    double syncFillUs = 0.0;
+
+    std::vector<std::unique_ptr<AsyncSlot>> asyncSlots; // 비동기 요청 전체
+    std::vector<AsyncSlot*> idleSlots;                  // 유휴 요청 (asyncMutex로 보호)
+    std::mutex asyncMutex;
+    std::condition_variable asyncCv;
+    std::atomic<size_t> inFlightCount{0};
+    uint64_t nextSequence = 0;
+
     void loadModel(); // 모델 로드 함수
+    void compileModel(); // IR 읽기 + 디바이스용 컴파일
+    std::map<std::string, std::string> pluginConfig() const; // LoadNetwork/ImportNetwork에 전달할 CPU 플러그인 설정
+    std::string cacheFilePath() const;
+    bool importFromCache(const std::string& cachePath);
+    void exportToCache(const std::string& cachePath);
+    void insertNormalization(InferenceEngine::CNNNetwork& network); // U8 입력일 때 정규화를 네트워크에 추가
+    void fillInput(InferenceEngine::InferRequest& request, const std::vector<uint8_t>& inputData);
+    std::vector<float> readOutput(InferenceEngine::InferRequest& request);
+    void onAsyncComplete(AsyncSlot* slot, InferenceEngine::StatusCode status);
+    double fillInputTimed(InferenceEngine::InferRequest& request, const std::vector<uint8_t>& inputData);
+    void recordProfile(InferenceEngine::InferRequest& request, double fillUs);
 };
 
 #endif // INFERENCE_ENGINE_WRAPPER_H
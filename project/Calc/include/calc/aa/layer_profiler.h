@@ -0,0 +1,66 @@
+#ifndef LAYER_PROFILER_H
+#define LAYER_PROFILER_H
+
+#include "calc/aa/inference_backend.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace calc
+{
+namespace aa
+{
+
+// 추론 한 번에서 잰 레이어 하나의 실행 시간
+struct LayerSample
+{
+    std::string name;
+    std::string type;     // 레이어 종류 (Convolution, MatMul, ...)
+    std::string execType; // 실제 실행한 구현 (OpenVINO: jit_avx2_FP32 등, native: 커널 ISA)
+    double us = 0.0;
+};
+
+// 최근 window번의 추론에 대한 레이어별 실행 시간 집계 (백엔드의 프로파일링 모드에서 사용)
+// 여러 완료 스레드에서 Record를 호출할 수 있도록 내부에서 잠근다.
+class LayerProfiler
+{
+public:
+    explicit LayerProfiler(size_t window = 100);
+
+    // 추론 한 번의 레이어별 시간. 처음 보는 레이어는 목록에 추가되고, 이번 추론에 없는 레이어는 0으로 센다.
+    void Record(const std::vector<LayerSample>& layers);
+
+    // 창 안의 평균 시간 내림차순
+    std::vector<InferenceBackend::LayerTiming> Snapshot() const;
+
+private:
+    struct Layer
+    {
+        std::string name;
+        std::string type;
+        std::string execType;
+    };
+
+    mutable std::mutex m_mutex;
+    size_t m_window;
+    std::vector<Layer> m_layers;
+    std::unordered_map<std::string, size_t> m_index;
+    std::vector<std::vector<double>> m_samples; // 창 크기만큼의 링 버퍼, 샘플마다 레이어 순서대로
+    size_t m_next;
+    size_t m_count;
+};
+
+// 사람이 읽는 표 (평균 내림차순, maxRows가 0이 아니면 상위 maxRows개만)
+std::string FormatLayerProfileTable(const std::vector<InferenceBackend::LayerTiming>& layers, size_t maxRows = 0);
+
+// 도구 입력용 JSON: {"backend", "samples", "total_us", "layers": [{"name", "type", "exec_type", "mean_us", "max_us", "share"}]}
+std::string LayerProfileJson(const std::vector<InferenceBackend::LayerTiming>& layers, const std::string& backend);
+
+} /// namespace aa
+} /// namespace calc
+
+#endif // LAYER_PROFILER_H
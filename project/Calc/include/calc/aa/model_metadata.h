@@ -0,0 +1,63 @@
+#ifndef MODEL_METADATA_H
+#define MODEL_METADATA_H
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace calc
+{
+namespace aa
+{
+
+// model_metadata.json (DeepRacer 학습 결과와 함께 배포되는 모델 설명)
+//   sensor: 입력 센서 구성, preprocess_type: 입력 전처리, action_space(_type): 네트워크 출력의 의미
+enum class ActionSpaceType
+{
+    Continuous, // 출력 2개 (steering, throttle)를 기존 Calc 매핑(MapSteering/MapThrottle)으로 그대로 변환
+    Discrete    // 출력 N개 (행동별 확률), 가장 큰 값의 행동을 action_space[i]에서 찾는다
+};
+
+struct ActionRange
+{
+    float low = 0.0f;
+    float high = 0.0f;
+};
+
+struct DiscreteAction
+{
+    float steeringAngle = 0.0f; // 도
+    float speed = 0.0f;         // m/s
+};
+
+// continuous 모델의 steeringAngle/speed 범위는 파일에서 읽고 검증하지만 출력 변환에는 쓰지 않는다 (ActionDecoder는 기존 매핑을 따른다).
+struct ModelMetadata
+{
+    std::vector<std::string> sensors;
+    std::string neuralNetwork;
+    std::string preprocessType;
+    ActionSpaceType actionSpaceType = ActionSpaceType::Continuous;
+    ActionRange steeringAngle;           // continuous
+    ActionRange speed;                   // continuous
+    std::vector<DiscreteAction> actions; // discrete
+
+    // 파일을 읽고 Calc가 처리할 수 있는 구성인지 확인한다. 실패하면 std::runtime_error를 던진다.
+    static ModelMetadata Load(const std::string& path);
+
+    // 메타데이터가 없는 모델용: 스테레오 그레이스케일 입력, continuous 출력을 그대로 조향/스로틀로 쓰는 기존 Calc의 해석
+    static ModelMetadata Baseline();
+
+    // path가 있으면 Load, 없으면 Baseline (Calc, calc_eval, calc_bench 공용). found에 파일을 읽었는지 돌려준다.
+    static ModelMetadata LoadOrBaseline(const std::string& path, bool& found);
+
+    // 모델 경로(.xml)와 같은 디렉토리의 model_metadata.json
+    static std::string DefaultPath(const std::string& modelPath);
+
+    // 네트워크가 내야 하는 출력 개수 (continuous: 2, discrete: 행동 수)
+    size_t OutputSize() const;
+};
+
+} /// namespace aa
+} /// namespace calc
+
+#endif // MODEL_METADATA_H
@@ -0,0 +1,122 @@
+#ifndef NATIVE_INFERENCE_ENGINE_H
+#define NATIVE_INFERENCE_ENGINE_H
+
+#include "calc/aa/inference_backend.h"
+#include "calc/aa/layer_profiler.h"
+#include "calc/aa/shallow_network.h"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// 외부 라이브러리 없이 OpenVINO IR(.xml + .bin)을 직접 실행하는 단일 스레드 CPU 엔진
+// saved_model.xml에 사용된 연산만 지원한다:
+//   Parameter, Const, Convert, Transpose, Convolution, Add, Multiply, ReLU, Reshape, MatMul, Unsqueeze, StridedSlice, Result
+// 지원하지 않는 연산(예: INT8 IR의 FakeQuantize)이 있으면 생성자에서 std::runtime_error를 던진다.
+// 그래프가 DEEP_CONVOLUTIONAL_NETWORK_SHALLOW 구조와 일치하면 shape 특화 커널(ShallowNetwork)로 실행한다.
+class NativeInferenceEngine : public InferenceBackend {
+public:
+    // shallowKernels = false: 구조가 일치해도 일반 연산으로 실행 (비교/검증용, 백엔드 이름 "native-generic")
+    NativeInferenceEngine(const std::string& modelPath, const InferenceOptions& options = InferenceOptions(), bool shallowKernels = true);
+    ~NativeInferenceEngine() override;
+
+    std::string name() const override;
+
+    // 입력: Sensor가 보낸 좌/우 평면 프레임 (kStereoFrameSize 바이트) x options().batch
+    // 배치의 프레임은 순서대로 하나씩 추론한다.
+    void setInputData(const std::vector<uint8_t>& inputData) override;
+    std::vector<float> runInference() override;
+    void runInferenceInto(std::vector<float>& output) override;
+
+    const InferenceOptions& options() const override;
+    double loadTimeMs() const override;
+
+    // 비동기 모드: 특화 커널을 쓸 때만 numRequests개의 워커 스레드가 요청을 나눠 처리한다.
+    // 일반 연산 경로는 중간 텐서를 공유하므로 동기 실행으로 남는다.
+    void enableAsync(size_t numRequests) override;
+    bool isAsync() const override;
+    uint64_t submitAsync(const std::vector<uint8_t>& inputData, CompletionCallback callback) override;
+    size_t inFlight() const override;
+    void waitAll() override;
+
+    // 프로파일링 모드: 특화 커널은 입력 전처리와 네트워크 전체(단일 융합 커널) 두 단계, 일반 경로는 IR 노드별 실행 시간
+    std::vector<LayerTiming> layerProfile() const override;
+
+    // 특화 커널로 실행 중인지 여부
+    bool usesShallowKernels() const;
+
+private:
+    // 연산 결과 텐서 (정수 상수는 shape 계산용으로 ints에 보관)
+    struct Tensor {
+        std::vector<size_t> shape;
+        std::vector<float> data;
+        std::vector<int64_t> ints;
+        bool integer = false;
+    };
+
+    struct Node {
+        int id = -1;
+        std::string name;
+        std::string type;
+        std::map<std::string, std::string> attrs; // <data> 속성
+        std::vector<std::vector<size_t>> inputShapes; // IR에 기록된 입력 포트 shape (포트 순서)
+        std::vector<size_t> outputShape;             // IR에 기록된 출력 shape
+        std::vector<size_t> inputs;                  // 입력 노드 인덱스 (포트 순서)
+        bool constant = false;                       // 입력에 의존하지 않아 로드 시 미리 계산된 노드
+    };
+
+    std::vector<Node> nodes;     // 실행 순서(위상 정렬)로 정렬된 노드
+    std::vector<Tensor> values;  // nodes[i]의 출력
+    std::vector<size_t> program; // 매 프레임 실행할 (상수가 아닌) 노드 인덱스
+    size_t parameterIndex = 0;
+    size_t resultIndex = 0;
+
+    InferenceOptions opts;
+    double loadMs = 0.0;
+
+    bool allowShallow = true;
+    std::unique_ptr<calc::aa::ShallowNetwork> shallow; // 구조가 일치할 때만 생성
+    calc::aa::ShallowNetwork::Workspace workspace;     // 동기 추론용
+    std::vector<float> inputBuffer;                    // setInputData로 받은 batch개의 프레임 (float, 인터리브)
+
+    std::unique_ptr<calc::aa::LayerProfiler> profiler; // opts.profiling일 때만 생성
+    double syncFillUs = 0.0;                           // 프로파일링 모드의 마지막 setInputData 전처리 시간
+    std::vector<double> nodeUs;                        // 일반 경로 프로파일링용 노드별 누적 시간 (동기 추론 전용)
+
+    struct AsyncJob {
+        std::vector<uint8_t> frames;
+        CompletionCallback callback;
+        uint64_t sequence = 0;
+        std::chrono::steady_clock::time_point submitTime;
+    };
+    std::vector<std::thread> asyncWorkers;
+    std::deque<AsyncJob> asyncQueue;  // asyncMutex로 보호
+    std::mutex asyncMutex;
+    std::condition_variable asyncCv;
+    std::atomic<size_t> inFlightCount{0};
+    bool asyncStopping = false;
+    uint64_t nextSequence = 0;
+
+    void loadModel(const std::string& modelPath);
+    void recordShallowProfile(double fillUs, double forwardUs) const;
+    void parseXml(const std::string& xml);
+    void sortNodes();
+    void loadConstants(const std::string& weightsPath);
+    bool bindShallowNetwork();
+    void evaluate(size_t index);
+    void checkFrames(const std::vector<uint8_t>& inputData) const;
+    void interleaveFrames(const uint8_t* frames, float* input) const;
+    void inferShallow(const float* input, std::vector<float>& output, calc::aa::ShallowNetwork::Workspace& ws) const;
+    void stopAsync();
+    void asyncWorkerLoop();
+};
+
+#endif // NATIVE_INFERENCE_ENGINE_H
@@ -0,0 +1,109 @@
+#ifndef REMOTE_INFERENCE_CLIENT_H
+#define REMOTE_INFERENCE_CLIENT_H
+
+#include "calc/aa/inference_backend.h"
+
+#include <array>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// 원격 추론 클라이언트 (Inference.py와 같은 TCP 프로토콜)
+//   요청: (120, 160, 2) 인터리브 uint8 프레임 38400바이트, 응답: float 2개 (steering, throttle, 8바이트)
+// 서버는 연결 하나에서 요청을 순서대로 처리하므로, 요청을 여러 개 먼저 보내 두고(파이프라이닝) 응답을 보낸 순서대로 짝짓는다.
+// 요청마다 기한(options.remoteDeadlineMs)이 있고, 기한 안에 응답이 없거나 연결이 없으면 로컬 백엔드(options.remoteFallback)로 추론한다.
+// 기한을 넘긴 요청의 늦은 응답은 순서를 맞추기 위해 읽기만 하고 버린다. 서버가 오래 응답하지 않아도 연결을 끊지 않고 늦은 응답을 기다린다.
+// 전송도 기한까지만 기다리고, 보내지 못한 요청은 로컬에서 추론한다. 프레임 일부만 나간 경우와 전송 오류에만 연결을 다시 맺는다
+// (Inference.py는 클라이언트가 끊으면 다음 연결을 다시 받는다).
+class RemoteInferenceClient : public InferenceBackend {
+public:
+    // 대체 추론용 로컬 백엔드를 먼저 로드하고, 연결은 수신 스레드가 백그라운드에서 맺는다 (서버가 없어도 생성은 성공).
+    RemoteInferenceClient(const std::string& modelPath, const std::string& deviceName, const InferenceOptions& options);
+    ~RemoteInferenceClient() override;
+
+    std::string name() const override;
+
+    // 동기 추론: 요청 하나를 보내고 응답(또는 대체 추론 결과)을 기다린다.
+    void setInputData(const std::vector<uint8_t>& inputData) override;
+    std::vector<float> runInference() override;
+
+    const InferenceOptions& options() const override;
+    bool loadedFromCache() const override;
+    double loadTimeMs() const override;
+    std::string cacheWarning() const override;
+
+    // numRequests: 동시에 보내 둘 수 있는 최대 요청 수 (기한이 지나 응답을 기다리는 요청 포함)
+    void enableAsync(size_t numRequests) override;
+    bool isAsync() const override;
+    uint64_t submitAsync(const std::vector<uint8_t>& inputData, CompletionCallback callback) override;
+    size_t inFlight() const override;
+    void waitAll() override;
+
+    std::string latencyReport() const override;
+
+    // 왕복 시간 히스토그램 구간 상한 (ms). 마지막 구간은 그 이상 전부
+    static constexpr std::array<double, 9> kLatencyBucketsMs = {0.5, 1, 2, 4, 8, 16, 32, 64, 128};
+
+private:
+    struct Request {
+        uint64_t sequence = 0;
+        std::vector<uint8_t> frame; // 대체 추론용 원본 (좌/우 평면)
+        CompletionCallback callback;
+        std::chrono::steady_clock::time_point submitTime;
+        std::chrono::steady_clock::time_point deadline;
+        bool expired = false;       // 대체 추론으로 이미 완료됨, 늦은 응답은 버린다
+    };
+
+    InferenceOptions opts;
+    std::string host;
+    std::string port;
+    std::unique_ptr<InferenceBackend> fallback;
+    std::mutex fallbackMutex;       // 대체 추론은 수신 스레드와 제출 스레드에서 모두 호출된다
+
+    std::vector<uint8_t> syncInput;
+
+    mutable std::mutex mutex;       // 아래 상태 보호
+    std::condition_variable cv;
+    std::deque<Request> pending;    // 보낸 순서 (= 응답 순서)
+    int socketFd = -1;
+    bool stopping = false;
+    bool async = false;
+    size_t maxInFlight = 1;
+    size_t outstanding = 0;         // 콜백이 아직 호출되지 않은 요청 수
+    uint64_t nextSequence = 0;
+
+    std::mutex sendMutex;           // 소켓 쓰기와 닫기를 직렬화
+    std::vector<uint8_t> sendBuffer;
+
+    // 통계 (mutex로 보호)
+    std::array<uint64_t, kLatencyBucketsMs.size() + 1> latencyHistogram{};
+    double latencySumMs = 0.0;
+    double latencyMaxMs = 0.0;
+    uint64_t remoteResults = 0;     // 기한 안에 온 원격 결과
+    uint64_t lateReplies = 0;       // 기한이 지난 뒤 도착해 버린 응답
+    uint64_t deadlineFallbacks = 0; // 기한 초과로 대체 추론한 요청
+    uint64_t offlineFallbacks = 0;  // 연결이 없거나 끊겨 대체 추론한 요청
+    uint64_t sendTimeouts = 0;      // 기한 안에 프레임을 다 보내지 못한 요청
+    uint64_t stalls = 0;            // 늦은 응답이 오래 오지 않은 구간 수
+    bool stalled = false;
+    uint64_t reconnects = 0;
+
+    std::thread receiver;
+    int wakeFd = -1;                // 새 요청/종료 시 수신 스레드의 poll을 깨우는 eventfd
+
+    void receiverLoop();
+    bool connectToServer();
+    void closeConnection(std::unique_lock<std::mutex>& lock);
+    void wakeReceiver();
+    void recordLatency(double ms);
+    void complete(Request& request, std::vector<float> output, bool remote);
+    std::vector<float> runFallback(const std::vector<uint8_t>& frame);
+};
+
+#endif // REMOTE_INFERENCE_CLIENT_H
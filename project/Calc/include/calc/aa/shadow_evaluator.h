@@ -0,0 +1,148 @@
+#ifndef SHADOW_EVALUATOR_H
+#define SHADOW_EVALUATOR_H
+
+#include "calc/aa/action_decoder.h"
+#include "calc/aa/inference_backend.h"
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace calc
+{
+namespace aa
+{
+
+// 후보 모델(섀도 모델) 실차 평가기
+//
+// 주 모델과 같은 프레임을 별도 스레드에서 낮은 우선순위로 추론하고, 주 모델이 낸 조향/스로틀과의 차이와 추론 시간을 집계한다.
+// 결과는 어디에도 출력하지 않는다. 스레드는 지정한 코어에 고정되고 nice 값을 높인 뒤 모델을 로드하므로,
+// 백엔드가 만드는 추론 스레드도 같은 코어와 우선순위를 물려받는다.
+// 주 경로는 Offer에서 잠금을 시도만 하므로 섀도 스레드 때문에 막히지 않는다. 주 모델의 기한이 위험하면 Calc가 Suspend를 호출하고,
+// 중단이 maxSuspensions번 쌓이면 섀도 모델을 내려놓는다(Dropped).
+class ShadowEvaluator
+{
+public:
+    using Clock = std::chrono::steady_clock;
+    using Loader = std::function<std::unique_ptr<InferenceBackend>()>;
+
+    struct Settings
+    {
+        std::vector<int> cpus;     // 고정할 CPU 번호 (비어 있으면 고정하지 않음)
+        int nice = 10;             // 섀도 스레드 nice 값 (높을수록 낮은 우선순위)
+        uint32_t maxSuspensions = 3;
+    };
+
+    enum class State
+    {
+        Off,
+        Loading,
+        Running,
+        Dropped, // 주 모델 기한을 반복해서 위협해 내려놓음
+        Failed   // 로드 또는 추론 실패
+    };
+
+    struct Stats
+    {
+        State state = State::Off;
+        std::string error;
+        uint64_t offered = 0;      // 섀도 스레드에 넘긴 프레임
+        uint64_t busyDrops = 0;    // 섀도 스레드가 바빠 건너뛴 프레임
+        uint64_t inferred = 0;
+        uint64_t compared = 0;     // 주 모델 결과와 짝지어 비교한 프레임
+        uint64_t unpaired = 0;     // 주 모델 결과를 끝내 받지 못한 프레임 (비동기에서 버려진 결과 등)
+        uint64_t suspensions = 0;
+        double meanLatencyMs = 0.0;
+        double maxLatencyMs = 0.0;
+        double meanSteeringDiff = 0.0; // |섀도 - 주| 평균/최대
+        double maxSteeringDiff = 0.0;
+        double meanThrottleDiff = 0.0;
+        double maxThrottleDiff = 0.0;
+    };
+
+    ShadowEvaluator();
+    ~ShadowEvaluator();
+
+    ShadowEvaluator(const ShadowEvaluator&) = delete;
+    ShadowEvaluator& operator=(const ShadowEvaluator&) = delete;
+
+    // 섀도 스레드를 시작한다. loader는 섀도 스레드에서(코어 고정, 우선순위 조정 후) 호출된다.
+    void Start(Loader loader, ActionDecoder decoder, const Settings& settings);
+
+    // 섀도 스레드를 멈추고 기다린다 (종료 시).
+    void Stop();
+
+    // 추론 스레드: 프레임을 넘긴다. 섀도 스레드가 넘겨받는 중이면 기다리지 않고 버린다.
+    void Offer(const std::vector<uint8_t>& frame, int64_t sequence);
+
+    // 주 모델이 frame sequence에 대해 출력한 명령 (비교 기준). 섀도 결과보다 먼저 와도 늦게 와도 짝지어진다.
+    void RecordPrimary(int64_t sequence, const ControlCommand& command);
+
+    // 주 모델 기한이 위험할 때: until까지 프레임을 받지 않는다. 중단이 한도에 도달하면 섀도 모델을 내려놓고 true를 반환한다.
+    bool Suspend(Clock::time_point until);
+
+    // 프레임을 받을 수 있는 상태 (실행 중이고 중단 시간이 아님)
+    bool Accepting(Clock::time_point now) const;
+
+    Stats GetStats() const;
+
+    static const char* StateName(State state);
+
+private:
+    // 짝을 기다리는 명령 기록 (sequence % kPairHistory 위치)
+    static constexpr size_t kPairHistory = 16;
+
+    struct PairEntry
+    {
+        int64_t sequence = -1;
+        ControlCommand command;
+    };
+
+    void Run(Loader loader);
+    void ApplyPlacement();
+    void SetState(State state, const std::string& error = std::string());
+    void RecordShadow(int64_t sequence, const ControlCommand& command, double latencyMs);
+    void Compare(const ControlCommand& shadow, const ControlCommand& primary);
+
+    std::unique_ptr<ActionDecoder> m_decoder; // 섀도 모델의 출력 변환기 (Start에서 설정)
+    Settings m_settings;
+    std::thread m_thread;
+    std::atomic<State> m_state;
+    std::atomic<int64_t> m_suspendedUntil; // Clock 기준 ns
+    std::atomic<uint32_t> m_suspensions;
+
+    // 프레임 전달 칸 (Offer -> 섀도 스레드). 두 버퍼를 교환해 할당 없이 넘긴다.
+    std::mutex m_slotMutex;
+    std::condition_variable m_slotCv;
+    std::vector<uint8_t> m_pending;
+    int64_t m_pendingSequence;
+    bool m_hasPending;
+    bool m_stopping;
+
+    // 주 모델과 섀도 모델 중 먼저 끝난 쪽의 명령을 남겨 두고, 나중에 끝난 쪽이 비교한다.
+    std::mutex m_pairMutex;
+    std::array<PairEntry, kPairHistory> m_primary;
+    std::array<PairEntry, kPairHistory> m_shadow;
+
+    mutable std::mutex m_statsMutex;
+    Stats m_stats;
+    double m_latencySumMs;
+    double m_steeringDiffSum;
+    double m_throttleDiffSum;
+};
+
+// "2,3" 형식의 CPU 목록 (잘못된 항목은 건너뛴다)
+std::vector<int> ParseCpuList(const std::string& text);
+
+} /// namespace aa
+} /// namespace calc
+
+#endif // SHADOW_EVALUATOR_H
@@ -0,0 +1,183 @@
+#ifndef SHALLOW_KERNELS_H
+#define SHALLOW_KERNELS_H
+
+#include <algorithm>
+#include <cstddef>
+
+// DEEP_CONVOLUTIONAL_NETWORK_SHALLOW 전용 커널
+// 모든 텐서 크기가 템플릿 인자로 고정되므로 컴파일러가 채널/커널 루프를 펼치고 벡터화할 수 있다.
+// 활성값은 모두 HWC(채널이 가장 안쪽) 배치를 사용한다. 입력(120x160x2)이 이미 HWC이고,
+// 마지막 컨볼루션 출력의 HWC 평탄화가 IR의 Transpose(0,2,3,1) + Reshape 결과와 같으므로 Transpose가 필요 없다.
+//
+// 커널은 CALC_KERNEL_INLINE으로 호출 함수에 인라인되어, 호출 함수의 target 속성(avx2 등)으로 컴파일된다.
+#define CALC_KERNEL_INLINE inline __attribute__((always_inline))
+
+namespace calc
+{
+namespace aa
+{
+
+// 직접 컨볼루션(im2col 없음) + bias + ReLU
+// 출력 채널을 kChannelBlock개씩, 출력 픽셀을 가로로 kPixelTile개씩 묶어 누산기를 레지스터에 유지한다.
+// 한 채널 블록의 가중치(K*K*InC*kChannelBlock)가 L1/L2에 머무는 동안 모든 출력 픽셀을 계산한다.
+template <size_t InC, size_t InH, size_t InW, size_t OutC, size_t K, size_t S>
+struct ConvReluStage
+{
+    static constexpr size_t kChannelBlock = 16;
+    static constexpr size_t kPixelTile = 4;
+    static_assert(OutC % kChannelBlock == 0, "output channels must be a multiple of the channel block");
+    static_assert(InH >= K && InW >= K, "kernel larger than input");
+
+    static constexpr size_t kOutChannels = OutC;
+    static constexpr size_t kOutH = (InH - K) / S + 1;
+    static constexpr size_t kOutW = (InW - K) / S + 1;
+    static constexpr size_t kInputSize = InH * InW * InC;
+    static constexpr size_t kOutputSize = kOutH * kOutW * OutC;
+    static constexpr size_t kWeightSize = OutC * InC * K * K;
+
+    // IR의 OIHW 가중치를 [채널 블록][ky][kx][ic][kChannelBlock] 순서로 재배치한다.
+    static void PackWeights(const float* oihw, float* packed)
+    {
+        for (size_t block = 0; block < OutC / kChannelBlock; ++block)
+        {
+            for (size_t ky = 0; ky < K; ++ky)
+            {
+                for (size_t kx = 0; kx < K; ++kx)
+                {
+                    for (size_t ic = 0; ic < InC; ++ic)
+                    {
+                        for (size_t j = 0; j < kChannelBlock; ++j)
+                        {
+                            size_t oc = block * kChannelBlock + j;
+                            *packed++ = oihw[((oc * InC + ic) * K + ky) * K + kx];
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    // in: InH x InW x InC, packed: PackWeights 결과, bias: OutC, out: kOutH x kOutW x OutC
+    static CALC_KERNEL_INLINE void Run(const float* in, const float* packed, const float* bias, float* out)
+    {
+        constexpr size_t kBlockWeights = K * K * InC * kChannelBlock;
+        for (size_t block = 0; block < OutC / kChannelBlock; ++block)
+        {
+            const float* weights = packed + block * kBlockWeights;
+            const float* blockBias = bias + block * kChannelBlock;
+            float* blockOut = out + block * kChannelBlock;
+            for (size_t oy = 0; oy < kOutH; ++oy)
+            {
+                size_t ox = 0;
+                for (; ox + kPixelTile <= kOutW; ox += kPixelTile)
+                {
+                    Tile<kPixelTile>(in, weights, blockBias, blockOut, oy, ox);
+                }
+                for (; ox < kOutW; ++ox)
+                {
+                    Tile<1>(in, weights, blockBias, blockOut, oy, ox);
+                }
+            }
+        }
+    }
+
+private:
+    template <size_t P>
+    static CALC_KERNEL_INLINE void Tile(const float* in, const float* weights, const float* bias, float* out, size_t oy, size_t ox)
+    {
+        float acc[P][kChannelBlock];
+        for (size_t p = 0; p < P; ++p)
+        {
+            for (size_t j = 0; j < kChannelBlock; ++j)
+            {
+                acc[p][j] = 0.0f;
+            }
+        }
+
+        for (size_t ky = 0; ky < K; ++ky)
+        {
+            const float* inRow = in + ((oy * S + ky) * InW + ox * S) * InC;
+            for (size_t kx = 0; kx < K; ++kx)
+            {
+                for (size_t ic = 0; ic < InC; ++ic)
+                {
+                    const float* w = weights + ((ky * K + kx) * InC + ic) * kChannelBlock;
+                    for (size_t p = 0; p < P; ++p)
+                    {
+                        const float x = inRow[(p * S + kx) * InC + ic];
+                        for (size_t j = 0; j < kChannelBlock; ++j)
+                        {
+                            acc[p][j] += x * w[j];
+                        }
+                    }
+                }
+            }
+        }
+
+        for (size_t p = 0; p < P; ++p)
+        {
+            float* o = out + (oy * kOutW + ox + p) * OutC;
+            for (size_t j = 0; j < kChannelBlock; ++j)
+            {
+                o[j] = std::max(0.0f, acc[p][j] + bias[j]);
+            }
+        }
+    }
+};
+
+// 완전 연결층: y = x * W^T + bias (W는 IR의 transpose_b MatMul 가중치와 같은 [Out][In] 배치)
+// 행 kRows개를 함께 계산해 x 로드를 공유하고, 내적은 kLanes개의 독립 누산기로 나눠 벡터화한다.
+template <size_t In, size_t Out, bool Relu>
+struct DenseStage
+{
+    static constexpr size_t kLanes = 16;
+    static constexpr size_t kRows = (Out % 4 == 0) ? 4 : 1;
+    static_assert(In % kLanes == 0, "input size must be a multiple of the lane count");
+
+    static constexpr size_t kInputSize = In;
+    static constexpr size_t kOutputSize = Out;
+    static constexpr size_t kWeightSize = In * Out;
+
+    static CALC_KERNEL_INLINE void Run(const float* x, const float* weights, const float* bias, float* y)
+    {
+        for (size_t row = 0; row < Out; row += kRows)
+        {
+            float acc[kRows][kLanes];
+            for (size_t r = 0; r < kRows; ++r)
+            {
+                for (size_t j = 0; j < kLanes; ++j)
+                {
+                    acc[r][j] = 0.0f;
+                }
+            }
+
+            for (size_t k = 0; k < In; k += kLanes)
+            {
+                for (size_t r = 0; r < kRows; ++r)
+                {
+                    const float* w = weights + (row + r) * In + k;
+                    for (size_t j = 0; j < kLanes; ++j)
+                    {
+                        acc[r][j] += x[k + j] * w[j];
+                    }
+                }
+            }
+
+            for (size_t r = 0; r < kRows; ++r)
+            {
+                float sum = 0.0f;
+                for (size_t j = 0; j < kLanes; ++j)
+                {
+                    sum += acc[r][j];
+                }
+                sum += bias[row + r];
+                y[row + r] = Relu ? std::max(0.0f, sum) : sum;
+            }
+        }
+    }
+};
+
+} /// namespace aa
+} /// namespace calc
+
+#endif // SHALLOW_KERNELS_H
@@ -0,0 +1,82 @@
+#ifndef SHALLOW_NETWORK_H
+#define SHALLOW_NETWORK_H
+
+#include "calc/aa/shallow_kernels.h"
+
+#include <cstddef>
+#include <vector>
+
+namespace calc
+{
+namespace aa
+{
+
+// model_metadata.json의 DEEP_CONVOLUTIONAL_NETWORK_SHALLOW (입력 120x160x2 그레이스케일 스테레오)
+//   conv 8x8/4 (32) -> conv 4x4/2 (64) -> conv 3x3/1 (64) -> dense 512 -> x * scale + x -> dense 2
+// NativeInferenceEngine이 IR 그래프가 이 구조와 일치할 때 일반 연산 대신 사용한다.
+class ShallowNetwork
+{
+public:
+    using Conv1 = ConvReluStage<2, 120, 160, 32, 8, 4>;
+    using Conv2 = ConvReluStage<32, Conv1::kOutH, Conv1::kOutW, 64, 4, 2>;
+    using Conv3 = ConvReluStage<64, Conv2::kOutH, Conv2::kOutW, 64, 3, 1>;
+    using Dense = DenseStage<Conv3::kOutputSize, 512, true>;
+    using Head = DenseStage<Dense::kOutputSize, 2, false>;
+
+    static constexpr size_t kInputSize = Conv1::kInputSize;
+    static constexpr size_t kOutputSize = Head::kOutputSize;
+
+    // IR 배치 그대로의 가중치 (컨볼루션: OIHW, 완전 연결층: [Out][In])
+    struct Weights
+    {
+        const float* conv1;
+        const float* conv1Bias;
+        const float* conv2;
+        const float* conv2Bias;
+        const float* conv3;
+        const float* conv3Bias;
+        const float* dense;
+        const float* denseBias;
+        float residualScale; // dense 출력 x에 대해 x * residualScale + x
+        const float* head;
+        const float* headBias;
+    };
+
+    // 중간 활성값 버퍼. 스레드마다 하나씩 사용하면 같은 ShallowNetwork로 여러 프레임을 동시에 추론할 수 있다.
+    struct Workspace
+    {
+        Workspace();
+
+        std::vector<float> act1;
+        std::vector<float> act2;
+        std::vector<float> act3;
+        std::vector<float> hidden;
+    };
+
+    explicit ShallowNetwork(const Weights& weights);
+
+    // input: 120x160x2 (HWC, Parameter 입력과 같은 배치), output: kOutputSize
+    // 가중치는 읽기만 하므로 서로 다른 workspace를 쓰는 호출끼리는 동시에 실행해도 된다.
+    void Forward(const float* input, float* output, Workspace& workspace) const;
+
+    // Forward가 사용하는 구현 이름 ("avx2", "generic")
+    static const char* Isa();
+
+private:
+    std::vector<float> m_conv1;
+    std::vector<float> m_conv1Bias;
+    std::vector<float> m_conv2;
+    std::vector<float> m_conv2Bias;
+    std::vector<float> m_conv3;
+    std::vector<float> m_conv3Bias;
+    std::vector<float> m_dense;
+    std::vector<float> m_denseBias;
+    float m_residualScale;
+    std::vector<float> m_head;
+    std::vector<float> m_headBias;
+};
+
+} /// namespace aa
+} /// namespace calc
+
+#endif // SHALLOW_NETWORK_H
@@ -0,0 +1,37 @@
+#ifndef STEREO_PREPROCESS_H
+#define STEREO_PREPROCESS_H
+
+#include <cstddef>
+#include <cstdint>
+
+namespace calc
+{
+namespace aa
+{
+
+// 스테레오 카메라 입력 크기 (Sensor가 보내는 프레임: 좌측 평면 뒤에 우측 평면)
+constexpr size_t kStereoWidth = 160;
+constexpr size_t kStereoHeight = 120;
+constexpr size_t kStereoPlaneSize = kStereoWidth * kStereoHeight;
+constexpr size_t kStereoFrameSize = kStereoPlaneSize * 2;
+
+// 좌/우 평면(planar) uint8 입력을 네트워크 입력 배치(120x160x2, 채널 0 = 좌측)로 인터리브하면서
+// float로 변환한다. 정규화는 dst = src * scale + offset 이며, 기본값은 변환 없음.
+// 실행 CPU가 지원하는 가장 넓은 SIMD 구현(AVX2 > SSE2 > 스칼라)을 처음 호출 시 한 번 선택한다.
+void InterleaveStereoToFloat(const uint8_t* left, const uint8_t* right, float* dst, size_t pixels,
+                             float scale = 1.0f, float offset = 0.0f);
+
+// 검증 및 벤치마크 기준용 스칼라 구현
+void InterleaveStereoToFloatReference(const uint8_t* left, const uint8_t* right, float* dst, size_t pixels,
+                                      float scale = 1.0f, float offset = 0.0f);
+
+// U8 입력 정밀도용: 변환 없이 좌/우 평면을 (120, 160, 2) uint8로 인터리브만 한다.
+void InterleaveStereoU8(const uint8_t* left, const uint8_t* right, uint8_t* dst, size_t pixels);
+
+// InterleaveStereoToFloat가 사용하는 구현 이름 ("avx2", "sse2", "scalar")
+const char* StereoPreprocessIsa();
+
+} /// namespace aa
+} /// namespace calc
+
+#endif // STEREO_PREPROCESS_H
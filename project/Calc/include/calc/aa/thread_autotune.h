@@ -0,0 +1,72 @@
+#ifndef THREAD_AUTOTUNE_H
+#define THREAD_AUTOTUNE_H
+
+#include "calc/aa/inference_backend.h"
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace calc
+{
+namespace aa
+{
+
+// 추론 스레드 구성 (InferenceOptions의 threads/streams/bindThreads). 0 또는 빈 문자열은 플러그인 기본값
+struct ThreadingConfig
+{
+    size_t threads = 0;
+    size_t streams = 0;
+    std::string bind; // CPU 플러그인 KEY_CPU_BIND_THREAD ("YES", "NO", "NUMA")
+
+    // "threads=2 streams=1 bind=NO" 형식 (캐시 파일과 로그 공용)
+    std::string ToString() const;
+    static bool Parse(const std::string& text, ThreadingConfig& config);
+
+    void ApplyTo(InferenceOptions& options) const;
+};
+
+// 시작 시 자동 조정: 후보 구성마다 실제 모델을 로드해 합성 프레임으로 추론 시간을 재고 가장 빠른 구성을 고른다.
+// 캐시 디렉토리에 머신(CPU 모델, 논리 코어 수) + 모델 파일 + 조정 조건별로 결과를 저장해 다음 시작부터는 측정하지 않는다.
+struct ThreadTuneRequest
+{
+    std::string backend;
+    std::string modelPath;
+    std::string deviceName;
+    InferenceOptions options;  // 정밀도, 캐시 등 (threads/streams/bindThreads는 후보 값으로 덮어쓴다)
+    size_t cpuBudget = 1;      // 추론에 쓸 수 있는 최대 코어 수 (Sensor 캡처 스레드, 포트 워커 몫을 뺀 값)
+    size_t asyncRequests = 0;  // 2 이상이면 그 수의 요청으로 파이프라인 처리량을 비교하고 스트림 수도 후보에 넣는다
+    int iterations = 30;       // 후보마다 측정할 프레임 수 (예열 제외)
+};
+
+struct ThreadTuneResult
+{
+    ThreadingConfig config;
+    double scoreMs = 0.0;  // 동기: 프레임 지연 p90, 비동기: 프레임당 평균 처리 시간
+    double loadMs = 0.0;
+    bool ok = false;
+    std::string error;
+};
+
+// 스레드 수 1, 2, 4, ...와 cpuBudget x 코어 고정(YES/NO) x (비동기면) 스트림 1, 2
+std::vector<ThreadingConfig> ThreadTuneCandidates(size_t cpuBudget, size_t asyncRequests);
+
+// 모든 후보를 측정한다. 로드나 추론에 실패한 후보는 ok = false
+std::vector<ThreadTuneResult> RunThreadTune(const ThreadTuneRequest& request);
+
+// 가장 빠른 후보의 인덱스. 5% 이내 차이면 스레드를 적게 쓰는 쪽을 고른다 (성공한 후보가 없으면 results.size()).
+size_t PickThreadTune(const std::vector<ThreadTuneResult>& results);
+
+// 캐시 파일 경로: <cacheDir>/threading-<머신, 모델, 조건 해시>.txt
+std::string ThreadTuneCachePath(const std::string& cacheDir, const ThreadTuneRequest& request);
+
+bool LoadThreadTune(const std::string& path, ThreadingConfig& config);
+void SaveThreadTune(const std::string& path, const ThreadTuneResult& result);
+
+// 머신 식별 문자열 (/proc/cpuinfo의 model name과 논리 코어 수)
+std::string MachineId();
+
+} /// namespace aa
+} /// namespace calc
+
+#endif // THREAD_AUTOTUNE_H
@@ -0,0 +1,74 @@
+#include "calc/aa/action_decoder.h"
+#include "calc/aa/control_mapping.h"
+
+#include <algorithm>
+#include <cmath>
+#include <sstream>
+
+namespace calc
+{
+namespace aa
+{
+
+ActionDecoder::ActionDecoder(const ModelMetadata& metadata)
+    : m_outputSize(metadata.OutputSize())
+{
+    std::ostringstream description;
+    if (metadata.actionSpaceType == ActionSpaceType::Continuous)
+    {
+        m_decode = DecodeContinuous;
+        description << "continuous steering [" << metadata.steeringAngle.low << ", " << metadata.steeringAngle.high
+                    << "] speed [" << metadata.speed.low << ", " << metadata.speed.high << "]";
+    }
+    else
+    {
+        // 가장 큰 조향각/속도의 행동이 continuous 출력 ±1과 같은 값을 내도록 맞춘다.
+        float maxSteering = 0.0f;
+        float maxSpeed = 0.0f;
+        for (const auto& action : metadata.actions)
+        {
+            maxSteering = std::max(maxSteering, std::fabs(action.steeringAngle));
+            maxSpeed = std::max(maxSpeed, std::fabs(action.speed));
+        }
+
+        m_table.reserve(metadata.actions.size());
+        for (const auto& action : metadata.actions)
+        {
+            ControlCommand command;
+            command.steering = (maxSteering > 0.0f) ? MapSteering(action.steeringAngle / maxSteering) : 0.0f;
+            command.throttle = (maxSpeed > 0.0f) ? MapThrottle(action.speed / maxSpeed) : 0.0f;
+            m_table.push_back(command);
+        }
+
+        m_decode = DecodeDiscrete;
+        description << "discrete " << m_table.size() << " actions";
+    }
+    m_description = description.str();
+}
+
+size_t ActionDecoder::OutputSize() const
+{
+    return m_outputSize;
+}
+
+const std::string& ActionDecoder::Description() const
+{
+    return m_description;
+}
+
+ControlCommand ActionDecoder::DecodeContinuous(const ActionDecoder&, const float* output)
+{
+    ControlCommand command;
+    command.steering = MapSteering(output[0]);
+    command.throttle = MapThrottle(output[1]);
+    return command;
+}
+
+ControlCommand ActionDecoder::DecodeDiscrete(const ActionDecoder& decoder, const float* output)
+{
+    const size_t best = std::max_element(output, output + decoder.m_outputSize) - output;
+    return decoder.m_table[best];
+}
+
+} /// namespace aa
+} /// namespace calc
@@ -15,25 +15,123 @@
 /// INCLUSION HEADER FILES
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////
 #include "calc/aa/calc.h"
-#include "calc/aa/inference_engine_wrapper.h"
+#include "calc/aa/layer_profiler.h"
+#include "calc/aa/stereo_preprocess.h"
 #include <iostream>
 #include <array>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+#include <pthread.h>
+#include <sched.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+#include <cerrno>
 
 namespace calc
 {
 namespace aa
 {
 
+namespace
+{
+// 디바이스 설정 (OpenVINO 백엔드에서만 사용)
+const std::string kDeviceName = "CPU";
+
+// 시작 시 수행할 더미 추론 횟수
+constexpr int kWarmupIterations = 3;
+
+// 백엔드 지연 통계(원격 추론 왕복 시간 등)를 로그로 남기는 프레임 간격
+constexpr int64_t kLatencyReportFrames = 300;
+
+// 주 모델의 기한 초과를 세는 최근 프레임 수 (CALC_DEADLINE_MISS_LIMIT의 기준)
+constexpr size_t kDeadlineWindowFrames = 20;
+
+// 섀도 모델은 주 모델의 프레임 지연이 기한의 80%를 넘으면 멈춘다 (기한 감시가 꺼져 있으면 ControlData 주기 100 ms 기준).
+constexpr int64_t kShadowDefaultDeadlineMs = 100;
+constexpr int kShadowGuardNumerator = 4;
+constexpr int kShadowGuardDenominator = 5;
+
+// 모델 파일(.xml, .bin, model_metadata.json) 변경 감지용 상태
+constexpr int kModelFiles = 3;
+
+struct ModelStamp
+{
+    bool exists[kModelFiles] = {false, false, false};
+    std::filesystem::file_time_type writeTime[kModelFiles];
+    std::uintmax_t size[kModelFiles] = {0, 0, 0};
+
+    bool operator==(const ModelStamp &other) const
+    {
+        for (int i = 0; i < kModelFiles; ++i)
+        {
+            if (exists[i] != other.exists[i] || writeTime[i] != other.writeTime[i] || size[i] != other.size[i])
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+};
+
+ModelStamp ReadModelStamp(const std::string &modelPath, const std::string &metadataPath)
+{
+    std::filesystem::path paths[kModelFiles] = {modelPath, modelPath, metadataPath};
+    paths[1].replace_extension(".bin");
+
+    ModelStamp stamp;
+    for (int i = 0; i < kModelFiles; ++i)
+    {
+        std::error_code ec;
+        stamp.writeTime[i] = std::filesystem::last_write_time(paths[i], ec);
+        stamp.exists[i] = !ec;
+        if (stamp.exists[i])
+        {
+            stamp.size[i] = std::filesystem::file_size(paths[i], ec);
+        }
+    }
+    return stamp;
+}
+
+// 호출한 스레드를 cpus에 고정한다. 이후 이 스레드가 만드는 스레드(추론 엔진의 작업 스레드 등)도 같은 코어를 물려받는다.
+bool PinCurrentThread(const std::vector<int> &cpus)
+{
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    for (int cpu : cpus)
+    {
+        CPU_SET(cpu, &set);
+    }
+    return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+}
+}
+
 // 생성자: 클래스 멤버 초기화
 Calc::Calc()
     : m_logger(ara::log::CreateLogger("CALC", "SWC", ara::log::LogLevel::kVerbose))
-    , m_workers(3)
+    , m_workers(5)
     , m_running(false)
+    , m_frameTasks(0)
+    , m_lastPublishedSequence(-1)
+    , m_nextFrameSequence(0)
+    , m_modelGenerations(0)
+    , m_mailbox(kStereoFrameSize)
+    , m_staleFrames(0)
+    , m_droppedResults(0)
+    , m_profileRequested(false)
+    , m_stopFd(eventfd(0, EFD_CLOEXEC))
 {
 }
 
 Calc::~Calc()
 {
+    if (m_stopFd >= 0)
+    {
+        close(m_stopFd);
+    }
 }
 
 // Client -> Server 연결
@@ -43,12 +141,335 @@ bool Calc::Initialize()
 
     bool init{true};
 
+    m_config = CalcConfig::FromEnvironment();
+    if (m_stopFd < 0)
+    {
+        m_logger.LogError() << "Calc::Initialize - cannot create the stop eventfd";
+        return false;
+    }
+    m_frameInference.Configure(m_config.skipThreshold, static_cast<uint32_t>(m_config.skipMaxFrames));
+
     m_ControlData = std::make_shared<calc::aa::port::ControlData>();
     m_RawData = std::make_shared<calc::aa::port::RawData>();
 
+    // 모델 로드(ReadNetwork, LoadNetwork)는 추론보다 훨씬 비싸므로 시작 시 한 번만 수행하고 이후 프레임에서 재사용한다.
+    try
+    {
+        ReservePrimaryCpus();
+        ResolveThreading();
+        if (!m_primaryCpus.empty() && (m_threading.threads == 0 || m_threading.threads > m_primaryCpus.size()))
+        {
+            // 플러그인 기본값은 모든 코어만큼 스레드를 만들므로 섀도 코어를 뺀 수로 제한한다.
+            m_threading.threads = m_primaryCpus.size();
+            m_logger.LogInfo() << "Calc::Initialize - primary threading limited to " << m_threading.ToString();
+        }
+        auto model = LoadModel(m_config.modelPath, MetadataPath(), m_config.backend);
+        m_logger.LogInfo() << "Calc::Initialize - backend = " << model->engine->name()
+                           << ", preprocess kernel = " << StereoPreprocessIsa()
+                           << ", change detector = " << (m_frameInference.Detector().Enabled() ? ChangeGridIsa() : "off")
+                           << ", input precision = " << (m_config.inputPrecision == InputPrecision::U8 ? "U8" : "FP32");
+        std::atomic_store(&m_model, model);
+    }
+    catch (const std::exception &e)
+    {
+        m_logger.LogError() << "Calc::Initialize - failed to initialize inference engine (" << m_config.modelPath << ") : " << e.what();
+        init = false;
+    }
+
+    // 대체 모델은 없어도 동작에 지장이 없으므로, 로드에 실패하면 기한 초과 집계만 한다.
+    if (init && m_config.frameDeadlineMs > 0 && !m_config.fallbackModelPath.empty())
+    {
+        try
+        {
+            m_fallbackModel = LoadModel(m_config.fallbackModelPath, ModelMetadata::DefaultPath(m_config.fallbackModelPath),
+                                        m_config.fallbackBackend);
+        }
+        catch (const std::exception &e)
+        {
+            m_logger.LogError() << "Calc::Initialize - failed to load fallback model (" << m_config.fallbackModelPath << ") : " << e.what();
+        }
+    }
+
+    DeadlineMonitor::Settings deadline;
+    deadline.deadline = std::chrono::milliseconds(m_config.frameDeadlineMs);
+    deadline.window = kDeadlineWindowFrames;
+    deadline.missLimit = m_config.deadlineMissLimit;
+    deadline.hold = std::chrono::milliseconds(m_config.fallbackHoldMs);
+    deadline.fallbackAvailable = static_cast<bool>(m_fallbackModel);
+    m_deadlineMonitor.Configure(deadline);
+    if (m_deadlineMonitor.Enabled())
+    {
+        m_logger.LogInfo() << "Calc::Initialize - frame deadline = " << m_config.frameDeadlineMs << " ms, fallback = "
+                           << (m_fallbackModel ? m_fallbackModel->engine->name() + " " + m_config.fallbackModelPath : std::string("none"));
+    }
+
+    if (init)
+    {
+        StartShadow();
+    }
+
     return init;
 }
 
+// 모델 메타데이터로 출력 변환기를 만들고, 모델을 로드해 더미 입력으로 예열한다 (실패하면 예외). 시작 시, 모델 교체 시, 대체 모델 공용.
+std::shared_ptr<Calc::LoadedModel> Calc::LoadModel(const std::string &modelPath, const std::string &metadataPath, const std::string &backend)
+{
+    // 메타데이터가 잘못되었으면 비싼 네트워크 컴파일 전에 실패한다.
+    ActionDecoder decoder = LoadDecoder(metadataPath, "Calc::LoadModel");
+
+    auto loadStart = std::chrono::steady_clock::now();
+    InferenceOptions options;
+    options.precision = m_config.inputPrecision;
+    options.cacheDir = m_config.cacheDir;
+    m_threading.ApplyTo(options);
+    options.profiling = m_config.profiling;
+    options.profileWindow = m_config.profileWindow;
+    options.remoteAddress = m_config.remoteAddress;
+    options.remoteDeadlineMs = static_cast<double>(m_config.remoteDeadlineMs);
+    options.remoteFallback = m_config.remoteFallback;
+    std::shared_ptr<InferenceBackend> engine = CreateInferenceBackend(backend, modelPath, kDeviceName, options);
+    auto loadEnd = std::chrono::steady_clock::now();
+
+    // 첫 추론에서 발생하는 메모리 할당 및 커널 초기화 비용을 더미 입력으로 미리 소모한다.
+    std::vector<uint8_t> dummy(kStereoFrameSize, 0);
+    for (int i = 0; i < kWarmupIterations; ++i)
+    {
+        engine->setInputData(dummy);
+        std::vector<float> output = engine->runInference();
+        if (output.size() != decoder.OutputSize())
+        {
+            throw std::runtime_error("network has " + std::to_string(output.size()) + " outputs but the action space expects " +
+                                     std::to_string(decoder.OutputSize()));
+        }
+    }
+    auto warmupEnd = std::chrono::steady_clock::now();
+
+    // 비동기 모드: 여러 InferRequest로 프레임 N의 추론과 프레임 N+1의 전처리를 겹친다.
+    if (m_config.asyncRequests > 0)
+    {
+        size_t requests = std::max<size_t>(2, m_config.asyncRequests);
+        engine->enableAsync(requests);
+        if (engine->isAsync())
+        {
+            m_logger.LogInfo() << "Calc::LoadModel - async inference with " << requests << " requests";
+        }
+        else
+        {
+            m_logger.LogWarn() << "Calc::LoadModel - backend " << engine->name() << " does not support async inference, running synchronously";
+        }
+    }
+
+    const char *cacheState = m_config.cacheDir.empty() ? "disabled" : (engine->loadedFromCache() ? "warm" : "cold");
+    m_logger.LogInfo() << "Calc::LoadModel - model " << modelPath << " loaded in "
+                       << std::chrono::duration_cast<std::chrono::milliseconds>(loadEnd - loadStart).count() << " ms (cache "
+                       << cacheState << "), warm-up "
+                       << std::chrono::duration_cast<std::chrono::milliseconds>(warmupEnd - loadEnd).count() << " ms";
+    const std::string cacheWarning = engine->cacheWarning();
+    if (!cacheWarning.empty())
+    {
+        m_logger.LogWarn() << "Calc::LoadModel - model cache: " << cacheWarning;
+    }
+    return std::make_shared<LoadedModel>(LoadedModel{std::move(decoder), std::move(engine), ++m_modelGenerations});
+}
+
+// CPU 플러그인 스레드 구성: CALC_CPU_THREADING 지정값 > 캐시된 자동 조정 결과 > 시작 시 측정 (CALC_THREAD_AUTOTUNE=1) > 플러그인 기본값
+// 교체(ReloadModel)되는 모델과 대체 모델도 같은 구성으로 로드한다.
+void Calc::ResolveThreading()
+{
+    if (!m_config.cpuThreading.empty())
+    {
+        if (ThreadingConfig::Parse(m_config.cpuThreading, m_threading))
+        {
+            m_logger.LogInfo() << "Calc::ResolveThreading - CALC_CPU_THREADING " << m_threading.ToString();
+            return;
+        }
+        m_logger.LogWarn() << "Calc::ResolveThreading - invalid CALC_CPU_THREADING \"" << m_config.cpuThreading << "\", ignoring it";
+    }
+    if (m_config.backend != "openvino")
+    {
+        m_logger.LogInfo() << "Calc::ResolveThreading - using backend default threading";
+        return;
+    }
+
+    ThreadTuneRequest request;
+    request.backend = m_config.backend;
+    request.modelPath = m_config.modelPath;
+    request.deviceName = kDeviceName;
+    request.options.precision = m_config.inputPrecision;
+    request.options.cacheDir = m_config.cacheDir;
+    const size_t cores = std::max(1u, std::thread::hardware_concurrency());
+    request.cpuBudget = m_config.cpuBudget > 0 ? m_config.cpuBudget : std::max<size_t>(1, cores - 1);
+    if (!m_primaryCpus.empty())
+    {
+        request.cpuBudget = std::min(request.cpuBudget, m_primaryCpus.size());
+    }
+    request.asyncRequests = m_config.asyncRequests > 0 ? std::max<size_t>(2, m_config.asyncRequests) : 0;
+
+    const std::string cachePath = m_config.cacheDir.empty() ? std::string() : ThreadTuneCachePath(m_config.cacheDir, request);
+    if (!cachePath.empty() && LoadThreadTune(cachePath, m_threading))
+    {
+        m_logger.LogInfo() << "Calc::ResolveThreading - cached " << m_threading.ToString() << " (" << cachePath << ")";
+        return;
+    }
+    if (m_config.threadAutotune == 0)
+    {
+        m_logger.LogInfo() << "Calc::ResolveThreading - no cached tuning result, using backend default threading";
+        return;
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    std::vector<ThreadTuneResult> results = RunThreadTune(request);
+    for (const auto &result : results)
+    {
+        if (result.ok)
+        {
+            m_logger.LogInfo() << "Calc::ResolveThreading - " << result.config.ToString() << " : " << result.scoreMs << " ms";
+        }
+        else
+        {
+            m_logger.LogWarn() << "Calc::ResolveThreading - " << result.config.ToString() << " failed : " << result.error;
+        }
+    }
+    const size_t pick = PickThreadTune(results);
+    if (pick == results.size())
+    {
+        m_logger.LogWarn() << "Calc::ResolveThreading - no configuration succeeded, using backend default threading";
+        return;
+    }
+    m_threading = results[pick].config;
+    if (!cachePath.empty())
+    {
+        SaveThreadTune(cachePath, results[pick]);
+    }
+    m_logger.LogInfo() << "Calc::ResolveThreading - picked " << m_threading.ToString() << " (" << results[pick].scoreMs
+                       << " ms, CPU budget " << request.cpuBudget << ") after tuning "
+                       << std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count() << " ms";
+}
+
+// 섀도 모델이 있으면 섀도 코어를 주 경로에서 뺀다. 주 모델 로드 전에 초기화 스레드의 코어를 제한해 두면
+// 그 뒤에 만들어지는 추론 엔진 스레드가 제한을 물려받는다 (플러그인 기본값이나 bind=NO여도 섀도 코어를 쓰지 않는다).
+// 이미 떠 있는 작업 스레드는 KeepOffShadowCpus로 따로 제한한다.
+void Calc::ReservePrimaryCpus()
+{
+    if (m_config.shadowModelPath.empty())
+    {
+        return;
+    }
+
+    m_shadowCpus = ParseCpuList(m_config.shadowCpus);
+    const unsigned cores = std::max(1u, std::thread::hardware_concurrency());
+    if (m_config.shadowCpus.empty() && cores >= 2)
+    {
+        m_shadowCpus.push_back(static_cast<int>(cores - 1));
+    }
+
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    if (pthread_getaffinity_np(pthread_self(), sizeof(set), &set) != 0)
+    {
+        m_logger.LogWarn() << "Calc::ReservePrimaryCpus - cannot read the CPU affinity, primary path is not restricted";
+        return;
+    }
+    for (int cpu : m_shadowCpus)
+    {
+        if (cpu >= 0 && cpu < CPU_SETSIZE)
+        {
+            CPU_CLR(cpu, &set);
+        }
+    }
+    std::vector<int> primary;
+    for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu)
+    {
+        if (CPU_ISSET(cpu, &set))
+        {
+            primary.push_back(cpu);
+        }
+    }
+    if (primary.empty() || !PinCurrentThread(primary))
+    {
+        m_logger.LogWarn() << "Calc::ReservePrimaryCpus - no CPU left for the primary path outside the shadow cpus, primary path is not restricted";
+        return;
+    }
+    m_primaryCpus = std::move(primary);
+    m_logger.LogInfo() << "Calc::ReservePrimaryCpus - primary path on " << m_primaryCpus.size() << " cpus (shadow cpus excluded)";
+}
+
+// 생성자에서 만들어진 작업 스레드(수신, 추론, 모델 감시)를 주 경로 코어로 제한한다. 모델 교체 시 새 엔진 스레드도 이를 물려받는다.
+void Calc::KeepOffShadowCpus()
+{
+    if (!m_primaryCpus.empty() && !PinCurrentThread(m_primaryCpus))
+    {
+        m_logger.LogWarn() << "Calc::KeepOffShadowCpus - cannot restrict worker thread to the primary cpus";
+    }
+}
+
+// 섀도 모델: 메타데이터만 여기서 확인하고, 로드와 예열은 섀도 스레드가 지정 코어에서 낮은 우선순위로 한다 (시작을 늦추지 않는다).
+void Calc::StartShadow()
+{
+    if (m_config.shadowModelPath.empty())
+    {
+        return;
+    }
+
+    ShadowEvaluator::Settings settings;
+    // ReservePrimaryCpus가 주 경로에서 뺀 코어 (섀도 스레드는 물려받은 제한 대신 이 코어에 고정된다)
+    settings.cpus = m_shadowCpus;
+    settings.nice = static_cast<int>(std::min<size_t>(19, m_config.shadowNice));
+
+    const std::string metadataPath = ModelMetadata::DefaultPath(m_config.shadowModelPath);
+    try
+    {
+        ActionDecoder decoder = LoadDecoder(metadataPath, "Calc::StartShadow");
+
+        InferenceOptions options;
+        options.precision = m_config.inputPrecision;
+        options.cacheDir = m_config.cacheDir;
+        options.threads = std::max<size_t>(1, settings.cpus.size());
+        // 섀도 스레드의 코어 고정을 물려받도록 플러그인이 따로 고정하지 않게 한다.
+        options.bindThreads = "NO";
+        options.remoteAddress = m_config.remoteAddress;
+        options.remoteDeadlineMs = static_cast<double>(m_config.remoteDeadlineMs);
+        options.remoteFallback = m_config.remoteFallback;
+        const std::string backend = m_config.shadowBackend;
+        const std::string modelPath = m_config.shadowModelPath;
+        m_shadow.Start([backend, modelPath, options]() { return CreateInferenceBackend(backend, modelPath, kDeviceName, options); },
+                       std::move(decoder), settings);
+    }
+    catch (const std::exception &e)
+    {
+        m_logger.LogError() << "Calc::StartShadow - failed to start shadow model (" << m_config.shadowModelPath << ") : " << e.what();
+        return;
+    }
+
+    std::ostringstream cpus;
+    for (size_t i = 0; i < settings.cpus.size(); ++i)
+    {
+        cpus << (i > 0 ? "," : "") << settings.cpus[i];
+    }
+    m_logger.LogInfo() << "Calc::StartShadow - shadow model " << m_config.shadowModelPath << " (" << m_config.shadowBackend
+                       << ") on cpus " << (settings.cpus.empty() ? std::string("any") : cpus.str()) << ", nice " << settings.nice;
+}
+
+// 메타데이터 경로: CALC_MODEL_METADATA가 없으면 모델과 같은 디렉토리의 model_metadata.json
+std::string Calc::MetadataPath() const
+{
+    return m_config.metadataPath.empty() ? ModelMetadata::DefaultPath(m_config.modelPath) : m_config.metadataPath;
+}
+
+// 메타데이터로 출력 변환기를 만든다. 파일이 없으면 기존 Calc의 매핑(ModelMetadata::Baseline)으로 동작한다.
+ActionDecoder Calc::LoadDecoder(const std::string &metadataPath, const char *where)
+{
+    bool found = false;
+    ActionDecoder decoder(ModelMetadata::LoadOrBaseline(metadataPath, found));
+    if (!found)
+    {
+        m_logger.LogWarn() << where << " - " << metadataPath << " not found, using the baseline continuous mapping";
+        return decoder;
+    }
+    m_logger.LogInfo() << where << " - " << metadataPath << " : " << decoder.Description();
+    return decoder;
+}
+
 // 시작 함수: 컴포넌트 실행 시작
 void Calc::Start()
 {
@@ -60,6 +481,18 @@ void Calc::Start()
     Run();
 }
 
+// 종료 요청: 시그널 핸들러에서 호출되므로 eventfd에 쓰기만 한다 (async-signal-safe).
+// 엔진 대기, 스레드 join, 프로파일 파일 쓰기는 시그널이 도착한 스레드(작업 스레드나 엔진 콜백 스레드일 수 있다)가 아니라
+// Run에서 기다리던 스레드가 Terminate로 한다.
+void Calc::RequestStop()
+{
+    const int savedErrno = errno;
+    uint64_t one = 1;
+    ssize_t written = write(m_stopFd, &one, sizeof(one));
+    (void)written;
+    errno = savedErrno;
+}
+
 // 종료 함수: 리소스 정리 및 스레드 종료
 void Calc::Terminate()
 {
@@ -67,6 +500,36 @@ void Calc::Terminate()
 
     m_running = false;
 
+    // 추론 스레드가 멈춘 뒤에는 새 요청이 제출되지 않으므로, 그다음 진행 중인 비동기 추론을 기다리면
+    // 종료된 포트나 멈춘 섀도 평가기에 완료 콜백이 출력하지 않는다. 모델 교체 중이면 교체가 끝날 때까지 기다린다.
+    {
+        std::unique_lock<std::mutex> lock(m_frameTaskMutex);
+        m_frameTaskCv.wait(lock, [this] { return m_frameTasks == 0; });
+    }
+    if (auto model = std::atomic_load(&m_model))
+    {
+        model->engine->waitAll();
+        std::string report = model->engine->latencyReport();
+        if (!report.empty())
+        {
+            m_logger.LogInfo() << "Calc::Terminate - " << report;
+        }
+    }
+    if (m_fallbackModel)
+    {
+        m_fallbackModel->engine->waitAll();
+    }
+    ReportDeadlines("Calc::Terminate");
+    m_shadow.Stop();
+    ReportShadow("Calc::Terminate");
+    if (m_config.profiling)
+    {
+        if (auto model = std::atomic_load(&m_model))
+        {
+            DumpProfile(*model, "Calc::Terminate");
+        }
+    }
+
     m_ControlData->Terminate();
     m_RawData->Terminate();
 
@@ -79,17 +542,26 @@ void Calc::Run()
     m_logger.LogVerbose() << "Calc::Run";
 
     m_running = true;
+    m_frameTasks = 2; // TaskInferenceCyclic, TaskModelWatchCyclic
 
     m_workers.Async([this]{ TaskReceiveREventCyclic(); });
+    m_workers.Async([this]{ TaskInferenceCyclic(); });
     m_workers.Async([this]{ m_ControlData->SendEventCEventCyclic(); });
     m_workers.Async([this]{ m_RawData->ReceiveFieldRFieldCyclic(); });
-
-    m_workers.Wait();
+    m_workers.Async([this]{ TaskModelWatchCyclic(); });
+
+    // 종료 요청을 기다렸다가 이 스레드에서 정리한다.
+    uint64_t requests = 0;
+    while (m_stopFd >= 0 && read(m_stopFd, &requests, sizeof(requests)) < 0 && errno == EINTR)
+    {
+    }
+    Terminate();
 }
 
 // RawData 이벤트 수신 작업 함수
 void Calc::TaskReceiveREventCyclic()
 {
+    KeepOffShadowCpus();
     m_RawData->SetReceiveEventREventHandler([this](const auto &sample)
     { 
         OnReceiveREvent(sample); 
@@ -98,60 +570,389 @@ void Calc::TaskReceiveREventCyclic()
 }
 
 // RawData 이벤트 수신 처리 함수
+// 수신 스레드(포트 뮤텍스 보유 중)에서는 추론하지 않고 최신 프레임만 우편함에 넣는다.
+// 프레임 경로(수신 -> 추론 -> 출력)에서는 프레임마다 로그를 만들지 않는다. 상태는 kLatencyReportFrames마다 모아서 남긴다.
 void Calc::OnReceiveREvent(const deepracer::service::rawdata::proxy::events::REvent::SampleType &sample)
 {
-    std::vector<uint8_t> bufferCombined = sample;
+    if (sample.size() != kStereoFrameSize)
+    {
+        m_logger.LogWarn() << "Calc::OnReceiveREvent - skip frame, expected size = " << kStereoFrameSize;
+        return;
+    }
 
-    m_logger.LogInfo() << "Calc::OnReceiveREvent - buffer size = " << bufferCombined.size();
+    m_mailbox.Publish(sample.data(), sample.size());
+}
 
-    std::vector<float> result = dataProcess(bufferCombined);
+// 추론 작업 함수: 항상 가장 최근 프레임만 처리하고, 그 사이에 도착한 오래된 프레임은 건너뛴다.
+void Calc::TaskInferenceCyclic()
+{
+    KeepOffShadowCpus();
+    while (m_running)
+    {
+        const std::vector<uint8_t> *frame = nullptr;
+        uint64_t skipped = 0;
+        if (!m_mailbox.WaitTake(frame, skipped, std::chrono::milliseconds(100)))
+        {
+            continue;
+        }
+
+        // 추론이 카메라보다 느리면 거의 매 프레임 건너뛰므로 합계만 세고 주기 보고에서 남긴다.
+        m_staleFrames += skipped;
+
+        // 기한은 수신 스레드가 프레임을 게시한 시각부터 잰다 (우편함에서 기다린 시간 포함).
+        const auto arrival = m_mailbox.TakenPublishTime();
+
+        // 프레임마다 현재 모델을 가져온다. 모델 교체는 이 사이에 일어나므로 추론 중인 프레임은 영향을 받지 않는다.
+        // 결과는 추론한 엔진과 같은 모델의 변환기로 해석해야 하므로 둘을 함께 가져온다.
+        DeadlineMonitor::Event event = DeadlineMonitor::Event::None;
+        const bool fallback = m_deadlineMonitor.UseFallback(std::chrono::steady_clock::now(), event);
+        if (event == DeadlineMonitor::Event::Recovered)
+        {
+            DeadlineMonitor::Stats stats = m_deadlineMonitor.GetStats();
+            m_logger.LogInfo() << "Calc::TaskInferenceCyclic - retrying primary model after fallback of "
+                               << stats.lastEpisodeMs << " ms (" << stats.lastEpisodeFrames << " frames)";
+        }
+        // 프레임 하나를 끝낼 때까지 m_modelUseMutex를 잡아, ReloadModel이 이전 모델을 이 스레드가 더 쓰지 않는 시점을 알 수 있게 한다.
+        std::unique_lock<std::mutex> modelUse(m_modelUseMutex);
+        auto model = fallback ? m_fallbackModel : std::atomic_load(&m_model);
+        int64_t frameSequence = m_nextFrameSequence++;
+
+        if (frameSequence > 0 && frameSequence % kLatencyReportFrames == 0)
+        {
+            std::string report = model->engine->latencyReport();
+            if (!report.empty())
+            {
+                m_logger.LogInfo() << "Calc::TaskInferenceCyclic - " << report;
+            }
+            const FrameChangeDetector &detector = m_frameInference.Detector();
+            if (detector.Enabled())
+            {
+                m_logger.LogInfo() << "Calc::TaskInferenceCyclic - unchanged-frame skips " << detector.SkippedCount()
+                                   << " / " << detector.FrameCount() << " (" << detector.SkipRate() * 100.0 << " %)";
+            }
+            if (m_staleFrames > 0)
+            {
+                m_logger.LogInfo() << "Calc::TaskInferenceCyclic - skipped stale frames " << m_staleFrames << " / "
+                                   << m_mailbox.PublishedCount();
+            }
+            const uint64_t dropped = m_droppedResults.load(std::memory_order_relaxed);
+            if (dropped > 0)
+            {
+                m_logger.LogInfo() << "Calc::TaskInferenceCyclic - dropped out-of-order results " << dropped << " / " << frameSequence;
+            }
+            ReportDeadlines("Calc::TaskInferenceCyclic");
+            ReportShadow("Calc::TaskInferenceCyclic");
+        }
+
+        // 프로파일은 현재 사용 중인 모델(대체 모델 포함)의 것을 내보낸다.
+        const bool profileDue = m_config.profileEvery > 0 && frameSequence > 0 && frameSequence % m_config.profileEvery == 0;
+        if (m_profileRequested.exchange(false) || (m_config.profiling && profileDue))
+        {
+            if (m_config.profiling)
+            {
+                DumpProfile(*model, "Calc::TaskInferenceCyclic");
+            }
+            else
+            {
+                m_logger.LogWarn() << "Calc::TaskInferenceCyclic - profile requested but CALC_PROFILE is not set";
+            }
+        }
+
+        // 섀도 모델에는 주 모델로 추론하는 프레임만 넘긴다 (대체 모델 사용 중에는 주 경로가 이미 기한 위험 상태).
+        const bool shadow = !fallback && m_shadow.Accepting(std::chrono::steady_clock::now());
+
+        ControlCommand command;
+        FrameInference::Outcome outcome;
+        try
+        {
+            outcome = m_frameInference.Process(*frame, model->generation, *model->engine, model->decoder, command);
+        }
+        catch (const std::exception &e)
+        {
+            // 이번 프레임은 출력하지 않는다 (ControlData는 마지막 값을 유지). 기한은 실패한 프레임도 센다.
+            m_logger.LogError() << "Calc::TaskInferenceCyclic - inference failed, frame = " << frameSequence << " : " << e.what();
+            RecordDeadline(fallback, arrival);
+            continue;
+        }
+
+        if (outcome == FrameInference::Outcome::Skipped)
+        {
+            // ControlData 포트는 마지막으로 기록한 값을 계속 보내므로 추론만 생략하면 이전 조향/스로틀이 유지된다.
+            // 생략 횟수는 주기 보고의 unchanged-frame skips로 남는다.
+            continue;
+        }
+
+        if (outcome == FrameInference::Outcome::Submit)
+        {
+            // 결과 출력은 추론 완료 콜백(OnInferenceComplete)에서 진행된다.
+            // 콜백은 모델을 소유하지 않고 변환기만 가리킨다. 모델을 해제하는 쪽(ReloadModel, Terminate)이 먼저 waitAll()로
+            // 진행 중 요청의 콜백을 모두 끝내므로 변환기는 콜백보다 오래 산다.
+            const ActionDecoder *decoder = &model->decoder;
+            model->engine->submitAsync(*frame, [this, frameSequence, decoder, fallback, arrival](const InferenceBackend::AsyncResult &result)
+            {
+                OnInferenceComplete(result, frameSequence, *decoder, fallback, arrival);
+            });
+            if (shadow)
+            {
+                m_shadow.Offer(*frame, frameSequence);
+            }
+            continue;
+        }
+
+        PublishControl(command);
+        RecordDeadline(fallback, arrival);
+        if (shadow)
+        {
+            // 주 모델 출력이 나간 뒤에 넘기므로 섀도 모델은 이번 프레임의 기한에 영향을 주지 않는다.
+            m_shadow.RecordPrimary(frameSequence, command);
+            m_shadow.Offer(*frame, frameSequence);
+        }
+    }
+    FrameTaskExited();
+}
 
-    m_logger.LogInfo() << "Calc::OnReceiveREvent - Mapping Input = {" << result[0] << " , " << result[1] << "}";
+// 비동기 추론 완료 콜백 (백엔드의 완료 스레드에서 호출)
+// frameSequence는 Calc가 매긴 프레임 순번으로, 모델이 교체되어 엔진의 요청 순번이 다시 0부터 시작해도 단조 증가한다.
+void Calc::OnInferenceComplete(const InferenceBackend::AsyncResult &result, int64_t frameSequence, const ActionDecoder &decoder,
+                               bool fallback, std::chrono::steady_clock::time_point arrival)
+{
+    // 실패하거나 버려진 결과도 그 프레임의 조향/스로틀이 기한 안에 나가지 못한 것이므로 함께 기록한다.
+    RecordDeadline(fallback, arrival);
+
+    if (!result.ok || result.output.size() != decoder.OutputSize())
+    {
+        m_logger.LogError() << "Calc::OnInferenceComplete - inference failed, seq = " << result.sequence << " : "
+                            << (result.ok ? "unexpected output size " + std::to_string(result.output.size()) : result.error);
+        m_frameInference.InvalidateReference();
+        return;
+    }
+
+    // 요청이 순서와 다르게 끝난 경우, 이미 더 최신 프레임의 결과가 나갔다면 오래된 결과는 버린다.
+    int64_t last = m_lastPublishedSequence.load();
+    while (frameSequence > last)
+    {
+        if (m_lastPublishedSequence.compare_exchange_weak(last, frameSequence))
+        {
+            const ControlCommand command = decoder.Decode(result.output.data());
+            PublishControl(command);
+            if (!fallback)
+            {
+                m_shadow.RecordPrimary(frameSequence, command);
+            }
+            return;
+        }
+    }
+    m_droppedResults.fetch_add(1, std::memory_order_relaxed);
+    m_frameInference.InvalidateReference();
+}
 
-    float steering = mapsteering(result[0]);
-    float throttle = mapThrottle(result[1]);
+// 모델 파일 감시 작업 함수: 변경되면 이 스레드에서 새 모델을 컴파일/예열한 뒤 프레임 사이에 교체한다.
+void Calc::TaskModelWatchCyclic()
+{
+    KeepOffShadowCpus();
+    if (m_config.modelPollMs == 0)
+    {
+        m_logger.LogInfo() << "Calc::TaskModelWatchCyclic - model reload disabled";
+        FrameTaskExited();
+        return;
+    }
+
+    const auto interval = std::chrono::milliseconds(m_config.modelPollMs);
+    const std::string metadataPath = MetadataPath();
+    ModelStamp current = ReadModelStamp(m_config.modelPath, metadataPath);
+    ModelStamp pending = current;
+    auto nextPoll = std::chrono::steady_clock::now() + interval;
+
+    while (m_running)
+    {
+        // 종료가 늦어지지 않도록 짧게 나눠 잔다.
+        std::this_thread::sleep_for(std::min<std::chrono::steady_clock::duration>(interval, std::chrono::milliseconds(100)));
+        if (std::chrono::steady_clock::now() < nextPoll)
+        {
+            continue;
+        }
+        nextPoll = std::chrono::steady_clock::now() + interval;
+
+        ModelStamp stamp = ReadModelStamp(m_config.modelPath, metadataPath);
+        if (stamp == current)
+        {
+            pending = current;
+            continue;
+        }
+        // 파일을 복사하는 중일 수 있으므로 두 번 연속 같은 상태로 확인된 뒤에 교체한다.
+        if (!(stamp == pending))
+        {
+            pending = stamp;
+            continue;
+        }
+
+        current = stamp;
+        ReloadModel();
+    }
+    FrameTaskExited();
+}
 
-    std::array<float,2> mapped = {steering , throttle};
-    // ControlData 서비스의 CEvent로 전송해야 할 값을 변경한다. 이 함수는 전송 타겟 값을 변경할 뿐 실제 전송은 다른 부분에서 진행된다.
-    m_ControlData->WriteDataCEvent(mapped);
-    m_logger.LogInfo() << "m_ControlData::WriteDataCEvent({ " << steering << " , " << throttle << " })";
+// 추론/모델 감시 작업이 끝났음을 Terminate에 알린다.
+void Calc::FrameTaskExited()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_frameTaskMutex);
+        --m_frameTasks;
+    }
+    m_frameTaskCv.notify_all();
 }
 
-float Calc::mapsteering(float input_value)
+// 새 모델을 컴파일/예열해 현재 모델과 교체한다. 실패하면 현재 모델을 유지한다.
+void Calc::ReloadModel()
 {
-    float output = std::max(-1.0f, std::min(1.0f, input_value));
-    return output;
+    m_logger.LogInfo() << "Calc::ReloadModel - model " << m_config.modelPath << " changed, compiling in background";
+
+    auto start = std::chrono::steady_clock::now();
+    std::shared_ptr<LoadedModel> model;
+    try
+    {
+        model = LoadModel(m_config.modelPath, MetadataPath(), m_config.backend);
+    }
+    catch (const std::exception &e)
+    {
+        m_logger.LogError() << "Calc::ReloadModel - failed to load " << m_config.modelPath << ", keeping current model : " << e.what();
+        return;
+    }
+    auto ready = std::chrono::steady_clock::now();
+
+    // 추론 스레드는 프레임마다 m_model을 새로 가져오므로, 교체는 포인터 하나를 바꾸는 것으로 끝난다.
+    std::shared_ptr<LoadedModel> previous = std::atomic_exchange(&m_model, model);
+    auto swapped = std::chrono::steady_clock::now();
+
+    m_logger.LogInfo() << "Calc::ReloadModel - swapped in "
+                       << std::chrono::duration_cast<std::chrono::microseconds>(swapped - ready).count() << " us (load + warm-up "
+                       << std::chrono::duration_cast<std::chrono::milliseconds>(ready - start).count() << " ms)";
+
+    // 추론 스레드가 교체 전에 가져간 프레임을 끝내면(m_modelUseMutex를 놓으면) 이전 모델에 새 요청이 더 제출되지 않는다.
+    // 그다음 진행 중 요청의 완료 콜백을 모두 기다린 뒤 이 스레드에서 해제한다 (콜백은 모델을 소유하지 않는다).
+    {
+        std::lock_guard<std::mutex> modelUse(m_modelUseMutex);
+    }
+    previous->engine->waitAll();
+    previous.reset();
 }
 
-// mapping
-float Calc::mapThrottle(float input_value)
+// 프레임 하나의 완료 시각을 기한과 비교하고, 주 모델이 기한을 계속 넘겨 대체 모델로 전환되면 알린다.
+// 주 모델이 기한에 가까워지면 섀도 모델을 잠시 멈추고, 반복되면 내려놓는다.
+void Calc::RecordDeadline(bool fallback, std::chrono::steady_clock::time_point arrival)
 {
-    float input = abs(input_value);
-    // 이차 함수에 따라 스로틀 값을 매핑 (y = -0.133333x^2 + 0.733333x)
-    float output = -0.133333f * input * input + 0.733333f * input;
-    
-    // 출력 값이 0 ~ 1 범위 내에 있는지 확인하고 제한
-    output = std::max(0.0f, std::min(1.0f, output));
-    
-    return output;
+    const auto now = std::chrono::steady_clock::now();
+    const DeadlineMonitor::Event event = m_deadlineMonitor.Record(fallback, arrival, now);
+    if (event == DeadlineMonitor::Event::Degraded)
+    {
+        m_logger.LogWarn() << "Calc::RecordDeadline - primary model missed " << m_config.deadlineMissLimit << " of the last "
+                           << kDeadlineWindowFrames << " frame deadlines (" << m_config.frameDeadlineMs
+                           << " ms), switching to fallback model " << m_config.fallbackModelPath;
+    }
+
+    if (m_config.shadowModelPath.empty() || fallback)
+    {
+        return;
+    }
+    const auto deadline = std::chrono::milliseconds(m_config.frameDeadlineMs > 0 ? m_config.frameDeadlineMs : kShadowDefaultDeadlineMs);
+    if (event != DeadlineMonitor::Event::Degraded && (now - arrival) * kShadowGuardDenominator < deadline * kShadowGuardNumerator)
+    {
+        return;
+    }
+    const auto latencyMs = std::chrono::duration_cast<std::chrono::milliseconds>(now - arrival).count();
+    if (m_shadow.Suspend(now + std::chrono::milliseconds(m_config.shadowHoldMs)))
+    {
+        m_logger.LogWarn() << "Calc::RecordDeadline - primary frame took " << latencyMs << " ms, dropping shadow model "
+                           << m_config.shadowModelPath << " after " << m_shadow.GetStats().suspensions << " pauses";
+    }
 }
 
-std::vector<float> Calc::dataProcess(std::vector<uint8_t> input_vector){
-    // 모델 경로 및 디바이스 설정
-    std::string modelPath = "./model.xml"; // 실제 경로로 변경
-    std::string deviceName = "CPU";
+// 기한 초과율과 대체 모델 사용 구간 통계
+void Calc::ReportDeadlines(const char *where)
+{
+    DeadlineMonitor::Stats stats = m_deadlineMonitor.GetStats();
+    if (!m_deadlineMonitor.Enabled() || stats.frames == 0)
+    {
+        return;
+    }
+    const uint64_t primaryFrames = stats.frames - stats.fallbackFrames;
+    const uint64_t primaryMisses = stats.misses - stats.fallbackMisses;
+    m_logger.LogInfo() << where << " - deadline misses " << stats.misses << " / " << stats.frames << " ("
+                       << 100.0 * stats.misses / stats.frames << " %), primary " << primaryMisses << " / " << primaryFrames
+                       << ", fallback " << stats.fallbackMisses << " / " << stats.fallbackFrames
+                       << ", worst " << stats.worstLatencyMs << " ms, fallback episodes " << stats.episodes
+                       << " (" << stats.fallbackMs << " ms total, last " << stats.lastEpisodeMs << " ms / "
+                       << stats.lastEpisodeFrames << " frames)" << (stats.degraded ? ", on fallback now" : "");
+}
 
-    // 추론 엔진 생성
-    InferenceEngineWrapper engine(modelPath, deviceName);
+// 섀도 모델 상태와 주 모델 대비 출력 차이
+void Calc::ReportShadow(const char *where)
+{
+    ShadowEvaluator::Stats stats = m_shadow.GetStats();
+    if (stats.state == ShadowEvaluator::State::Off)
+    {
+        return;
+    }
+    m_logger.LogInfo() << where << " - shadow " << ShadowEvaluator::StateName(stats.state) << ", inferred " << stats.inferred
+                       << " / " << stats.offered << " offered (" << stats.busyDrops << " busy), latency mean "
+                       << stats.meanLatencyMs << " ms max " << stats.maxLatencyMs << " ms, compared " << stats.compared
+                       << " (" << stats.unpaired << " unpaired), |steering diff| mean " << stats.meanSteeringDiff << " max "
+                       << stats.maxSteeringDiff << ", |throttle diff| mean " << stats.meanThrottleDiff << " max "
+                       << stats.maxThrottleDiff << ", pauses " << stats.suspensions
+                       << (stats.error.empty() ? std::string() : ", error: " + stats.error);
+}
 
-    // 입력 데이터 설정 (예: 임의 데이터)
-    engine.setInputData(input_vector);
+// 시그널 핸들러에서 호출되므로 원자 변수에 표시만 하고, 실제 내보내기는 추론 스레드가 다음 프레임에서 한다.
+void Calc::RequestProfileDump()
+{
+    m_profileRequested.store(true);
+}
 
-    // 추론 실행
-    std::vector<float> results = engine.runInference();
+// 레이어별 추론 시간: 표는 로그로, JSON은 CALC_PROFILE_PATH로 내보낸다.
+void Calc::DumpProfile(const LoadedModel &model, const char *where)
+{
+    std::vector<InferenceBackend::LayerTiming> layers = model.engine->layerProfile();
+    if (layers.empty())
+    {
+        m_logger.LogInfo() << where << " - no layer profile from backend " << model.engine->name() << " yet";
+        return;
+    }
+
+    std::istringstream table(FormatLayerProfileTable(layers));
+    std::string line;
+    m_logger.LogInfo() << where << " - layer profile (" << model.engine->name() << ")";
+    while (std::getline(table, line))
+    {
+        m_logger.LogInfo() << "  " << line;
+    }
+
+    // 읽는 쪽이 쓰다 만 파일을 보지 않도록 임시 파일에 쓴 뒤 이름을 바꾼다.
+    const std::string tmpPath = m_config.profilePath + ".tmp";
+    {
+        std::ofstream file(tmpPath);
+        file << LayerProfileJson(layers, model.engine->name()) << "\n";
+        if (!file)
+        {
+            m_logger.LogWarn() << where << " - cannot write " << tmpPath;
+            return;
+        }
+    }
+    std::error_code ec;
+    std::filesystem::rename(tmpPath, m_config.profilePath, ec);
+    if (ec)
+    {
+        m_logger.LogWarn() << where << " - cannot write " << m_config.profilePath << " : " << ec.message();
+        return;
+    }
+    m_logger.LogInfo() << where << " - layer profile written to " << m_config.profilePath;
+}
 
-    // 결과 출력
-    return {results[0], results[1]};
+// 모델의 action space에 따라 변환한 조향/스로틀을 ControlData로 출력
+void Calc::PublishControl(const ControlCommand &command)
+{
+    std::array<float,2> mapped = {command.steering , command.throttle};
+    // ControlData 서비스의 CEvent로 전송해야 할 값을 변경한다. 이 함수는 전송 타겟 값을 변경할 뿐 실제 전송은 다른 부분에서 진행된다.
+    m_ControlData->WriteDataCEvent(mapped);
 }
 
 } /// namespace aa
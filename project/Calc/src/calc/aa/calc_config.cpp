@@ -0,0 +1,115 @@
+#include "calc/aa/calc_config.h"
+
+#include <cstdlib>
+#include <cstring>
+
+namespace calc
+{
+namespace aa
+{
+
+namespace
+{
+
+std::string GetEnvString(const char* name, const std::string& defaultValue)
+{
+    const char* value = std::getenv(name);
+    if (value == nullptr || *value == '\0')
+    {
+        return defaultValue;
+    }
+    return value;
+}
+
+size_t GetEnvSize(const char* name, size_t defaultValue)
+{
+    const char* value = std::getenv(name);
+    if (value == nullptr || *value == '\0')
+    {
+        return defaultValue;
+    }
+    char* end = nullptr;
+    unsigned long long parsed = std::strtoull(value, &end, 10);
+    if (end == value || *end != '\0')
+    {
+        return defaultValue;
+    }
+    return static_cast<size_t>(parsed);
+}
+
+float GetEnvFloat(const char* name, float defaultValue)
+{
+    const char* value = std::getenv(name);
+    if (value == nullptr || *value == '\0')
+    {
+        return defaultValue;
+    }
+    char* end = nullptr;
+    float parsed = std::strtof(value, &end);
+    if (end == value || *end != '\0' || parsed < 0.0f)
+    {
+        return defaultValue;
+    }
+    return parsed;
+}
+
+InputPrecision GetEnvPrecision(const char* name, InputPrecision defaultValue)
+{
+    const char* value = std::getenv(name);
+    if (value == nullptr)
+    {
+        return defaultValue;
+    }
+    if (std::strcmp(value, "U8") == 0)
+    {
+        return InputPrecision::U8;
+    }
+    if (std::strcmp(value, "FP32") == 0)
+    {
+        return InputPrecision::FP32;
+    }
+    return defaultValue;
+}
+
+} // namespace
+
+CalcConfig CalcConfig::FromEnvironment()
+{
+    CalcConfig config;
+    config.backend = GetEnvString("CALC_BACKEND", config.backend);
+    config.remoteAddress = GetEnvString("CALC_REMOTE_ADDRESS", config.remoteAddress);
+    config.remoteDeadlineMs = GetEnvSize("CALC_REMOTE_DEADLINE_MS", config.remoteDeadlineMs);
+    config.remoteFallback = GetEnvString("CALC_REMOTE_FALLBACK", config.remoteFallback);
+    config.modelPath = GetEnvString("CALC_MODEL_PATH", config.modelPath);
+    config.metadataPath = GetEnvString("CALC_MODEL_METADATA", config.metadataPath);
+    if (const char* cacheDir = std::getenv("CALC_CACHE_DIR"))
+    {
+        config.cacheDir = cacheDir;
+    }
+    config.modelPollMs = GetEnvSize("CALC_MODEL_POLL_MS", config.modelPollMs);
+    config.asyncRequests = GetEnvSize("CALC_ASYNC_REQUESTS", config.asyncRequests);
+    config.skipThreshold = GetEnvFloat("CALC_SKIP_THRESHOLD", config.skipThreshold);
+    config.skipMaxFrames = GetEnvSize("CALC_SKIP_MAX_FRAMES", config.skipMaxFrames);
+    config.frameDeadlineMs = GetEnvSize("CALC_FRAME_DEADLINE_MS", config.frameDeadlineMs);
+    config.fallbackModelPath = GetEnvString("CALC_FALLBACK_MODEL_PATH", config.fallbackModelPath);
+    config.fallbackBackend = GetEnvString("CALC_FALLBACK_BACKEND", config.fallbackBackend);
+    config.deadlineMissLimit = GetEnvSize("CALC_DEADLINE_MISS_LIMIT", config.deadlineMissLimit);
+    config.fallbackHoldMs = GetEnvSize("CALC_FALLBACK_HOLD_MS", config.fallbackHoldMs);
+    config.cpuThreading = GetEnvString("CALC_CPU_THREADING", config.cpuThreading);
+    config.threadAutotune = GetEnvSize("CALC_THREAD_AUTOTUNE", config.threadAutotune);
+    config.cpuBudget = GetEnvSize("CALC_CPU_BUDGET", config.cpuBudget);
+    config.profiling = GetEnvSize("CALC_PROFILE", config.profiling ? 1 : 0) != 0;
+    config.profileWindow = GetEnvSize("CALC_PROFILE_WINDOW", config.profileWindow);
+    config.profileEvery = GetEnvSize("CALC_PROFILE_EVERY", config.profileEvery);
+    config.profilePath = GetEnvString("CALC_PROFILE_PATH", config.profilePath);
+    config.shadowModelPath = GetEnvString("CALC_SHADOW_MODEL_PATH", config.shadowModelPath);
+    config.shadowBackend = GetEnvString("CALC_SHADOW_BACKEND", config.shadowBackend);
+    config.shadowCpus = GetEnvString("CALC_SHADOW_CPUS", config.shadowCpus);
+    config.shadowNice = GetEnvSize("CALC_SHADOW_NICE", config.shadowNice);
+    config.shadowHoldMs = GetEnvSize("CALC_SHADOW_HOLD_MS", config.shadowHoldMs);
+    config.inputPrecision = GetEnvPrecision("CALC_INPUT_PRECISION", config.inputPrecision);
+    return config;
+}
+
+} /// namespace aa
+} /// namespace calc
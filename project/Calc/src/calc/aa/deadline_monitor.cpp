@@ -0,0 +1,145 @@
+#include "calc/aa/deadline_monitor.h"
+
+#include <algorithm>
+
+namespace calc
+{
+namespace aa
+{
+
+DeadlineMonitor::DeadlineMonitor()
+    : m_recentCount(0)
+    , m_recentNext(0)
+    , m_recentMisses(0)
+    , m_degraded(false)
+    , m_episodeFrames(0)
+    , m_holdScale(1)
+    , m_primarySinceRecovery(0)
+{
+}
+
+void DeadlineMonitor::Configure(const Settings& settings)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_settings = settings;
+    m_settings.window = std::max<size_t>(1, m_settings.window);
+    m_settings.missLimit = std::min(std::max<size_t>(1, m_settings.missLimit), m_settings.window);
+    m_recent.assign(m_settings.window, 0);
+    m_recentCount = 0;
+    m_recentNext = 0;
+    m_recentMisses = 0;
+    m_degraded = false;
+    m_episodeFrames = 0;
+    m_holdScale = 1;
+    m_primarySinceRecovery = 0;
+    m_stats = Stats();
+}
+
+bool DeadlineMonitor::Enabled() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_settings.deadline.count() > 0;
+}
+
+bool DeadlineMonitor::UseFallback(Clock::time_point now, Event& event)
+{
+    event = Event::None;
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (!m_degraded)
+    {
+        return false;
+    }
+    if (now - m_degradedSince < m_settings.hold * m_holdScale)
+    {
+        return true;
+    }
+
+    // 주 모델을 다시 시도한다. 이전 기록은 과부하 상태의 것이므로 버리고 새로 센다.
+    EndEpisode(now);
+    event = Event::Recovered;
+    return false;
+}
+
+DeadlineMonitor::Event DeadlineMonitor::Record(bool fallback, Clock::time_point arrival, Clock::time_point completed)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_settings.deadline.count() <= 0)
+    {
+        return Event::None;
+    }
+
+    const double latencyMs = std::chrono::duration<double, std::milli>(completed - arrival).count();
+    const bool missed = completed - arrival > m_settings.deadline;
+    ++m_stats.frames;
+    m_stats.misses += missed ? 1 : 0;
+    m_stats.worstLatencyMs = std::max(m_stats.worstLatencyMs, latencyMs);
+    if (fallback)
+    {
+        ++m_stats.fallbackFrames;
+        m_stats.fallbackMisses += missed ? 1 : 0;
+        ++m_episodeFrames;
+        return Event::None;
+    }
+
+    // 전환 직후 도착하는 주 모델의 진행 중 결과는 전환 판단에 쓰지 않는다.
+    if (m_degraded)
+    {
+        return Event::None;
+    }
+
+    ++m_primarySinceRecovery;
+    if (m_recentCount == m_recent.size())
+    {
+        m_recentMisses -= m_recent[m_recentNext];
+    }
+    else
+    {
+        ++m_recentCount;
+    }
+    m_recent[m_recentNext] = missed ? 1 : 0;
+    m_recentMisses += m_recent[m_recentNext];
+    m_recentNext = (m_recentNext + 1) % m_recent.size();
+    if (!m_settings.fallbackAvailable || m_recentMisses < m_settings.missLimit)
+    {
+        return Event::None;
+    }
+
+    // 주 모델로 돌아온 뒤 한 창을 채우기도 전에 다시 넘기면 과부하가 계속되는 것으로 보고 hold를 늘린다.
+    if (m_stats.episodes > 0 && m_primarySinceRecovery <= m_settings.window)
+    {
+        m_holdScale = std::min(m_holdScale * 2, kMaxHoldScale);
+    }
+    else
+    {
+        m_holdScale = 1;
+    }
+    m_degraded = true;
+    m_degradedSince = completed;
+    m_episodeFrames = 0;
+    ++m_stats.episodes;
+    return Event::Degraded;
+}
+
+DeadlineMonitor::Stats DeadlineMonitor::GetStats() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    Stats stats = m_stats;
+    stats.degraded = m_degraded;
+    return stats;
+}
+
+void DeadlineMonitor::EndEpisode(Clock::time_point now)
+{
+    const double episodeMs = std::chrono::duration<double, std::milli>(now - m_degradedSince).count();
+    m_stats.fallbackMs += episodeMs;
+    m_stats.lastEpisodeMs = episodeMs;
+    m_stats.lastEpisodeFrames = m_episodeFrames;
+    m_degraded = false;
+    m_recentCount = 0;
+    m_recentNext = 0;
+    m_recentMisses = 0;
+    m_primarySinceRecovery = 0;
+}
+
+} /// namespace aa
+} /// namespace calc
@@ -0,0 +1,203 @@
+#include "calc/aa/frame_change_detector.h"
+
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+
+#if defined(__x86_64__)
+#include <immintrin.h>
+#define CALC_CHANGE_DETECTOR_X86 1
+#endif
+
+namespace calc
+{
+namespace aa
+{
+
+namespace
+{
+
+using SadFn = uint64_t (*)(const uint8_t*, const uint8_t*);
+
+// 격자 i번째 줄의 프레임 내 위치 (두 평면이 이어져 있고 높이가 kChangeGridRowStep의 배수라 평면 경계를 따로 볼 필요가 없다)
+inline const uint8_t* GridRow(const uint8_t* frame, size_t row)
+{
+    return frame + row * kChangeGridRowStep * kStereoWidth;
+}
+
+uint64_t SadScalar(const uint8_t* frame, const uint8_t* grid)
+{
+    uint64_t sum = 0;
+    for (size_t row = 0; row < kChangeGridRows; ++row)
+    {
+        const uint8_t* src = GridRow(frame, row);
+        const uint8_t* ref = grid + row * kStereoWidth;
+        for (size_t x = 0; x < kStereoWidth; ++x)
+        {
+            sum += static_cast<uint64_t>(std::abs(static_cast<int>(src[x]) - static_cast<int>(ref[x])));
+        }
+    }
+    return sum;
+}
+
+#ifdef CALC_CHANGE_DETECTOR_X86
+
+static_assert(kStereoWidth % 32 == 0, "grid rows are processed in 32-byte blocks");
+
+// psadbw: 16바이트의 절대 차이를 8바이트씩 더해 64비트 두 칸에 누적한다.
+uint64_t SadSse2(const uint8_t* frame, const uint8_t* grid)
+{
+    __m128i acc = _mm_setzero_si128();
+    for (size_t row = 0; row < kChangeGridRows; ++row)
+    {
+        const uint8_t* src = GridRow(frame, row);
+        const uint8_t* ref = grid + row * kStereoWidth;
+        for (size_t x = 0; x < kStereoWidth; x += 16)
+        {
+            __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + x));
+            __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(ref + x));
+            acc = _mm_add_epi64(acc, _mm_sad_epu8(a, b));
+        }
+    }
+    return static_cast<uint64_t>(_mm_cvtsi128_si64(acc)) + static_cast<uint64_t>(_mm_cvtsi128_si64(_mm_unpackhi_epi64(acc, acc)));
+}
+
+__attribute__((target("avx2")))
+uint64_t SadAvx2(const uint8_t* frame, const uint8_t* grid)
+{
+    __m256i acc = _mm256_setzero_si256();
+    for (size_t row = 0; row < kChangeGridRows; ++row)
+    {
+        const uint8_t* src = GridRow(frame, row);
+        const uint8_t* ref = grid + row * kStereoWidth;
+        for (size_t x = 0; x < kStereoWidth; x += 32)
+        {
+            __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + x));
+            __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(ref + x));
+            acc = _mm256_add_epi64(acc, _mm256_sad_epu8(a, b));
+        }
+    }
+    __m128i sum = _mm_add_epi64(_mm256_castsi256_si128(acc), _mm256_extracti128_si256(acc, 1));
+    return static_cast<uint64_t>(_mm_cvtsi128_si64(sum)) + static_cast<uint64_t>(_mm_cvtsi128_si64(_mm_unpackhi_epi64(sum, sum)));
+}
+
+#endif // CALC_CHANGE_DETECTOR_X86
+
+struct Dispatch
+{
+    SadFn sad;
+    const char* isa;
+};
+
+const Dispatch& SelectSad()
+{
+    static const Dispatch dispatch = []() -> Dispatch {
+#ifdef CALC_CHANGE_DETECTOR_X86
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx2"))
+        {
+            return {SadAvx2, "avx2"};
+        }
+        return {SadSse2, "sse2"};
+#else
+        return {SadScalar, "scalar"};
+#endif
+    }();
+    return dispatch;
+}
+
+} // namespace
+
+void SampleChangeGrid(const uint8_t* frame, uint8_t* grid)
+{
+    for (size_t row = 0; row < kChangeGridRows; ++row)
+    {
+        std::memcpy(grid + row * kStereoWidth, GridRow(frame, row), kStereoWidth);
+    }
+}
+
+uint64_t ChangeGridSad(const uint8_t* frame, const uint8_t* grid)
+{
+    return SelectSad().sad(frame, grid);
+}
+
+uint64_t ChangeGridSadReference(const uint8_t* frame, const uint8_t* grid)
+{
+    return SadScalar(frame, grid);
+}
+
+const char* ChangeGridIsa()
+{
+    return SelectSad().isa;
+}
+
+FrameChangeDetector::FrameChangeDetector(float threshold, uint32_t maxConsecutiveSkips)
+    : m_thresholdSad(threshold > 0.0f ? static_cast<uint64_t>(std::ceil(threshold * kChangeGridSize)) : 0)
+    , m_maxSkips(maxConsecutiveSkips)
+    , m_reference(kChangeGridSize)
+    , m_hasReference(false)
+    , m_consecutiveSkips(0)
+    , m_lastSad(0)
+    , m_frames(0)
+    , m_skipped(0)
+{
+}
+
+bool FrameChangeDetector::Enabled() const
+{
+    return m_thresholdSad > 0 && m_maxSkips > 0;
+}
+
+bool FrameChangeDetector::ShouldSkip(const uint8_t* frame)
+{
+    ++m_frames;
+    if (!Enabled())
+    {
+        return false;
+    }
+
+    if (m_hasReference)
+    {
+        m_lastSad = ChangeGridSad(frame, m_reference.data());
+        if (m_lastSad < m_thresholdSad && m_consecutiveSkips < m_maxSkips)
+        {
+            ++m_consecutiveSkips;
+            ++m_skipped;
+            return true;
+        }
+    }
+
+    SampleChangeGrid(frame, m_reference.data());
+    m_hasReference = true;
+    m_consecutiveSkips = 0;
+    return false;
+}
+
+void FrameChangeDetector::Reset()
+{
+    m_hasReference = false;
+    m_consecutiveSkips = 0;
+}
+
+float FrameChangeDetector::LastDifference() const
+{
+    return static_cast<float>(m_lastSad) / kChangeGridSize;
+}
+
+uint64_t FrameChangeDetector::FrameCount() const
+{
+    return m_frames;
+}
+
+uint64_t FrameChangeDetector::SkippedCount() const
+{
+    return m_skipped;
+}
+
+double FrameChangeDetector::SkipRate() const
+{
+    return m_frames == 0 ? 0.0 : static_cast<double>(m_skipped) / m_frames;
+}
+
+} /// namespace aa
+} /// namespace calc
@@ -0,0 +1,77 @@
+#include "calc/aa/frame_inference.h"
+
+#include <stdexcept>
+#include <string>
+
+namespace calc
+{
+namespace aa
+{
+
+FrameInference::FrameInference()
+    : m_modelGeneration(0)
+    , m_referenceStale(false)
+{
+}
+
+void FrameInference::Configure(float skipThreshold, uint32_t skipMaxFrames)
+{
+    m_detector = FrameChangeDetector(skipThreshold, skipMaxFrames);
+    m_modelGeneration = 0;
+}
+
+FrameInference::Outcome FrameInference::Process(const std::vector<uint8_t>& frame, uint64_t modelGeneration, InferenceBackend& engine,
+                                                const ActionDecoder& decoder, ControlCommand& command)
+{
+    // 모델이 바뀌면(교체, 대체 모델 전환) 이전 모델의 결과를 재사용하지 않도록 기준 프레임을 버린다.
+    if (modelGeneration != m_modelGeneration)
+    {
+        m_detector.Reset();
+        m_modelGeneration = modelGeneration;
+        m_output.reserve(decoder.OutputSize());
+    }
+    if (m_referenceStale.exchange(false))
+    {
+        m_detector.Reset();
+    }
+    if (m_detector.ShouldSkip(frame.data()))
+    {
+        return Outcome::Skipped;
+    }
+    if (engine.isAsync())
+    {
+        return Outcome::Submit;
+    }
+
+    try
+    {
+        // 우편함 버퍼를 복사 없이 넘기고, 출력은 미리 확보한 버퍼에 받는다.
+        engine.setInputData(frame);
+        engine.runInferenceInto(m_output);
+        if (m_output.size() != decoder.OutputSize())
+        {
+            throw std::runtime_error("unexpected output size " + std::to_string(m_output.size()));
+        }
+    }
+    catch (...)
+    {
+        // 이번 프레임의 결과는 나가지 않으므로 다음 프레임은 추론한다.
+        m_detector.Reset();
+        throw;
+    }
+    command = decoder.Decode(m_output.data());
+    return Outcome::Inferred;
+}
+
+void FrameInference::InvalidateReference()
+{
+    m_referenceStale.store(true);
+}
+
+const FrameChangeDetector& FrameInference::Detector() const
+{
+    return m_detector;
+}
+
+} /// namespace aa
+} /// namespace calc
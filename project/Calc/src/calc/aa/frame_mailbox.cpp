@@ -0,0 +1,91 @@
+#include "calc/aa/frame_mailbox.h"
+
+#include <cstring>
+#include <stdexcept>
+
+namespace calc
+{
+namespace aa
+{
+
+FrameMailbox::FrameMailbox(size_t frameSize)
+    : m_sequences{0, 0, 0}
+    , m_middle(1)
+    , m_back(0)
+    , m_front(2)
+    , m_published(0)
+    , m_lastTaken(0)
+{
+    for (auto& buffer : m_buffers)
+    {
+        buffer.resize(frameSize);
+    }
+}
+
+void FrameMailbox::Publish(const uint8_t* data, size_t size)
+{
+    if (size != m_buffers[m_back].size())
+    {
+        throw std::invalid_argument("FrameMailbox::Publish - unexpected frame size");
+    }
+
+    std::memcpy(m_buffers[m_back].data(), data, size);
+    m_publishTimes[m_back] = std::chrono::steady_clock::now();
+    m_sequences[m_back] = m_published.load(std::memory_order_relaxed) + 1;
+    m_published.store(m_sequences[m_back], std::memory_order_relaxed);
+
+    // 채운 버퍼를 중간 칸과 교환한다. 소비자가 가져가지 않은 이전 프레임 버퍼는 다음 쓰기에 재사용된다.
+    uint32_t previous = m_middle.exchange(m_back | kFresh, std::memory_order_acq_rel);
+    m_back = previous & kIndexMask;
+
+    {
+        std::lock_guard<std::mutex> lock(m_waitMutex);
+    }
+    m_waitCv.notify_one();
+}
+
+bool FrameMailbox::TryTake(const std::vector<uint8_t>*& frame, uint64_t& skipped)
+{
+    if ((m_middle.load(std::memory_order_acquire) & kFresh) == 0)
+    {
+        return false;
+    }
+
+    uint32_t previous = m_middle.exchange(m_front, std::memory_order_acq_rel);
+    m_front = previous & kIndexMask;
+
+    uint64_t sequence = m_sequences[m_front];
+    skipped = sequence - m_lastTaken - 1;
+    m_lastTaken = sequence;
+    frame = &m_buffers[m_front];
+    return true;
+}
+
+bool FrameMailbox::WaitTake(const std::vector<uint8_t>*& frame, uint64_t& skipped, std::chrono::milliseconds timeout)
+{
+    if (TryTake(frame, skipped))
+    {
+        return true;
+    }
+
+    {
+        std::unique_lock<std::mutex> lock(m_waitMutex);
+        m_waitCv.wait_for(lock, timeout, [this] {
+            return (m_middle.load(std::memory_order_acquire) & kFresh) != 0;
+        });
+    }
+    return TryTake(frame, skipped);
+}
+
+uint64_t FrameMailbox::PublishedCount() const
+{
+    return m_published.load(std::memory_order_relaxed);
+}
+
+std::chrono::steady_clock::time_point FrameMailbox::TakenPublishTime() const
+{
+    return m_publishTimes[m_front];
+}
+
+} /// namespace aa
+} /// namespace calc
@@ -0,0 +1,68 @@
+#include "calc/aa/inference_backend.h"
+#include "calc/aa/native_inference_engine.h"
+#include "calc/aa/remote_inference_client.h"
+#ifdef CALC_WITH_OPENVINO
+#include "calc/aa/inference_engine_wrapper.h"
+#endif
+
+#include <chrono>
+#include <stdexcept>
+
+void InferenceBackend::runInferenceInto(std::vector<float>& output) {
+    std::vector<float> result = runInference();
+    output.assign(result.begin(), result.end());
+}
+
+uint64_t InferenceBackend::submitAsync(const std::vector<uint8_t>& inputData, CompletionCallback callback) {
+    // 비동기를 지원하지 않는 백엔드: 호출 스레드에서 바로 추론하고 콜백을 호출한다.
+    AsyncResult result{};
+    result.sequence = syncSequence++;
+    result.inFlight = 1;
+    auto start = std::chrono::steady_clock::now();
+    try {
+        setInputData(inputData);
+        result.output = runInference();
+        result.ok = true;
+    } catch (const std::exception& e) {
+        result.ok = false;
+        result.error = e.what();
+    }
+    result.queuedMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    if (callback) {
+        callback(result);
+    }
+    return result.sequence;
+}
+
+std::vector<std::string> AvailableInferenceBackends() {
+    std::vector<std::string> names;
+#ifdef CALC_WITH_OPENVINO
+    names.push_back("openvino");
+#endif
+    names.push_back("native");
+    names.push_back("native-generic");
+    return names;
+}
+
+std::string DefaultInferenceBackend() {
+    return AvailableInferenceBackends().front();
+}
+
+std::unique_ptr<InferenceBackend> CreateInferenceBackend(const std::string& backendName, const std::string& modelPath,
+                                                         const std::string& deviceName, const InferenceOptions& options) {
+    if (backendName == "native") {
+        return std::make_unique<NativeInferenceEngine>(modelPath, options);
+    }
+    if (backendName == "native-generic") {
+        return std::make_unique<NativeInferenceEngine>(modelPath, options, false);
+    }
+    if (backendName == "remote") {
+        return std::make_unique<RemoteInferenceClient>(modelPath, deviceName, options);
+    }
+#ifdef CALC_WITH_OPENVINO
+    if (backendName == "openvino") {
+        return std::make_unique<InferenceEngineWrapper>(modelPath, deviceName, options);
+    }
+#endif
+    throw std::invalid_argument("CreateInferenceBackend - unknown or unavailable backend '" + backendName + "'");
+}
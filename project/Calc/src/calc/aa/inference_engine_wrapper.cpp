@@ -1,52 +1,438 @@
 #include "calc/aa/inference_engine_wrapper.h"
+#include "calc/aa/stereo_preprocess.h"
+#include <ngraph/opsets/opset1.hpp>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
 #include <iostream>
 #include <stdexcept>
 
-InferenceEngineWrapper::InferenceEngineWrapper(const std::string& modelPath, const std::string& deviceName)
-    : modelPath(modelPath), deviceName(deviceName) {
+namespace {
+
+// FNV-1a 64bit: 캐시 키용 (암호학적 용도 아님)
+constexpr uint64_t kFnvOffset = 1469598103934665603ULL;
+constexpr uint64_t kFnvPrime = 1099511628211ULL;
+
+uint64_t HashBytes(uint64_t hash, const char* data, size_t size) {
+    for (size_t i = 0; i < size; ++i) {
+        hash ^= static_cast<uint8_t>(data[i]);
+        hash *= kFnvPrime;
+    }
+    return hash;
+}
+
+uint64_t HashFile(uint64_t hash, const std::string& path) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        throw std::runtime_error("InferenceEngineWrapper - cannot read " + path);
+    }
+    char buffer[64 * 1024];
+    while (file) {
+        file.read(buffer, sizeof(buffer));
+        hash = HashBytes(hash, buffer, static_cast<size_t>(file.gcount()));
+    }
+    return hash;
+}
+
+} // namespace
+
+InferenceEngineWrapper::InferenceEngineWrapper(const std::string& modelPath, const std::string& deviceName, const InferenceOptions& options)
+    : modelPath(modelPath), deviceName(deviceName), opts(options) {
+    if (opts.batch == 0) {
+        throw std::invalid_argument("InferenceEngineWrapper - batch must be at least 1");
+    }
+    if (opts.profiling) {
+        profiler = std::make_unique<calc::aa::LayerProfiler>(opts.profileWindow);
+    }
     loadModel();
 }
 
 InferenceEngineWrapper::~InferenceEngineWrapper() {
-    // 자원 해제는 자동으로 이루어짐
+    // 완료 콜백이 파괴된 객체를 참조하지 않도록 진행 중인 비동기 요청을 기다린다.
+    waitAll();
 }
 
 void InferenceEngineWrapper::loadModel() {
+    auto start = std::chrono::steady_clock::now();
+
+    // 캐시가 있으면 컴파일된 네트워크를 가져오고, 없거나 실패하면 컴파일 후 캐시로 내보낸다.
+    std::string cachePath;
+    if (!opts.cacheDir.empty()) {
+        cachePath = cacheFilePath();
+        fromCache = importFromCache(cachePath);
+    }
+    if (!fromCache) {
+        compileModel();
+        if (!cachePath.empty()) {
+            exportToCache(cachePath);
+        }
+    }
+
+    // 입력 및 출력 이름 가져오기
+    inputName = executableNet.GetInputsInfo().begin()->first;
+    outputName = executableNet.GetOutputsInfo().begin()->first;
+
+    // 추론 요청 객체 초기화
+    inferRequest = executableNet.CreateInferRequest();
+
+    loadMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+void InferenceEngineWrapper::compileModel() {
     // IR 모델 로드
     auto network = ie.ReadNetwork(modelPath);
 
-    // 입력 및 출력 정보 가져오기
-    inputInfo = network.getInputsInfo();
-    outputInfo = network.getOutputsInfo();
+    const bool u8Input = (opts.precision == InputPrecision::U8);
+    if (u8Input) {
+        insertNormalization(network);
+    }
+
+    // 배치 추론: 입력 shape의 첫 번째 축(N)을 batch로 바꾼다.
+    if (opts.batch > 1) {
+        auto shapes = network.getInputShapes();
+        for (auto& shape : shapes) {
+            shape.second[0] = opts.batch;
+        }
+        network.reshape(shapes);
+    }
 
-    // 입력 형식 설정
-    for (auto& input : inputInfo) {
-        input.second->setPrecision(InferenceEngine::Precision::FP32);
+    // 입력 형식 설정: U8이면 uint8 -> float 변환을 플러그인이 네트워크 입력단에서 수행한다.
+    for (auto& input : network.getInputsInfo()) {
+        input.second->setPrecision(u8Input ? InferenceEngine::Precision::U8 : InferenceEngine::Precision::FP32);
     }
 
     // 네트워크를 특정 디바이스에 로드
-    executableNet = ie.LoadNetwork(network, deviceName);
+    executableNet = ie.LoadNetwork(network, deviceName, pluginConfig());
+}
 
-    // 추론 요청 객체 초기화
-    inferRequest = executableNet.CreateInferRequest();
+std::map<std::string, std::string> InferenceEngineWrapper::pluginConfig() const {
+    // 스레드 수는 컴파일 결과가 아닌 실행 설정이므로 캐시 키에 포함하지 않고, 가져올 때도 같은 설정을 전달한다.
+    std::map<std::string, std::string> config;
+    if (opts.threads > 0) {
+        config[InferenceEngine::PluginConfigParams::KEY_CPU_THREADS_NUM] = std::to_string(opts.threads);
+    }
+    // 처리량 모드: 스트림마다 코어를 나눠 여러 요청을 동시에 실행한다 (요청 수는 enableAsync로 맞춘다).
+    if (opts.streams > 0) {
+        config[InferenceEngine::PluginConfigParams::KEY_CPU_THROUGHPUT_STREAMS] = std::to_string(opts.streams);
+    }
+    // 코어 고정: 같은 코어를 쓰는 Sensor 캡처 스레드/포트 워커와 부딪히면 고정하지 않는 편이 빠를 수 있다 (Calc 시작 시 자동 조정).
+    if (!opts.bindThreads.empty()) {
+        config[InferenceEngine::PluginConfigParams::KEY_CPU_BIND_THREAD] = opts.bindThreads;
+    }
+    // 레이어별 실행 시간 수집 (프로파일링 모드)
+    if (opts.profiling) {
+        config[InferenceEngine::PluginConfigParams::KEY_PERF_COUNT] = InferenceEngine::PluginConfigParams::YES;
+    }
+    return config;
 }
 
-void InferenceEngineWrapper::setInputData(const std::vector<uint8_t>& inputData) {
-    // 입력 Blob 생성
-    auto inputBlob = inferRequest.GetBlob(inputInfo.begin()->first);
-    auto data = inputBlob->buffer().as<float*>();
-    std::copy(inputData.begin(), inputData.end(), data);
+std::string InferenceEngineWrapper::cacheFilePath() const {
+    // 파일 이름: <모델 이름>-<위치/설정 키>-<내용 키>.blob
+    //   위치/설정 키: 모델 XML의 전체 경로 + 디바이스 + 컴파일 결과에 영향을 주는 옵션
+    //   내용 키: 모델 XML + 가중치(.bin). 재학습한 모델은 XML이 같고 가중치만 다를 수 있으므로 .bin도 해시에 포함한다.
+    // DeepRacer 모델은 모두 model.xml이라 주/대체/섀도 모델이 같은 캐시 디렉터리를 쓸 때 위치/설정 키로 구분한다.
+    std::filesystem::path xmlPath(modelPath);
+    std::filesystem::path binPath = xmlPath;
+    binPath.replace_extension(".bin");
+
+    std::error_code ec;
+    std::filesystem::path absolutePath = std::filesystem::weakly_canonical(xmlPath, ec);
+    if (ec) {
+        absolutePath = std::filesystem::absolute(xmlPath);
+    }
+    std::string key = absolutePath.string() + "|" + deviceName + "|" + (opts.precision == InputPrecision::U8 ? "U8" : "FP32") +
+                      "|" + std::to_string(opts.inputScale) + "|" + std::to_string(opts.inputOffset) + "|" +
+                      std::to_string(opts.batch);
+    uint64_t keyHash = HashBytes(kFnvOffset, key.data(), key.size());
+
+    uint64_t contentHash = HashFile(kFnvOffset, xmlPath.string());
+    if (std::filesystem::exists(binPath)) {
+        contentHash = HashFile(contentHash, binPath.string());
+    }
+
+    char hex[34];
+    std::snprintf(hex, sizeof(hex), "%016llx-%016llx", static_cast<unsigned long long>(keyHash),
+                  static_cast<unsigned long long>(contentHash));
+    return (std::filesystem::path(opts.cacheDir) / (xmlPath.stem().string() + "-" + hex + ".blob")).string();
 }
 
-std::vector<float> InferenceEngineWrapper::runInference() {
-    // 추론 실행
-    inferRequest.Infer();
+bool InferenceEngineWrapper::importFromCache(const std::string& cachePath) {
+    if (!std::filesystem::exists(cachePath)) {
+        return false;
+    }
+    try {
+        executableNet = ie.ImportNetwork(cachePath, deviceName, pluginConfig());
+        return true;
+    } catch (const std::exception& e) {
+        // 플러그인/OpenVINO 버전이 바뀌어 가져올 수 없는 캐시는 다시 만든다.
+        cacheError = "cannot import " + cachePath + ", recompiled: " + e.what();
+        return false;
+    }
+}
 
+void InferenceEngineWrapper::exportToCache(const std::string& cachePath) {
+    try {
+        std::filesystem::path path(cachePath);
+        std::filesystem::create_directories(path.parent_path());
+
+        // 중간에 종료되어도 깨진 캐시가 남지 않도록 임시 파일에 쓴 뒤 이름을 바꾼다.
+        std::string tmpPath = cachePath + ".tmp";
+        executableNet.Export(tmpPath);
+        std::filesystem::rename(tmpPath, path);
+
+        // 같은 위치/설정 키의 이전 캐시(같은 모델 파일의 내용이 바뀌기 전)만 삭제한다.
+        // 다른 경로의 모델이나 다른 입력 정밀도 설정의 캐시는 그대로 둔다.
+        std::string name = path.filename().string();
+        std::string prefix = name.substr(0, name.size() - 16 - 5);
+        for (const auto& entry : std::filesystem::directory_iterator(path.parent_path())) {
+            std::string other = entry.path().filename().string();
+            bool sameModel = other.size() == name.size() && other.compare(0, prefix.size(), prefix) == 0 &&
+                             entry.path().extension() == ".blob";
+            if (sameModel && entry.path() != path) {
+                std::filesystem::remove(entry.path());
+            }
+        }
+    } catch (const std::exception& e) {
+        // 캐시는 최적화일 뿐이므로 실패해도 로드는 계속한다.
+        cacheError += (cacheError.empty() ? "" : "; ") + std::string("cannot export ") + cachePath + ": " + e.what();
+    }
+}
+
+void InferenceEngineWrapper::insertNormalization(InferenceEngine::CNNNetwork& network) {
+    if (opts.inputScale == 1.0f && opts.inputOffset == 0.0f) {
+        return;
+    }
+
+    // Parameter -> Multiply(scale) -> Add(offset) -> 기존 소비자 순으로 연결한다.
+    auto function = network.getFunction();
+    if (!function) {
+        throw std::runtime_error("InferenceEngineWrapper - network has no ngraph function, cannot add input normalization");
+    }
+    auto parameter = function->get_parameters().front();
+    auto consumers = parameter->output(0).get_target_inputs();
+
+    auto scale = ngraph::opset1::Constant::create(ngraph::element::f32, ngraph::Shape{1}, {opts.inputScale});
+    auto offset = ngraph::opset1::Constant::create(ngraph::element::f32, ngraph::Shape{1}, {opts.inputOffset});
+    auto multiply = std::make_shared<ngraph::opset1::Multiply>(parameter, scale);
+    auto add = std::make_shared<ngraph::opset1::Add>(multiply, offset);
+    for (auto& consumer : consumers) {
+        consumer.replace_source_output(add);
+    }
+
+    network = InferenceEngine::CNNNetwork(function);
+}
+
+void InferenceEngineWrapper::fillInput(InferenceEngine::InferRequest& request, const std::vector<uint8_t>& inputData) {
+    if (inputData.size() != opts.batch * calc::aa::kStereoFrameSize) {
+        throw std::invalid_argument("InferenceEngineWrapper - unexpected frame size " + std::to_string(inputData.size()));
+    }
+
+    // 입력 Blob 메모리에 직접 기록: 프레임마다 좌/우 평면 -> (120, 160, 2) 인터리브
+    auto inputBlob = request.GetBlob(inputName);
+    for (size_t i = 0; i < opts.batch; ++i) {
+        const size_t offset = i * calc::aa::kStereoFrameSize;
+        const uint8_t* left = inputData.data() + offset;
+        const uint8_t* right = left + calc::aa::kStereoPlaneSize;
+        if (opts.precision == InputPrecision::U8) {
+            // float 변환 및 정규화는 네트워크 안에서 수행되므로 바이트 인터리브만 한다 (FP32 대비 입력 크기 1/4).
+            auto data = inputBlob->buffer().as<uint8_t*>();
+            calc::aa::InterleaveStereoU8(left, right, data + offset, calc::aa::kStereoPlaneSize);
+        } else {
+            // 인터리브 + float 변환 + 정규화를 한 번에 수행
+            auto data = inputBlob->buffer().as<float*>();
+            calc::aa::InterleaveStereoToFloat(left, right, data + offset, calc::aa::kStereoPlaneSize, opts.inputScale, opts.inputOffset);
+        }
+    }
+}
+
+std::vector<float> InferenceEngineWrapper::readOutput(InferenceEngine::InferRequest& request) {
     // 출력 Blob 가져오기
-    auto outputBlob = inferRequest.GetBlob(outputInfo.begin()->first);
+    auto outputBlob = request.GetBlob(outputName);
     const float* outputData = outputBlob->buffer().as<float*>();
     size_t outputSize = outputBlob->size();
 
     // 결과 복사 및 반환
     return std::vector<float>(outputData, outputData + outputSize);
 }
+
+void InferenceEngineWrapper::setInputData(const std::vector<uint8_t>& inputData) {
+    syncFillUs = fillInputTimed(inferRequest, inputData);
+}
+
+std::string InferenceEngineWrapper::name() const {
+    return "openvino";
+}
+
+const InferenceOptions& InferenceEngineWrapper::options() const {
+    return opts;
+}
+
+bool InferenceEngineWrapper::loadedFromCache() const {
+    return fromCache;
+}
+
+std::string InferenceEngineWrapper::cacheWarning() const {
+    return cacheError;
+}
+
+double InferenceEngineWrapper::loadTimeMs() const {
+    return loadMs;
+}
+
+std::vector<float> InferenceEngineWrapper::runInference() {
+    // 추론 실행
+    inferRequest.Infer();
+    if (profiler) {
+        recordProfile(inferRequest, syncFillUs);
+    }
+
+    return readOutput(inferRequest);
+}
+
+void InferenceEngineWrapper::runInferenceInto(std::vector<float>& output) {
+    inferRequest.Infer();
+    if (profiler) {
+        recordProfile(inferRequest, syncFillUs);
+    }
+
+    // 출력 Blob을 호출자 버퍼에 복사 (용량이 충분하면 재할당 없음)
+    auto outputBlob = inferRequest.GetBlob(outputName);
+    const float* outputData = outputBlob->buffer().as<float*>();
+    output.assign(outputData, outputData + outputBlob->size());
+}
+
+void InferenceEngineWrapper::enableAsync(size_t numRequests) {
+    if (numRequests < 2) {
+        throw std::invalid_argument("InferenceEngineWrapper::enableAsync - at least 2 requests are required for pipelining");
+    }
+
+    waitAll();
+
+    std::lock_guard<std::mutex> lock(asyncMutex);
+    idleSlots.clear();
+    asyncSlots.clear();
+    for (size_t i = 0; i < numRequests; ++i) {
+        auto slot = std::make_unique<AsyncSlot>();
+        slot->request = executableNet.CreateInferRequest();
+
+        AsyncSlot* raw = slot.get();
+        slot->request.SetCompletionCallback(
+            std::function<void(InferenceEngine::InferRequest, InferenceEngine::StatusCode)>(
+                [this, raw](InferenceEngine::InferRequest, InferenceEngine::StatusCode status) {
+                    onAsyncComplete(raw, status);
+                }));
+
+        idleSlots.push_back(raw);
+        asyncSlots.push_back(std::move(slot));
+    }
+}
+
+bool InferenceEngineWrapper::isAsync() const {
+    return !asyncSlots.empty();
+}
+
+uint64_t InferenceEngineWrapper::submitAsync(const std::vector<uint8_t>& inputData, CompletionCallback callback) {
+    if (!isAsync()) {
+        throw std::logic_error("InferenceEngineWrapper::submitAsync - async mode is not enabled");
+    }
+
+    AsyncSlot* slot = nullptr;
+    {
+        std::unique_lock<std::mutex> lock(asyncMutex);
+        asyncCv.wait(lock, [this] { return !idleSlots.empty(); });
+        slot = idleSlots.back();
+        idleSlots.pop_back();
+        slot->sequence = nextSequence++;
+    }
+
+    // 전처리는 잠금 밖에서 수행해 다른 요청의 추론과 겹치도록 한다.
+    try {
+        slot->fillUs = fillInputTimed(slot->request, inputData);
+    } catch (...) {
+        std::lock_guard<std::mutex> lock(asyncMutex);
+        idleSlots.push_back(slot);
+        asyncCv.notify_all();
+        throw;
+    }
+
+    slot->callback = std::move(callback);
+    slot->submitTime = std::chrono::steady_clock::now();
+    inFlightCount.fetch_add(1);
+    slot->request.StartAsync();
+    return slot->sequence;
+}
+
+void InferenceEngineWrapper::onAsyncComplete(AsyncSlot* slot, InferenceEngine::StatusCode status) {
+    AsyncResult result;
+    result.ok = (status == InferenceEngine::StatusCode::OK);
+    result.sequence = slot->sequence;
+    result.queuedMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - slot->submitTime).count();
+    result.inFlight = inFlightCount.load();
+
+    // 출력을 읽지 못해도 콜백은 반드시 호출해, 호출자가 그 프레임을 실패로 기록하고 이유를 로그로 남기게 한다.
+    if (result.ok) {
+        try {
+            result.output = readOutput(slot->request);
+            if (profiler) {
+                recordProfile(slot->request, slot->fillUs);
+            }
+        } catch (const std::exception& e) {
+            result.ok = false;
+            result.output.clear();
+            result.error = e.what();
+        }
+    } else {
+        result.error = "infer request failed with status " + std::to_string(static_cast<int>(status));
+    }
+    if (slot->callback) {
+        try {
+            slot->callback(result);
+        } catch (...) {
+            // Inference Engine 스레드로 예외가 전파되지 않도록 한다 (오류 보고는 콜백의 몫).
+        }
+    }
+
+    slot->callback = nullptr;
+
+    std::lock_guard<std::mutex> lock(asyncMutex);
+    idleSlots.push_back(slot);
+    inFlightCount.fetch_sub(1);
+    asyncCv.notify_all();
+}
+
+size_t InferenceEngineWrapper::inFlight() const {
+    return inFlightCount.load();
+}
+
+void InferenceEngineWrapper::waitAll() {
+    std::unique_lock<std::mutex> lock(asyncMutex);
+    asyncCv.wait(lock, [this] { return idleSlots.size() == asyncSlots.size(); });
+}
+
+double InferenceEngineWrapper::fillInputTimed(InferenceEngine::InferRequest& request, const std::vector<uint8_t>& inputData) {
+    if (!profiler) {
+        fillInput(request, inputData);
+        return 0.0;
+    }
+    auto start = std::chrono::steady_clock::now();
+    fillInput(request, inputData);
+    return std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+}
+
+void InferenceEngineWrapper::recordProfile(InferenceEngine::InferRequest& request, double fillUs) {
+    // 실행되지 않았거나 다른 레이어에 합쳐진 레이어는 빼고, 입력 전처리(Blob 기록)를 의사 레이어로 함께 센다.
+    std::vector<calc::aa::LayerSample> layers;
+    layers.push_back({"<input preprocess>", "Preprocess", calc::aa::StereoPreprocessIsa(), fillUs});
+    for (const auto& counter : request.GetPerformanceCounts()) {
+        const InferenceEngine::InferenceEngineProfileInfo& info = counter.second;
+        if (info.status != InferenceEngine::InferenceEngineProfileInfo::EXECUTED) {
+            continue;
+        }
+        layers.push_back({counter.first, info.layer_type, info.exec_type, static_cast<double>(info.realTime_uSec)});
+    }
+    profiler->Record(layers);
+}
+
+std::vector<InferenceBackend::LayerTiming> InferenceEngineWrapper::layerProfile() const {
+    return profiler ? profiler->Snapshot() : std::vector<LayerTiming>();
+}
@@ -0,0 +1,129 @@
+#include "calc/aa/layer_profiler.h"
+#include "calc/aa/json/json.h"
+
+#include <algorithm>
+#include <iomanip>
+#include <sstream>
+
+namespace calc
+{
+namespace aa
+{
+
+LayerProfiler::LayerProfiler(size_t window)
+    : m_window(std::max<size_t>(1, window))
+    , m_samples(m_window)
+    , m_next(0)
+    , m_count(0)
+{
+}
+
+void LayerProfiler::Record(const std::vector<LayerSample>& layers)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    std::vector<double>& sample = m_samples[m_next];
+    sample.assign(m_layers.size(), 0.0);
+    for (const auto& layer : layers)
+    {
+        auto it = m_index.find(layer.name);
+        if (it == m_index.end())
+        {
+            it = m_index.emplace(layer.name, m_layers.size()).first;
+            m_layers.push_back(Layer{layer.name, layer.type, layer.execType});
+            sample.push_back(0.0);
+        }
+        sample[it->second] += layer.us;
+    }
+    m_next = (m_next + 1) % m_window;
+    m_count = std::min(m_count + 1, m_window);
+}
+
+std::vector<InferenceBackend::LayerTiming> LayerProfiler::Snapshot() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    std::vector<InferenceBackend::LayerTiming> timings(m_layers.size());
+    double total = 0.0;
+    for (size_t i = 0; i < m_layers.size(); ++i)
+    {
+        InferenceBackend::LayerTiming& timing = timings[i];
+        timing.name = m_layers[i].name;
+        timing.type = m_layers[i].type;
+        timing.execType = m_layers[i].execType;
+        timing.samples = m_count;
+        double sum = 0.0;
+        for (size_t s = 0; s < m_count; ++s)
+        {
+            // 레이어가 나중에 추가되었으면 그 이전 샘플은 짧다 (0으로 본다).
+            const double us = i < m_samples[s].size() ? m_samples[s][i] : 0.0;
+            sum += us;
+            timing.maxUs = std::max(timing.maxUs, us);
+        }
+        timing.meanUs = m_count > 0 ? sum / m_count : 0.0;
+        total += timing.meanUs;
+    }
+    for (auto& timing : timings)
+    {
+        timing.share = total > 0.0 ? timing.meanUs / total : 0.0;
+    }
+    std::sort(timings.begin(), timings.end(), [](const auto& a, const auto& b) { return a.meanUs > b.meanUs; });
+    return timings;
+}
+
+std::string FormatLayerProfileTable(const std::vector<InferenceBackend::LayerTiming>& layers, size_t maxRows)
+{
+    double total = 0.0;
+    for (const auto& layer : layers)
+    {
+        total += layer.meanUs;
+    }
+
+    std::ostringstream oss;
+    oss << std::fixed << std::setprecision(1);
+    oss << std::right << std::setw(10) << "mean us" << std::setw(10) << "max us" << std::setw(8) << "share"
+        << "  " << std::left << std::setw(16) << "type" << std::setw(22) << "exec" << "layer\n";
+    const size_t rows = (maxRows == 0) ? layers.size() : std::min(maxRows, layers.size());
+    for (size_t i = 0; i < rows; ++i)
+    {
+        const auto& layer = layers[i];
+        oss << std::right << std::setw(10) << layer.meanUs << std::setw(10) << layer.maxUs << std::setw(7)
+            << layer.share * 100.0 << "%  " << std::left << std::setw(16) << layer.type << std::setw(22) << layer.execType
+            << layer.name << "\n";
+    }
+    if (rows < layers.size())
+    {
+        oss << "  ... " << layers.size() - rows << " more layer(s)\n";
+    }
+    oss << std::right << std::setw(10) << total << " us total over " << (layers.empty() ? 0 : layers.front().samples)
+        << " inference(s)";
+    return oss.str();
+}
+
+std::string LayerProfileJson(const std::vector<InferenceBackend::LayerTiming>& layers, const std::string& backend)
+{
+    Json::Value root;
+    root["backend"] = backend;
+    root["samples"] = Json::UInt64(layers.empty() ? 0 : layers.front().samples);
+    double total = 0.0;
+    root["layers"] = Json::Value(Json::arrayValue);
+    for (const auto& layer : layers)
+    {
+        Json::Value entry;
+        entry["name"] = layer.name;
+        entry["type"] = layer.type;
+        entry["exec_type"] = layer.execType;
+        entry["mean_us"] = layer.meanUs;
+        entry["max_us"] = layer.maxUs;
+        entry["share"] = layer.share;
+        root["layers"].append(entry);
+        total += layer.meanUs;
+    }
+    root["total_us"] = total;
+
+    Json::StreamWriterBuilder builder;
+    builder["indentation"] = "  ";
+    builder["precision"] = 6;
+    return Json::writeString(builder, root);
+}
+
+} /// namespace aa
+} /// namespace calc
@@ -0,0 +1,153 @@
+#include "calc/aa/model_metadata.h"
+#include "calc/aa/json/json.h"
+
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+
+namespace calc
+{
+namespace aa
+{
+
+namespace
+{
+
+// Sensor가 보내는 입력: 스테레오 카메라 좌/우 그레이스케일 평면
+const char* const kStereoCameras = "STEREO_CAMERAS";
+const char* const kGreyScale = "GREY_SCALE";
+
+float ReadNumber(const Json::Value& object, const char* key, const std::string& where)
+{
+    if (!object.isObject() || !object.isMember(key) || !object[key].isNumeric())
+    {
+        throw std::runtime_error("model metadata: " + where + "." + key + " must be a number");
+    }
+    return object[key].asFloat();
+}
+
+ActionRange ReadRange(const Json::Value& actionSpace, const char* key)
+{
+    ActionRange range;
+    range.low = ReadNumber(actionSpace[key], "low", std::string("action_space.") + key);
+    range.high = ReadNumber(actionSpace[key], "high", std::string("action_space.") + key);
+    if (range.low > range.high)
+    {
+        throw std::runtime_error(std::string("model metadata: action_space.") + key + " low is greater than high");
+    }
+    return range;
+}
+
+} // namespace
+
+ModelMetadata ModelMetadata::Load(const std::string& path)
+{
+    std::ifstream ifs(path);
+    if (!ifs)
+    {
+        throw std::runtime_error("model metadata: cannot open " + path);
+    }
+    Json::Value root;
+    Json::Reader reader;
+    if (!reader.parse(ifs, root) || !root.isObject())
+    {
+        throw std::runtime_error("model metadata: cannot parse " + path + " : " + reader.getFormattedErrorMessages());
+    }
+
+    ModelMetadata metadata;
+    for (const auto& sensor : root["sensor"])
+    {
+        metadata.sensors.push_back(sensor.asString());
+    }
+    metadata.neuralNetwork = root.get("neural_network", "").asString();
+    // preprocess_type이 없는 이전 버전 메타데이터는 그레이스케일 입력으로 본다.
+    metadata.preprocessType = root.get("preprocess_type", kGreyScale).asString();
+
+    // 입력 전처리: Sensor가 보내는 스테레오 그레이스케일 평면을 그대로 인터리브하는 구성만 지원한다.
+    if (metadata.sensors.size() != 1 || metadata.sensors[0] != kStereoCameras)
+    {
+        throw std::runtime_error("model metadata: unsupported sensor configuration (only " + std::string(kStereoCameras) + ")");
+    }
+    if (metadata.preprocessType != kGreyScale)
+    {
+        throw std::runtime_error("model metadata: unsupported preprocess_type " + metadata.preprocessType);
+    }
+
+    // 출력 해석: action_space_type이 없는 이전 버전은 action_space가 배열이면 discrete
+    const Json::Value& actionSpace = root["action_space"];
+    std::string type = root.get("action_space_type", actionSpace.isArray() ? "discrete" : "continuous").asString();
+    if (type == "continuous")
+    {
+        metadata.actionSpaceType = ActionSpaceType::Continuous;
+        metadata.steeringAngle = ReadRange(actionSpace, "steering_angle");
+        metadata.speed = ReadRange(actionSpace, "speed");
+        if (metadata.speed.low < 0.0f)
+        {
+            throw std::runtime_error("model metadata: action_space.speed must not be negative");
+        }
+    }
+    else if (type == "discrete")
+    {
+        if (!actionSpace.isArray() || actionSpace.empty())
+        {
+            throw std::runtime_error("model metadata: discrete action_space must be a non-empty array");
+        }
+        metadata.actionSpaceType = ActionSpaceType::Discrete;
+        metadata.actions.resize(actionSpace.size());
+        std::vector<bool> assigned(actionSpace.size(), false);
+        for (Json::ArrayIndex i = 0; i < actionSpace.size(); ++i)
+        {
+            // index 키가 있으면 그 위치에, 없으면 나열 순서대로 놓는다.
+            Json::ArrayIndex index = actionSpace[i].get("index", i).asUInt();
+            if (index >= actionSpace.size())
+            {
+                throw std::runtime_error("model metadata: action index " + std::to_string(index) + " is out of range");
+            }
+            // 같은 index가 두 번 나오면 한 행동이 덮이고 다른 자리는 0으로 남으므로 거부한다.
+            if (assigned[index])
+            {
+                throw std::runtime_error("model metadata: duplicate action index " + std::to_string(index));
+            }
+            assigned[index] = true;
+            const std::string where = "action_space[" + std::to_string(i) + "]";
+            metadata.actions[index].steeringAngle = ReadNumber(actionSpace[i], "steering_angle", where);
+            metadata.actions[index].speed = ReadNumber(actionSpace[i], "speed", where);
+        }
+    }
+    else
+    {
+        throw std::runtime_error("model metadata: unsupported action_space_type " + type);
+    }
+    return metadata;
+}
+
+ModelMetadata ModelMetadata::Baseline()
+{
+    ModelMetadata metadata;
+    metadata.sensors.push_back(kStereoCameras);
+    metadata.preprocessType = kGreyScale;
+    metadata.actionSpaceType = ActionSpaceType::Continuous;
+    metadata.steeringAngle = ActionRange{-1.0f, 1.0f};
+    metadata.speed = ActionRange{-1.0f, 1.0f};
+    return metadata;
+}
+
+ModelMetadata ModelMetadata::LoadOrBaseline(const std::string& path, bool& found)
+{
+    std::error_code ec;
+    found = std::filesystem::exists(path, ec);
+    return found ? Load(path) : Baseline();
+}
+
+std::string ModelMetadata::DefaultPath(const std::string& modelPath)
+{
+    return (std::filesystem::path(modelPath).parent_path() / "model_metadata.json").string();
+}
+
+size_t ModelMetadata::OutputSize() const
+{
+    return actionSpaceType == ActionSpaceType::Continuous ? 2 : actions.size();
+}
+
+} /// namespace aa
+} /// namespace calc
@@ -0,0 +1,1235 @@
+#include "calc/aa/native_inference_engine.h"
+#include "calc/aa/stereo_preprocess.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+
+namespace {
+
+// ---------------------------------------------------------------------------
+// IR XML 파싱 (IR에 필요한 태그/속성만 읽는 최소 구현)
+// ---------------------------------------------------------------------------
+
+struct XmlTag {
+    std::string name;
+    std::map<std::string, std::string> attrs;
+    bool closing = false;     // </tag>
+    bool selfClosing = false; // <tag ... />
+};
+
+std::string XmlUnescape(const std::string& value) {
+    static const std::pair<const char*, char> kEntities[] = {
+        {"&quot;", '"'}, {"&apos;", '\''}, {"&lt;", '<'}, {"&gt;", '>'}, {"&amp;", '&'}};
+    std::string result;
+    result.reserve(value.size());
+    for (size_t i = 0; i < value.size();) {
+        bool replaced = false;
+        if (value[i] == '&') {
+            for (const auto& entity : kEntities) {
+                size_t length = std::strlen(entity.first);
+                if (value.compare(i, length, entity.first) == 0) {
+                    result.push_back(entity.second);
+                    i += length;
+                    replaced = true;
+                    break;
+                }
+            }
+        }
+        if (!replaced) {
+            result.push_back(value[i++]);
+        }
+    }
+    return result;
+}
+
+XmlTag ParseTag(const std::string& content) {
+    XmlTag tag;
+    size_t pos = 0;
+    if (!content.empty() && content[0] == '/') {
+        tag.closing = true;
+        pos = 1;
+    }
+    size_t end = content.size();
+    if (end > 0 && content[end - 1] == '/') {
+        tag.selfClosing = true;
+        --end;
+    }
+
+    size_t nameEnd = content.find_first_of(" \t\r\n", pos);
+    nameEnd = std::min(nameEnd, end);
+    tag.name = content.substr(pos, nameEnd - pos);
+    pos = nameEnd;
+
+    while (pos < end) {
+        pos = content.find_first_not_of(" \t\r\n", pos);
+        if (pos == std::string::npos || pos >= end) {
+            break;
+        }
+        size_t eq = content.find('=', pos);
+        if (eq == std::string::npos || eq >= end) {
+            break;
+        }
+        std::string key = content.substr(pos, eq - pos);
+        key.erase(key.find_last_not_of(" \t\r\n") + 1);
+        size_t quote = content.find_first_of("\"'", eq + 1);
+        if (quote == std::string::npos || quote >= end) {
+            break;
+        }
+        size_t valueEnd = content.find(content[quote], quote + 1);
+        if (valueEnd == std::string::npos) {
+            break;
+        }
+        tag.attrs[key] = XmlUnescape(content.substr(quote + 1, valueEnd - quote - 1));
+        pos = valueEnd + 1;
+    }
+    return tag;
+}
+
+// "4, 4" 같은 쉼표 구분 정수 목록
+std::vector<int64_t> ParseIntList(const std::string& text) {
+    std::vector<int64_t> values;
+    std::stringstream stream(text);
+    std::string item;
+    while (std::getline(stream, item, ',')) {
+        if (item.find_first_not_of(" \t") == std::string::npos) {
+            continue;
+        }
+        values.push_back(std::stoll(item));
+    }
+    return values;
+}
+
+std::vector<size_t> ParseShape(const std::string& text) {
+    std::vector<size_t> shape;
+    for (int64_t dim : ParseIntList(text)) {
+        if (dim < 0) {
+            throw std::runtime_error("NativeInferenceEngine - dynamic shape is not supported: " + text);
+        }
+        shape.push_back(static_cast<size_t>(dim));
+    }
+    return shape;
+}
+
+std::string GetAttr(const std::map<std::string, std::string>& attrs, const std::string& key, const std::string& defaultValue = "") {
+    auto it = attrs.find(key);
+    return it == attrs.end() ? defaultValue : it->second;
+}
+
+std::string ShapeToString(const std::vector<size_t>& shape) {
+    std::string text = "[";
+    for (size_t i = 0; i < shape.size(); ++i) {
+        text += (i ? "," : "") + std::to_string(shape[i]);
+    }
+    return text + "]";
+}
+
+// ---------------------------------------------------------------------------
+// 텐서 연산
+// ---------------------------------------------------------------------------
+
+size_t ShapeSize(const std::vector<size_t>& shape) {
+    size_t size = 1;
+    for (size_t dim : shape) {
+        size *= dim;
+    }
+    return size;
+}
+
+std::vector<size_t> Strides(const std::vector<size_t>& shape) {
+    std::vector<size_t> strides(shape.size(), 1);
+    for (size_t axis = shape.size(); axis-- > 1;) {
+        strides[axis - 1] = strides[axis] * shape[axis];
+    }
+    return strides;
+}
+
+// 다차원 인덱스를 마지막 축부터 하나 증가시킨다. 끝에 도달하면 false.
+bool NextIndex(std::vector<size_t>& index, const std::vector<size_t>& shape) {
+    for (size_t axis = shape.size(); axis-- > 0;) {
+        if (++index[axis] < shape[axis]) {
+            return true;
+        }
+        index[axis] = 0;
+    }
+    return false;
+}
+
+// out[index] = in[base + sum(index[axis] * inStrides[axis])] (Transpose, StridedSlice 공용)
+void Gather(const float* in, size_t base, const std::vector<size_t>& inStrides, const std::vector<size_t>& outShape, float* out) {
+    size_t total = ShapeSize(outShape);
+    if (total == 0) {
+        return;
+    }
+    std::vector<size_t> index(outShape.size(), 0);
+    for (size_t i = 0; i < total; ++i) {
+        size_t offset = base;
+        for (size_t axis = 0; axis < index.size(); ++axis) {
+            offset += index[axis] * inStrides[axis];
+        }
+        out[i] = in[offset];
+        NextIndex(index, outShape);
+    }
+}
+
+// numpy 규칙 브로드캐스트 이항 연산 (Add, Multiply)
+template <typename Op>
+void BroadcastBinary(const std::vector<size_t>& shapeA, const float* a, const std::vector<size_t>& shapeB, const float* b,
+                     std::vector<size_t>& outShape, std::vector<float>& out, Op op) {
+    if (shapeA == shapeB) {
+        outShape = shapeA;
+        out.resize(ShapeSize(outShape));
+        for (size_t i = 0; i < out.size(); ++i) {
+            out[i] = op(a[i], b[i]);
+        }
+        return;
+    }
+
+    size_t rank = std::max(shapeA.size(), shapeB.size());
+    std::vector<size_t> dimsA(rank, 1), dimsB(rank, 1);
+    std::copy(shapeA.begin(), shapeA.end(), dimsA.begin() + (rank - shapeA.size()));
+    std::copy(shapeB.begin(), shapeB.end(), dimsB.begin() + (rank - shapeB.size()));
+
+    outShape.assign(rank, 1);
+    for (size_t axis = 0; axis < rank; ++axis) {
+        if (dimsA[axis] != dimsB[axis] && dimsA[axis] != 1 && dimsB[axis] != 1) {
+            throw std::runtime_error("NativeInferenceEngine - cannot broadcast " + ShapeToString(shapeA) + " and " + ShapeToString(shapeB));
+        }
+        outShape[axis] = std::max(dimsA[axis], dimsB[axis]);
+    }
+
+    // 브로드캐스트되는 축의 stride는 0
+    std::vector<size_t> stridesA = Strides(dimsA), stridesB = Strides(dimsB);
+    for (size_t axis = 0; axis < rank; ++axis) {
+        if (dimsA[axis] == 1) stridesA[axis] = 0;
+        if (dimsB[axis] == 1) stridesB[axis] = 0;
+    }
+
+    out.resize(ShapeSize(outShape));
+    std::vector<size_t> index(rank, 0);
+    for (size_t i = 0; i < out.size(); ++i) {
+        size_t offsetA = 0, offsetB = 0;
+        for (size_t axis = 0; axis < rank; ++axis) {
+            offsetA += index[axis] * stridesA[axis];
+            offsetB += index[axis] * stridesB[axis];
+        }
+        out[i] = op(a[offsetA], b[offsetB]);
+        NextIndex(index, outShape);
+    }
+}
+
+// NCHW 입력, OIHW 가중치의 2D 컨볼루션
+void Convolution2D(const float* in, const std::vector<size_t>& inShape, const float* weights, const std::vector<size_t>& weightShape,
+                   size_t strideY, size_t strideX, size_t dilationY, size_t dilationX, size_t padTop, size_t padLeft,
+                   const std::vector<size_t>& outShape, float* out) {
+    const size_t batch = inShape[0], inChannels = inShape[1], inH = inShape[2], inW = inShape[3];
+    const size_t outChannels = weightShape[0], kernelH = weightShape[2], kernelW = weightShape[3];
+    const size_t outH = outShape[2], outW = outShape[3];
+
+    for (size_t n = 0; n < batch; ++n) {
+        for (size_t oc = 0; oc < outChannels; ++oc) {
+            float* outPlane = out + (n * outChannels + oc) * outH * outW;
+            std::fill(outPlane, outPlane + outH * outW, 0.0f);
+            for (size_t ic = 0; ic < inChannels; ++ic) {
+                const float* inPlane = in + (n * inChannels + ic) * inH * inW;
+                const float* kernel = weights + (oc * inChannels + ic) * kernelH * kernelW;
+                for (size_t ky = 0; ky < kernelH; ++ky) {
+                    for (size_t kx = 0; kx < kernelW; ++kx) {
+                        const float w = kernel[ky * kernelW + kx];
+                        for (size_t oy = 0; oy < outH; ++oy) {
+                            // 패딩 영역은 0이므로 건너뛴다 (unsigned 연산: 음수는 큰 값이 되어 범위 검사에서 걸러진다)
+                            size_t iy = oy * strideY + ky * dilationY - padTop;
+                            if (iy >= inH) {
+                                continue;
+                            }
+                            const float* inRow = inPlane + iy * inW;
+                            float* outRow = outPlane + oy * outW;
+                            for (size_t ox = 0; ox < outW; ++ox) {
+                                size_t ix = ox * strideX + kx * dilationX - padLeft;
+                                if (ix < inW) {
+                                    outRow[ox] += w * inRow[ix];
+                                }
+                            }
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
+
+float HalfToFloat(uint16_t half) {
+    uint32_t sign = static_cast<uint32_t>(half & 0x8000) << 16;
+    uint32_t exponent = (half >> 10) & 0x1F;
+    uint32_t mantissa = half & 0x3FF;
+    uint32_t bits;
+    if (exponent == 0) {
+        if (mantissa == 0) {
+            bits = sign;
+        } else {
+            // 비정규 수: 정규화하면서 지수를 조정한다.
+            exponent = 127 - 15 + 1;
+            while ((mantissa & 0x400) == 0) {
+                mantissa <<= 1;
+                --exponent;
+            }
+            mantissa &= 0x3FF;
+            bits = sign | (exponent << 23) | (mantissa << 13);
+        }
+    } else if (exponent == 0x1F) {
+        bits = sign | 0x7F800000 | (mantissa << 13); // inf / nan
+    } else {
+        bits = sign | ((exponent + 127 - 15) << 23) | (mantissa << 13);
+    }
+    float value;
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+template <typename T>
+T ReadScalar(const char* data) {
+    T value;
+    std::memcpy(&value, data, sizeof(T));
+    return value;
+}
+
+// 음수 축/인덱스를 [0, size] 범위로 정규화
+int64_t NormalizeIndex(int64_t index, int64_t size) {
+    if (index < 0) {
+        index += size;
+    }
+    return std::max<int64_t>(0, std::min(index, size));
+}
+
+} // namespace
+
+NativeInferenceEngine::NativeInferenceEngine(const std::string& modelPath, const InferenceOptions& options, bool shallowKernels)
+    : opts(options), allowShallow(shallowKernels) {
+    if (opts.batch == 0) {
+        throw std::invalid_argument("NativeInferenceEngine - batch must be at least 1");
+    }
+    if (opts.profiling) {
+        profiler = std::make_unique<calc::aa::LayerProfiler>(opts.profileWindow);
+    }
+    loadModel(modelPath);
+}
+
+NativeInferenceEngine::~NativeInferenceEngine() {
+    stopAsync();
+}
+
+std::string NativeInferenceEngine::name() const {
+    return allowShallow ? "native" : "native-generic";
+}
+
+bool NativeInferenceEngine::usesShallowKernels() const {
+    return shallow != nullptr;
+}
+
+const InferenceOptions& NativeInferenceEngine::options() const {
+    return opts;
+}
+
+double NativeInferenceEngine::loadTimeMs() const {
+    return loadMs;
+}
+
+void NativeInferenceEngine::loadModel(const std::string& modelPath) {
+    auto start = std::chrono::steady_clock::now();
+
+    std::ifstream xmlFile(modelPath);
+    if (!xmlFile) {
+        throw std::runtime_error("NativeInferenceEngine - cannot read " + modelPath);
+    }
+    std::stringstream xml;
+    xml << xmlFile.rdbuf();
+
+    parseXml(xml.str());
+    sortNodes();
+
+    std::filesystem::path weightsPath(modelPath);
+    weightsPath.replace_extension(".bin");
+    loadConstants(weightsPath.string());
+
+    // 입력 Blob: 좌/우 평면 프레임을 (1, 120, 160, 2) float로 인터리브해 기록한다.
+    const Node& parameter = nodes[parameterIndex];
+    if (ShapeSize(parameter.outputShape) != calc::aa::kStereoFrameSize) {
+        throw std::runtime_error("NativeInferenceEngine - unexpected input shape " + ShapeToString(parameter.outputShape));
+    }
+    values[parameterIndex].shape = parameter.outputShape;
+    values[parameterIndex].data.assign(calc::aa::kStereoFrameSize, 0.0f);
+    inputBuffer.assign(opts.batch * calc::aa::kStereoFrameSize, 0.0f);
+
+    // 0 입력으로 한 번 실행해 중간 버퍼를 미리 할당하고, 계산된 shape가 IR에 기록된 shape와 같은지 확인한다.
+    for (size_t index : program) {
+        evaluate(index);
+        if (values[index].shape != nodes[index].outputShape) {
+            throw std::runtime_error("NativeInferenceEngine - shape mismatch at " + nodes[index].name + ": computed "
+                                     + ShapeToString(values[index].shape) + ", IR " + ShapeToString(nodes[index].outputShape));
+        }
+    }
+
+    // 특화 커널이 가중치를 자체 배치로 복사하므로, 일반 연산용 텐서는 입력 버퍼만 남기고 해제한다.
+    if (allowShallow && bindShallowNetwork()) {
+        for (size_t i = 0; i < values.size(); ++i) {
+            if (i != parameterIndex) {
+                values[i] = Tensor();
+            }
+        }
+    }
+
+    loadMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+void NativeInferenceEngine::parseXml(const std::string& xml) {
+    struct Edge {
+        int fromLayer;
+        int toLayer;
+        int toPort;
+    };
+    std::vector<Edge> edges;
+    std::map<int, std::vector<int>> inputPortIds; // 레이어 id -> 입력 포트 id (IR 순서)
+
+    Node node;
+    bool inLayer = false;
+    std::string section;       // "input" / "output"
+    bool inPort = false;
+    int portId = -1;
+    std::vector<size_t> portShape;
+    size_t outputPorts = 0;
+
+    size_t pos = 0;
+    while ((pos = xml.find('<', pos)) != std::string::npos) {
+        if (xml.compare(pos, 4, "<!--") == 0) {
+            size_t end = xml.find("-->", pos);
+            pos = (end == std::string::npos) ? xml.size() : end + 3;
+            continue;
+        }
+        if (xml.compare(pos, 2, "<?") == 0) {
+            size_t end = xml.find("?>", pos);
+            pos = (end == std::string::npos) ? xml.size() : end + 2;
+            continue;
+        }
+        size_t end = xml.find('>', pos);
+        if (end == std::string::npos) {
+            throw std::runtime_error("NativeInferenceEngine - malformed IR xml");
+        }
+        XmlTag tag = ParseTag(xml.substr(pos + 1, end - pos - 1));
+        pos = end + 1;
+
+        if (tag.name == "layer") {
+            if (tag.closing) {
+                nodes.push_back(node);
+                inLayer = false;
+            } else {
+                node = Node();
+                outputPorts = 0;
+                node.id = std::stoi(GetAttr(tag.attrs, "id", "-1"));
+                node.name = GetAttr(tag.attrs, "name");
+                node.type = GetAttr(tag.attrs, "type");
+                inLayer = true;
+            }
+        } else if (tag.name == "edge" && !tag.closing) {
+            edges.push_back({std::stoi(GetAttr(tag.attrs, "from-layer")), std::stoi(GetAttr(tag.attrs, "to-layer")),
+                             std::stoi(GetAttr(tag.attrs, "to-port"))});
+        } else if (!inLayer) {
+            continue;
+        } else if (tag.name == "data" && !tag.closing) {
+            node.attrs = tag.attrs;
+        } else if (tag.name == "input" || tag.name == "output") {
+            section = tag.closing ? "" : tag.name;
+        } else if (tag.name == "port" && !section.empty()) {
+            if (!tag.closing) {
+                inPort = true;
+                portId = std::stoi(GetAttr(tag.attrs, "id", "-1"));
+                portShape.clear();
+            }
+            if (tag.closing || tag.selfClosing) {
+                if (section == "input") {
+                    inputPortIds[node.id].push_back(portId);
+                    node.inputShapes.push_back(portShape);
+                } else {
+                    if (++outputPorts > 1) {
+                        throw std::runtime_error("NativeInferenceEngine - multiple outputs are not supported: " + node.name);
+                    }
+                    node.outputShape = portShape;
+                }
+                inPort = false;
+            }
+        } else if (tag.name == "dim" && !tag.closing && inPort) {
+            size_t textEnd = xml.find('<', pos);
+            portShape.push_back(static_cast<size_t>(std::stoll(xml.substr(pos, textEnd - pos))));
+        }
+    }
+
+    if (nodes.empty()) {
+        throw std::runtime_error("NativeInferenceEngine - no layers in IR");
+    }
+
+    // 엣지를 입력 포트 순서대로 노드 인덱스에 연결한다.
+    std::map<int, size_t> indexById;
+    for (size_t i = 0; i < nodes.size(); ++i) {
+        indexById[nodes[i].id] = i;
+    }
+    for (auto& n : nodes) {
+        n.inputs.assign(n.inputShapes.size(), SIZE_MAX);
+    }
+    for (const auto& edge : edges) {
+        auto from = indexById.find(edge.fromLayer);
+        auto to = indexById.find(edge.toLayer);
+        if (from == indexById.end() || to == indexById.end()) {
+            throw std::runtime_error("NativeInferenceEngine - edge refers to unknown layer");
+        }
+        const auto& ports = inputPortIds[edge.toLayer];
+        auto port = std::find(ports.begin(), ports.end(), edge.toPort);
+        if (port == ports.end()) {
+            throw std::runtime_error("NativeInferenceEngine - edge refers to unknown port of " + nodes[to->second].name);
+        }
+        nodes[to->second].inputs[port - ports.begin()] = from->second;
+    }
+    for (const auto& n : nodes) {
+        if (std::find(n.inputs.begin(), n.inputs.end(), SIZE_MAX) != n.inputs.end()) {
+            throw std::runtime_error("NativeInferenceEngine - unconnected input of " + n.name);
+        }
+    }
+}
+
+void NativeInferenceEngine::sortNodes() {
+    // Kahn 알고리즘으로 실행 순서를 정한다.
+    const size_t count = nodes.size();
+    std::vector<size_t> pending(count, 0);
+    std::vector<std::vector<size_t>> consumers(count);
+    for (size_t i = 0; i < count; ++i) {
+        pending[i] = nodes[i].inputs.size();
+        for (size_t input : nodes[i].inputs) {
+            consumers[input].push_back(i);
+        }
+    }
+
+    std::vector<size_t> order;
+    for (size_t i = 0; i < count; ++i) {
+        if (pending[i] == 0) {
+            order.push_back(i);
+        }
+    }
+    for (size_t head = 0; head < order.size(); ++head) {
+        for (size_t consumer : consumers[order[head]]) {
+            if (--pending[consumer] == 0) {
+                order.push_back(consumer);
+            }
+        }
+    }
+    if (order.size() != count) {
+        throw std::runtime_error("NativeInferenceEngine - IR graph has a cycle");
+    }
+
+    std::vector<size_t> newIndex(count);
+    for (size_t i = 0; i < count; ++i) {
+        newIndex[order[i]] = i;
+    }
+    std::vector<Node> sorted;
+    sorted.reserve(count);
+    for (size_t oldIndex : order) {
+        sorted.push_back(std::move(nodes[oldIndex]));
+        for (auto& input : sorted.back().inputs) {
+            input = newIndex[input];
+        }
+    }
+    nodes = std::move(sorted);
+
+    static const char* kSupported[] = {"Parameter", "Const", "Convert", "Transpose", "Convolution", "Add", "Multiply",
+                                       "ReLU", "Reshape", "MatMul", "Unsqueeze", "StridedSlice", "Result"};
+    size_t parameters = 0, results = 0;
+    for (size_t i = 0; i < count; ++i) {
+        const std::string& type = nodes[i].type;
+        if (std::find(std::begin(kSupported), std::end(kSupported), type) == std::end(kSupported)) {
+            throw std::runtime_error("NativeInferenceEngine - unsupported layer type " + type + " (" + nodes[i].name + ")");
+        }
+        if (type == "Parameter") {
+            parameterIndex = i;
+            ++parameters;
+        } else if (type == "Result") {
+            resultIndex = i;
+            ++results;
+        }
+    }
+    if (parameters != 1 || results != 1) {
+        throw std::runtime_error("NativeInferenceEngine - exactly one Parameter and one Result are required");
+    }
+}
+
+void NativeInferenceEngine::loadConstants(const std::string& weightsPath) {
+    std::ifstream file(weightsPath, std::ios::binary);
+    if (!file) {
+        throw std::runtime_error("NativeInferenceEngine - cannot read " + weightsPath);
+    }
+    std::vector<char> weights((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+    values.assign(nodes.size(), Tensor());
+    program.clear();
+
+    for (size_t i = 0; i < nodes.size(); ++i) {
+        Node& node = nodes[i];
+        if (node.type == "Const") {
+            Tensor& tensor = values[i];
+            tensor.shape = ParseShape(GetAttr(node.attrs, "shape"));
+            const std::string elementType = GetAttr(node.attrs, "element_type");
+            const size_t offset = std::stoull(GetAttr(node.attrs, "offset", "0"));
+            const size_t size = std::stoull(GetAttr(node.attrs, "size", "0"));
+            const size_t count = ShapeSize(tensor.shape);
+
+            size_t elementSize = 0;
+            if (elementType == "f32" || elementType == "i32") {
+                elementSize = 4;
+            } else if (elementType == "f16") {
+                elementSize = 2;
+            } else if (elementType == "i64") {
+                elementSize = 8;
+            } else {
+                throw std::runtime_error("NativeInferenceEngine - unsupported constant type " + elementType + " (" + node.name + ")");
+            }
+            if (size != count * elementSize || offset + size > weights.size()) {
+                throw std::runtime_error("NativeInferenceEngine - constant out of range in " + weightsPath + " (" + node.name + ")");
+            }
+
+            const char* data = weights.data() + offset;
+            if (elementType == "f32" || elementType == "f16") {
+                tensor.data.resize(count);
+                for (size_t k = 0; k < count; ++k) {
+                    tensor.data[k] = (elementType == "f32") ? ReadScalar<float>(data + k * 4)
+                                                            : HalfToFloat(ReadScalar<uint16_t>(data + k * 2));
+                }
+            } else {
+                tensor.integer = true;
+                tensor.ints.resize(count);
+                for (size_t k = 0; k < count; ++k) {
+                    tensor.ints[k] = (elementType == "i64") ? ReadScalar<int64_t>(data + k * 8)
+                                                            : ReadScalar<int32_t>(data + k * 4);
+                }
+            }
+            node.constant = true;
+            continue;
+        }
+        if (node.type == "Parameter" || node.type == "Result") {
+            continue;
+        }
+
+        // 입력이 모두 상수인 노드(가중치 Convert 등)는 로드 시 한 번만 계산한다.
+        node.constant = std::all_of(node.inputs.begin(), node.inputs.end(), [this](size_t input) { return nodes[input].constant; });
+        if (node.constant) {
+            evaluate(i);
+        } else {
+            program.push_back(i);
+        }
+    }
+
+    // 상수 노드만 사용하는 중간 상수(f16 원본 등)는 더 이상 필요 없으므로 메모리를 반환한다.
+    std::vector<bool> needed(nodes.size(), false);
+    for (size_t i = 0; i < nodes.size(); ++i) {
+        if (!nodes[i].constant) {
+            for (size_t input : nodes[i].inputs) {
+                needed[input] = true;
+            }
+        }
+    }
+    for (size_t i = 0; i < nodes.size(); ++i) {
+        if (nodes[i].constant && !needed[i]) {
+            values[i] = Tensor();
+        }
+    }
+}
+
+bool NativeInferenceEngine::bindShallowNetwork() {
+    using calc::aa::ShallowNetwork;
+
+    // 상수가 아닌 노드의 실행 순서가 saved_model.xml의 체인과 같아야 한다.
+    static const char* kPattern[] = {"Transpose", "Convolution", "Add", "ReLU", "Convolution", "Add", "ReLU",
+                                     "Convolution", "Add", "ReLU", "Transpose", "Reshape", "MatMul", "Add", "ReLU",
+                                     "Unsqueeze", "Multiply", "Add", "StridedSlice", "MatMul", "Add"};
+    constexpr size_t kSteps = sizeof(kPattern) / sizeof(kPattern[0]);
+    if (program.size() != kSteps || nodes[resultIndex].inputs.at(0) != program.back()) {
+        return false;
+    }
+    for (size_t step = 0; step < kSteps; ++step) {
+        if (nodes[program[step]].type != kPattern[step]) {
+            return false;
+        }
+    }
+
+    auto step = [&](size_t i) -> const Node& { return nodes[program[i]]; };
+    // step i의 port 입력이 step from의 출력인지 (from == kSteps면 Parameter)
+    auto fedBy = [&](size_t i, size_t port, size_t from) {
+        size_t source = (from == kSteps) ? parameterIndex : program[from];
+        return step(i).inputs.size() > port && step(i).inputs[port] == source;
+    };
+    auto constant = [&](size_t i, size_t port, const std::vector<size_t>& shape) -> const Tensor* {
+        if (step(i).inputs.size() <= port) {
+            return nullptr;
+        }
+        size_t input = step(i).inputs[port];
+        return (nodes[input].constant && values[input].shape == shape) ? &values[input] : nullptr;
+    };
+    auto floats = [&](size_t i, size_t port, const std::vector<size_t>& shape) -> const float* {
+        const Tensor* tensor = constant(i, port, shape);
+        return (tensor && !tensor->integer) ? tensor->data.data() : nullptr;
+    };
+    auto order = [&](size_t i, const std::vector<int64_t>& expected) {
+        const Tensor* tensor = constant(i, 1, {expected.size()});
+        return tensor && tensor->integer && tensor->ints == expected;
+    };
+    auto convolution = [&](size_t i, size_t outC, size_t inC, size_t k, size_t stride) -> const float* {
+        const Node& node = step(i);
+        const std::string strides = std::to_string(stride) + ", " + std::to_string(stride);
+        if (GetAttr(node.attrs, "strides") != strides || GetAttr(node.attrs, "dilations", "1, 1") != "1, 1") {
+            return nullptr;
+        }
+        const std::string autoPad = GetAttr(node.attrs, "auto_pad", "explicit");
+        const bool noPadding = GetAttr(node.attrs, "pads_begin", "0, 0") == "0, 0" && GetAttr(node.attrs, "pads_end", "0, 0") == "0, 0";
+        if (autoPad != "valid" && !((autoPad == "explicit" || autoPad == "notset") && noPadding)) {
+            return nullptr;
+        }
+        return fedBy(i, 0, i - 1) ? floats(i, 1, {outC, inC, k, k}) : nullptr;
+    };
+    auto matmul = [&](size_t i, size_t out, size_t in) -> const float* {
+        const Node& node = step(i);
+        if (GetAttr(node.attrs, "transpose_a") == "true" || GetAttr(node.attrs, "transpose_b") != "true") {
+            return nullptr;
+        }
+        return floats(i, 1, {out, in});
+    };
+    auto biasRelu = [&](size_t addStep, const std::vector<size_t>& shape) -> const float* {
+        return (fedBy(addStep, 0, addStep - 1) && fedBy(addStep + 1, 0, addStep)) ? floats(addStep, 1, shape) : nullptr;
+    };
+
+    using Conv1 = ShallowNetwork::Conv1;
+    using Conv2 = ShallowNetwork::Conv2;
+    using Conv3 = ShallowNetwork::Conv3;
+    using Dense = ShallowNetwork::Dense;
+    using Head = ShallowNetwork::Head;
+
+    if (nodes[parameterIndex].outputShape != std::vector<size_t>{1, 120, 160, 2} || !fedBy(0, 0, kSteps) || !order(0, {0, 3, 1, 2})) {
+        return false;
+    }
+
+    ShallowNetwork::Weights weights{};
+    weights.conv1 = convolution(1, Conv1::kOutChannels, 2, 8, 4);
+    weights.conv1Bias = biasRelu(2, {1, Conv1::kOutChannels, 1, 1});
+    weights.conv2 = convolution(4, Conv2::kOutChannels, Conv1::kOutChannels, 4, 2);
+    weights.conv2Bias = biasRelu(5, {1, Conv2::kOutChannels, 1, 1});
+    weights.conv3 = convolution(7, Conv3::kOutChannels, Conv2::kOutChannels, 3, 1);
+    weights.conv3Bias = biasRelu(8, {1, Conv3::kOutChannels, 1, 1});
+    if (!weights.conv1 || !weights.conv1Bias || !weights.conv2 || !weights.conv2Bias || !weights.conv3 || !weights.conv3Bias
+        || step(9).outputShape != std::vector<size_t>{1, Conv3::kOutChannels, Conv3::kOutH, Conv3::kOutW}) {
+        return false;
+    }
+
+    // NCHW -> NHWC Transpose 후 평탄화: 특화 커널의 HWC 배치와 같은 순서
+    if (!fedBy(10, 0, 9) || !order(10, {0, 2, 3, 1}) || !fedBy(11, 0, 10)
+        || step(11).outputShape != std::vector<size_t>{1, Dense::kInputSize} || !fedBy(12, 0, 11)) {
+        return false;
+    }
+    weights.dense = matmul(12, Dense::kOutputSize, Dense::kInputSize);
+    weights.denseBias = biasRelu(13, {1, Dense::kOutputSize});
+
+    // Unsqueeze -> x * scale + x -> StridedSlice: 크기 1 축을 추가했다 제거하므로 데이터는 그대로다.
+    const Node& multiply = step(16);
+    const Node& residual = step(17);
+    size_t scaleInput = (multiply.inputs.size() == 2 && multiply.inputs[1] == program[15]) ? 0 : 1;
+    const Tensor* scale = (multiply.inputs.size() == 2) ? &values[multiply.inputs[scaleInput]] : nullptr;
+    bool residualOk = residual.inputs.size() == 2
+                      && ((residual.inputs[0] == program[16] && residual.inputs[1] == program[15])
+                          || (residual.inputs[0] == program[15] && residual.inputs[1] == program[16]));
+    if (!weights.dense || !weights.denseBias || !fedBy(15, 0, 14)
+        || step(15).outputShape != std::vector<size_t>{1, 1, Dense::kOutputSize}
+        || multiply.inputs.size() != 2 || multiply.inputs[1 - scaleInput] != program[15]
+        || !nodes[multiply.inputs[scaleInput]].constant || scale->integer || scale->data.size() != 1 || !residualOk
+        || !fedBy(18, 0, 17) || step(18).outputShape != std::vector<size_t>{1, Dense::kOutputSize} || !fedBy(19, 0, 18)) {
+        return false;
+    }
+    weights.residualScale = scale->data[0];
+
+    weights.head = matmul(19, Head::kOutputSize, Head::kInputSize);
+    weights.headBias = fedBy(20, 0, 19) ? floats(20, 1, {1, Head::kOutputSize}) : nullptr;
+    if (!weights.head || !weights.headBias) {
+        return false;
+    }
+
+    shallow = std::make_unique<ShallowNetwork>(weights);
+    return true;
+}
+
+void NativeInferenceEngine::evaluate(size_t index) {
+    const Node& node = nodes[index];
+    Tensor& out = values[index];
+    auto input = [&](size_t port) -> const Tensor& {
+        if (port >= node.inputs.size()) {
+            throw std::runtime_error("NativeInferenceEngine - missing input of " + node.name);
+        }
+        return values[node.inputs[port]];
+    };
+    auto requireFloat = [&](const Tensor& tensor) {
+        if (tensor.integer) {
+            throw std::runtime_error("NativeInferenceEngine - integer tensor is not supported by " + node.type + " (" + node.name + ")");
+        }
+    };
+    const std::string& type = node.type;
+
+    if (type == "Convert") {
+        const Tensor& in = input(0);
+        const std::string destination = GetAttr(node.attrs, "destination_type");
+        out.shape = in.shape;
+        if (destination == "f32" || destination == "f16") {
+            out.integer = false;
+            if (in.integer) {
+                out.data.assign(in.ints.begin(), in.ints.end());
+            } else {
+                out.data = in.data;
+            }
+        } else if (destination == "i64" || destination == "i32") {
+            out.integer = true;
+            if (in.integer) {
+                out.ints = in.ints;
+            } else {
+                out.ints.resize(in.data.size());
+                for (size_t i = 0; i < in.data.size(); ++i) {
+                    out.ints[i] = static_cast<int64_t>(in.data[i]);
+                }
+            }
+        } else {
+            throw std::runtime_error("NativeInferenceEngine - unsupported Convert destination " + destination);
+        }
+    } else if (type == "ReLU") {
+        const Tensor& in = input(0);
+        requireFloat(in);
+        out.shape = in.shape;
+        out.data.resize(in.data.size());
+        for (size_t i = 0; i < in.data.size(); ++i) {
+            out.data[i] = std::max(0.0f, in.data[i]);
+        }
+    } else if (type == "Add" || type == "Multiply") {
+        const Tensor& a = input(0);
+        const Tensor& b = input(1);
+        requireFloat(a);
+        requireFloat(b);
+        if (GetAttr(node.attrs, "auto_broadcast", "numpy") != "numpy") {
+            throw std::runtime_error("NativeInferenceEngine - unsupported auto_broadcast in " + node.name);
+        }
+        if (type == "Add") {
+            BroadcastBinary(a.shape, a.data.data(), b.shape, b.data.data(), out.shape, out.data, [](float x, float y) { return x + y; });
+        } else {
+            BroadcastBinary(a.shape, a.data.data(), b.shape, b.data.data(), out.shape, out.data, [](float x, float y) { return x * y; });
+        }
+    } else if (type == "Transpose") {
+        const Tensor& in = input(0);
+        const Tensor& order = input(1);
+        requireFloat(in);
+        const size_t rank = in.shape.size();
+        if (order.ints.size() != rank) {
+            throw std::runtime_error("NativeInferenceEngine - invalid Transpose order in " + node.name);
+        }
+        std::vector<size_t> inStrides = Strides(in.shape);
+        std::vector<size_t> strides(rank);
+        out.shape.resize(rank);
+        for (size_t axis = 0; axis < rank; ++axis) {
+            size_t from = static_cast<size_t>(NormalizeIndex(order.ints[axis], static_cast<int64_t>(rank)));
+            out.shape[axis] = in.shape.at(from);
+            strides[axis] = inStrides[from];
+        }
+        out.data.resize(in.data.size());
+        Gather(in.data.data(), 0, strides, out.shape, out.data.data());
+    } else if (type == "Reshape") {
+        const Tensor& in = input(0);
+        const Tensor& target = input(1);
+        const bool specialZero = GetAttr(node.attrs, "special_zero") == "true";
+        out.shape.assign(target.ints.size(), 1);
+        size_t known = 1;
+        size_t inferAxis = SIZE_MAX;
+        for (size_t axis = 0; axis < target.ints.size(); ++axis) {
+            int64_t dim = target.ints[axis];
+            if (dim == -1) {
+                inferAxis = axis;
+                continue;
+            }
+            out.shape[axis] = (dim == 0 && specialZero) ? in.shape.at(axis) : static_cast<size_t>(dim);
+            known *= out.shape[axis];
+        }
+        const size_t total = in.integer ? in.ints.size() : in.data.size();
+        if (inferAxis != SIZE_MAX) {
+            out.shape[inferAxis] = known ? total / known : 0;
+        }
+        if (ShapeSize(out.shape) != total) {
+            throw std::runtime_error("NativeInferenceEngine - invalid Reshape target in " + node.name);
+        }
+        out.integer = in.integer;
+        out.data = in.data;
+        out.ints = in.ints;
+    } else if (type == "Unsqueeze") {
+        const Tensor& in = input(0);
+        const Tensor& axesTensor = input(1);
+        const int64_t outRank = static_cast<int64_t>(in.shape.size() + axesTensor.ints.size());
+        std::vector<int64_t> axes;
+        for (int64_t axis : axesTensor.ints) {
+            axes.push_back(axis < 0 ? axis + outRank : axis);
+        }
+        std::sort(axes.begin(), axes.end());
+        out.shape = in.shape;
+        for (int64_t axis : axes) {
+            if (axis < 0 || axis > static_cast<int64_t>(out.shape.size())) {
+                throw std::runtime_error("NativeInferenceEngine - invalid Unsqueeze axis in " + node.name);
+            }
+            out.shape.insert(out.shape.begin() + axis, 1);
+        }
+        out.integer = in.integer;
+        out.data = in.data;
+        out.ints = in.ints;
+    } else if (type == "StridedSlice") {
+        const Tensor& in = input(0);
+        const Tensor& begin = input(1);
+        const Tensor& end = input(2);
+        requireFloat(in);
+        std::vector<int64_t> stride(begin.ints.size(), 1);
+        if (node.inputs.size() > 3) {
+            stride = input(3).ints;
+        }
+        auto mask = [&](const char* key) {
+            std::vector<int64_t> bits = ParseIntList(GetAttr(node.attrs, key, "0"));
+            bits.resize(in.shape.size(), 0);
+            return bits;
+        };
+        std::vector<int64_t> beginMask = mask("begin_mask"), endMask = mask("end_mask"), shrinkMask = mask("shrink_axis_mask");
+        for (int64_t bit : mask("new_axis_mask")) {
+            if (bit) throw std::runtime_error("NativeInferenceEngine - new_axis_mask is not supported in " + node.name);
+        }
+        for (int64_t bit : mask("ellipsis_mask")) {
+            if (bit) throw std::runtime_error("NativeInferenceEngine - ellipsis_mask is not supported in " + node.name);
+        }
+
+        std::vector<size_t> inStrides = Strides(in.shape);
+        std::vector<size_t> strides;
+        size_t base = 0;
+        out.shape.clear();
+        for (size_t axis = 0; axis < in.shape.size(); ++axis) {
+            const int64_t dim = static_cast<int64_t>(in.shape[axis]);
+            if (axis >= begin.ints.size()) {
+                out.shape.push_back(in.shape[axis]);
+                strides.push_back(inStrides[axis]);
+                continue;
+            }
+            if (stride[axis] <= 0) {
+                throw std::runtime_error("NativeInferenceEngine - only positive StridedSlice strides are supported in " + node.name);
+            }
+            int64_t first = beginMask[axis] ? 0 : NormalizeIndex(begin.ints[axis], dim);
+            if (shrinkMask[axis]) {
+                if (first >= dim) {
+                    throw std::runtime_error("NativeInferenceEngine - StridedSlice index out of range in " + node.name);
+                }
+                base += static_cast<size_t>(first) * inStrides[axis];
+                continue;
+            }
+            int64_t last = endMask[axis] ? dim : NormalizeIndex(end.ints[axis], dim);
+            int64_t length = (last > first) ? (last - first + stride[axis] - 1) / stride[axis] : 0;
+            base += static_cast<size_t>(first) * inStrides[axis];
+            out.shape.push_back(static_cast<size_t>(length));
+            strides.push_back(inStrides[axis] * static_cast<size_t>(stride[axis]));
+        }
+        out.data.resize(ShapeSize(out.shape));
+        Gather(in.data.data(), base, strides, out.shape, out.data.data());
+    } else if (type == "Convolution") {
+        const Tensor& in = input(0);
+        const Tensor& weights = input(1);
+        requireFloat(in);
+        requireFloat(weights);
+        if (in.shape.size() != 4 || weights.shape.size() != 4 || weights.shape[1] != in.shape[1]) {
+            throw std::runtime_error("NativeInferenceEngine - only 2D NCHW Convolution is supported in " + node.name);
+        }
+        std::vector<int64_t> strides = ParseIntList(GetAttr(node.attrs, "strides", "1, 1"));
+        std::vector<int64_t> dilations = ParseIntList(GetAttr(node.attrs, "dilations", "1, 1"));
+        std::vector<int64_t> padsBegin = ParseIntList(GetAttr(node.attrs, "pads_begin", "0, 0"));
+        std::vector<int64_t> padsEnd = ParseIntList(GetAttr(node.attrs, "pads_end", "0, 0"));
+        const std::string autoPad = GetAttr(node.attrs, "auto_pad", "explicit");
+        if (strides.size() != 2 || dilations.size() != 2 || padsBegin.size() != 2 || padsEnd.size() != 2) {
+            throw std::runtime_error("NativeInferenceEngine - invalid Convolution attributes in " + node.name);
+        }
+
+        std::vector<size_t> pads(4, 0); // top, left, bottom, right
+        for (size_t axis = 0; axis < 2; ++axis) {
+            const size_t inSize = in.shape[2 + axis];
+            const size_t effectiveKernel = static_cast<size_t>(dilations[axis]) * (weights.shape[2 + axis] - 1) + 1;
+            if (autoPad == "valid") {
+                continue;
+            }
+            if (autoPad == "same_upper" || autoPad == "same_lower") {
+                const size_t outSize = (inSize + strides[axis] - 1) / strides[axis];
+                const size_t needed = (outSize - 1) * strides[axis] + effectiveKernel;
+                const size_t total = needed > inSize ? needed - inSize : 0;
+                const size_t small = total / 2;
+                pads[axis] = (autoPad == "same_upper") ? small : total - small;
+                pads[axis + 2] = total - pads[axis];
+            } else {
+                pads[axis] = static_cast<size_t>(padsBegin[axis]);
+                pads[axis + 2] = static_cast<size_t>(padsEnd[axis]);
+            }
+        }
+
+        out.shape = {in.shape[0], weights.shape[0], 0, 0};
+        for (size_t axis = 0; axis < 2; ++axis) {
+            const size_t padded = in.shape[2 + axis] + pads[axis] + pads[axis + 2];
+            const size_t effectiveKernel = static_cast<size_t>(dilations[axis]) * (weights.shape[2 + axis] - 1) + 1;
+            if (padded < effectiveKernel) {
+                throw std::runtime_error("NativeInferenceEngine - Convolution kernel larger than input in " + node.name);
+            }
+            out.shape[2 + axis] = (padded - effectiveKernel) / static_cast<size_t>(strides[axis]) + 1;
+        }
+        out.data.resize(ShapeSize(out.shape));
+        Convolution2D(in.data.data(), in.shape, weights.data.data(), weights.shape,
+                      static_cast<size_t>(strides[0]), static_cast<size_t>(strides[1]),
+                      static_cast<size_t>(dilations[0]), static_cast<size_t>(dilations[1]), pads[0], pads[1],
+                      out.shape, out.data.data());
+    } else if (type == "MatMul") {
+        const Tensor& a = input(0);
+        const Tensor& b = input(1);
+        requireFloat(a);
+        requireFloat(b);
+        if (a.shape.size() != 2 || b.shape.size() != 2) {
+            throw std::runtime_error("NativeInferenceEngine - only 2D MatMul is supported in " + node.name);
+        }
+        const bool transposeA = GetAttr(node.attrs, "transpose_a") == "true";
+        const bool transposeB = GetAttr(node.attrs, "transpose_b") == "true";
+        const size_t m = transposeA ? a.shape[1] : a.shape[0];
+        const size_t k = transposeA ? a.shape[0] : a.shape[1];
+        const size_t n = transposeB ? b.shape[0] : b.shape[1];
+        if ((transposeB ? b.shape[1] : b.shape[0]) != k) {
+            throw std::runtime_error("NativeInferenceEngine - MatMul inner dimension mismatch in " + node.name);
+        }
+        out.shape = {m, n};
+        out.data.resize(m * n);
+        for (size_t row = 0; row < m; ++row) {
+            for (size_t col = 0; col < n; ++col) {
+                float sum = 0.0f;
+                for (size_t i = 0; i < k; ++i) {
+                    const float x = transposeA ? a.data[i * m + row] : a.data[row * k + i];
+                    const float y = transposeB ? b.data[col * k + i] : b.data[i * n + col];
+                    sum += x * y;
+                }
+                out.data[row * n + col] = sum;
+            }
+        }
+    } else {
+        throw std::runtime_error("NativeInferenceEngine - cannot evaluate " + type + " (" + node.name + ")");
+    }
+}
+
+void NativeInferenceEngine::checkFrames(const std::vector<uint8_t>& inputData) const {
+    if (inputData.size() != opts.batch * calc::aa::kStereoFrameSize) {
+        throw std::invalid_argument("NativeInferenceEngine - unexpected frame size " + std::to_string(inputData.size()));
+    }
+}
+
+void NativeInferenceEngine::interleaveFrames(const uint8_t* frames, float* input) const {
+    // 입력 정밀도(FP32/U8)와 관계없이 uint8 프레임을 바로 float로 인터리브한다 (U8 모드의 네트워크 내 정규화와 같은 결과).
+    for (size_t i = 0; i < opts.batch; ++i) {
+        const uint8_t* left = frames + i * calc::aa::kStereoFrameSize;
+        const uint8_t* right = left + calc::aa::kStereoPlaneSize;
+        calc::aa::InterleaveStereoToFloat(left, right, input + i * calc::aa::kStereoFrameSize, calc::aa::kStereoPlaneSize,
+                                          opts.inputScale, opts.inputOffset);
+    }
+}
+
+void NativeInferenceEngine::inferShallow(const float* input, std::vector<float>& output, calc::aa::ShallowNetwork::Workspace& ws) const {
+    using calc::aa::ShallowNetwork;
+    output.resize(opts.batch * ShallowNetwork::kOutputSize);
+    for (size_t i = 0; i < opts.batch; ++i) {
+        shallow->Forward(input + i * ShallowNetwork::kInputSize, output.data() + i * ShallowNetwork::kOutputSize, ws);
+    }
+}
+
+void NativeInferenceEngine::setInputData(const std::vector<uint8_t>& inputData) {
+    checkFrames(inputData);
+    if (!profiler) {
+        interleaveFrames(inputData.data(), inputBuffer.data());
+        return;
+    }
+    auto start = std::chrono::steady_clock::now();
+    interleaveFrames(inputData.data(), inputBuffer.data());
+    syncFillUs = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+}
+
+std::vector<float> NativeInferenceEngine::runInference() {
+    std::vector<float> output;
+    runInferenceInto(output);
+    return output;
+}
+
+void NativeInferenceEngine::runInferenceInto(std::vector<float>& output) {
+    if (shallow) {
+        if (!profiler) {
+            inferShallow(inputBuffer.data(), output, workspace);
+            return;
+        }
+        auto start = std::chrono::steady_clock::now();
+        inferShallow(inputBuffer.data(), output, workspace);
+        recordShallowProfile(syncFillUs, std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count());
+        return;
+    }
+
+    output.clear();
+    if (profiler) {
+        nodeUs.assign(nodes.size(), 0.0);
+    }
+    std::vector<float>& parameter = values[parameterIndex].data;
+    for (size_t i = 0; i < opts.batch; ++i) {
+        const float* frame = inputBuffer.data() + i * calc::aa::kStereoFrameSize;
+        std::copy(frame, frame + calc::aa::kStereoFrameSize, parameter.begin());
+        for (size_t index : program) {
+            if (!profiler) {
+                evaluate(index);
+                continue;
+            }
+            auto start = std::chrono::steady_clock::now();
+            evaluate(index);
+            nodeUs[index] += std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+        }
+        const std::vector<float>& result = values[nodes[resultIndex].inputs.at(0)].data;
+        output.insert(output.end(), result.begin(), result.end());
+    }
+
+    if (profiler) {
+        std::vector<calc::aa::LayerSample> layers;
+        layers.push_back({"<input preprocess>", "Preprocess", calc::aa::StereoPreprocessIsa(), syncFillUs});
+        for (size_t index : program) {
+            layers.push_back({nodes[index].name, nodes[index].type, "native-generic", nodeUs[index]});
+        }
+        profiler->Record(layers);
+    }
+}
+
+void NativeInferenceEngine::recordShallowProfile(double fillUs, double forwardUs) const {
+    profiler->Record({{"<input preprocess>", "Preprocess", calc::aa::StereoPreprocessIsa(), fillUs},
+                      {"shallow network (fused)", "ShallowNetwork", calc::aa::ShallowNetwork::Isa(), forwardUs}});
+}
+
+std::vector<InferenceBackend::LayerTiming> NativeInferenceEngine::layerProfile() const {
+    return profiler ? profiler->Snapshot() : std::vector<LayerTiming>();
+}
+
+void NativeInferenceEngine::enableAsync(size_t numRequests) {
+    if (numRequests < 2) {
+        throw std::invalid_argument("NativeInferenceEngine::enableAsync - at least 2 requests are required for pipelining");
+    }
+    if (!shallow) {
+        return;
+    }
+
+    stopAsync();
+
+    std::lock_guard<std::mutex> lock(asyncMutex);
+    asyncStopping = false;
+    for (size_t i = 0; i < numRequests; ++i) {
+        asyncWorkers.emplace_back([this] { asyncWorkerLoop(); });
+    }
+}
+
+bool NativeInferenceEngine::isAsync() const {
+    return !asyncWorkers.empty();
+}
+
+uint64_t NativeInferenceEngine::submitAsync(const std::vector<uint8_t>& inputData, CompletionCallback callback) {
+    if (!isAsync()) {
+        return InferenceBackend::submitAsync(inputData, std::move(callback));
+    }
+    checkFrames(inputData);
+
+    // 모든 워커가 사용 중이면 하나가 끝날 때까지 기다린다 (OpenVINO 백엔드의 유휴 요청 대기와 같은 동작).
+    std::unique_lock<std::mutex> lock(asyncMutex);
+    asyncCv.wait(lock, [this] { return inFlightCount.load() < asyncWorkers.size(); });
+
+    AsyncJob job;
+    job.frames = inputData;
+    job.callback = std::move(callback);
+    job.sequence = nextSequence++;
+    job.submitTime = std::chrono::steady_clock::now();
+    uint64_t sequence = job.sequence;
+
+    asyncQueue.push_back(std::move(job));
+    inFlightCount.fetch_add(1);
+    asyncCv.notify_all();
+    return sequence;
+}
+
+void NativeInferenceEngine::asyncWorkerLoop() {
+    // 워커마다 입력/중간 버퍼를 따로 두고, 읽기 전용인 특화 커널 가중치만 공유한다.
+    std::vector<float> input(opts.batch * calc::aa::kStereoFrameSize);
+    calc::aa::ShallowNetwork::Workspace ws;
+
+    while (true) {
+        AsyncJob job;
+        {
+            std::unique_lock<std::mutex> lock(asyncMutex);
+            asyncCv.wait(lock, [this] { return asyncStopping || !asyncQueue.empty(); });
+            if (asyncQueue.empty()) {
+                return;
+            }
+            job = std::move(asyncQueue.front());
+            asyncQueue.pop_front();
+        }
+
+        AsyncResult result{};
+        result.sequence = job.sequence;
+        try {
+            auto start = std::chrono::steady_clock::now();
+            interleaveFrames(job.frames.data(), input.data());
+            auto interleaved = std::chrono::steady_clock::now();
+            inferShallow(input.data(), result.output, ws);
+            if (profiler) {
+                recordShallowProfile(std::chrono::duration<double, std::micro>(interleaved - start).count(),
+                                     std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - interleaved).count());
+            }
+            result.ok = true;
+        } catch (const std::exception& e) {
+            result.ok = false;
+            result.output.clear();
+            result.error = e.what();
+        }
+        result.queuedMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - job.submitTime).count();
+        result.inFlight = inFlightCount.load();
+
+        try {
+            if (job.callback) {
+                job.callback(result);
+            }
+        } catch (...) {
+            // 작업 스레드가 끝나지 않도록 한다 (오류 보고는 콜백의 몫, 추론 실패는 result.error로 전달된다).
+        }
+
+        std::lock_guard<std::mutex> lock(asyncMutex);
+        inFlightCount.fetch_sub(1);
+        asyncCv.notify_all();
+    }
+}
+
+size_t NativeInferenceEngine::inFlight() const {
+    return inFlightCount.load();
+}
+
+void NativeInferenceEngine::waitAll() {
+    std::unique_lock<std::mutex> lock(asyncMutex);
+    asyncCv.wait(lock, [this] { return inFlightCount.load() == 0; });
+}
+
+void NativeInferenceEngine::stopAsync() {
+    // 대기 중인 요청을 모두 처리한 뒤 워커를 종료한다.
+    waitAll();
+    {
+        std::lock_guard<std::mutex> lock(asyncMutex);
+        asyncStopping = true;
+        asyncCv.notify_all();
+    }
+    for (auto& worker : asyncWorkers) {
+        worker.join();
+    }
+    asyncWorkers.clear();
+}
@@ -225,7 +225,8 @@ void RawData::ReceiveEventREventCyclic()
  
 void RawData::ReadDataREvent(ara::com::SamplePtr<deepracer::service::rawdata::proxy::events::REvent::SampleType const> samplePtr)
 {
-    auto data = *samplePtr.Get();
+    // 샘플을 복사하지 않고 빌려 쓴다. 핸들러가 돌아올 때까지 samplePtr이 샘플을 붙잡고 있다.
+    const auto &data = *samplePtr.Get();
     // put your logic
     m_logger.LogInfo() << "RawData::ReadDataREvent::data::" << data.size();
 
@@ -0,0 +1,536 @@
+#include "calc/aa/remote_inference_client.h"
+#include "calc/aa/stereo_preprocess.h"
+
+#include <fcntl.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cmath>
+#include <cstring>
+#include <future>
+#include <iomanip>
+#include <sstream>
+#include <stdexcept>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+// Inference.py 응답: struct.pack('ff', steering, throttle)
+constexpr size_t kReplySize = 2 * sizeof(float);
+
+constexpr int kConnectTimeoutMs = 500;
+constexpr auto kReconnectInterval = std::chrono::seconds(1);
+// 수신 스레드가 기한이 없을 때도 종료 여부를 확인하는 주기
+constexpr auto kIdlePoll = std::chrono::milliseconds(100);
+// 기한이 지난 요청의 응답이 이 시간 이상 오지 않으면 서버가 멈춘 것으로 집계한다 (연결은 유지하고 늦은 응답을 계속 받는다).
+constexpr auto kMinStallTimeout = std::chrono::seconds(1);
+
+double ElapsedMs(Clock::time_point since) {
+    return std::chrono::duration<double, std::milli>(Clock::now() - since).count();
+}
+
+enum class SendStatus {
+    Sent,
+    TimedOut, // deadline까지 다 보내지 못함 (sentBytes만큼은 보냈다)
+    Failed
+};
+
+// 추론 스레드가 서버 때문에 막히지 않도록 non-blocking으로 보내고, 소켓 버퍼가 찼으면 deadline까지만 기다린다.
+SendStatus SendWithin(int fd, const uint8_t* data, size_t size, Clock::time_point deadline, size_t& sentBytes) {
+    sentBytes = 0;
+    while (sentBytes < size) {
+        ssize_t sent = ::send(fd, data + sentBytes, size - sentBytes, MSG_NOSIGNAL | MSG_DONTWAIT);
+        if (sent >= 0) {
+            sentBytes += static_cast<size_t>(sent);
+            continue;
+        }
+        if (errno == EINTR) {
+            continue;
+        }
+        if (errno != EAGAIN && errno != EWOULDBLOCK) {
+            return SendStatus::Failed;
+        }
+        const double remainingMs = std::chrono::duration<double, std::milli>(deadline - Clock::now()).count();
+        if (remainingMs <= 0.0) {
+            return SendStatus::TimedOut;
+        }
+        pollfd writeFd{fd, POLLOUT, 0};
+        if (::poll(&writeFd, 1, static_cast<int>(std::ceil(remainingMs))) < 0 && errno != EINTR) {
+            return SendStatus::Failed;
+        }
+    }
+    return SendStatus::Sent;
+}
+
+int ConnectWithTimeout(const addrinfo* address) {
+    int fd = ::socket(address->ai_family, address->ai_socktype, address->ai_protocol);
+    if (fd < 0) {
+        return -1;
+    }
+
+    // 서버가 없을 때 수신 스레드가 오래 막히지 않도록 non-blocking으로 연결하고 기다린다.
+    int flags = ::fcntl(fd, F_GETFL, 0);
+    ::fcntl(fd, F_SETFL, flags | O_NONBLOCK);
+    int result = ::connect(fd, address->ai_addr, address->ai_addrlen);
+    if (result != 0 && errno == EINPROGRESS) {
+        pollfd waitFd{fd, POLLOUT, 0};
+        if (::poll(&waitFd, 1, kConnectTimeoutMs) == 1) {
+            int error = 0;
+            socklen_t length = sizeof(error);
+            ::getsockopt(fd, SOL_SOCKET, SO_ERROR, &error, &length);
+            result = (error == 0) ? 0 : -1;
+        }
+    }
+    if (result != 0) {
+        ::close(fd);
+        return -1;
+    }
+    ::fcntl(fd, F_SETFL, flags);
+
+    // 요청마다 작은 응답을 바로 받아야 하므로 Nagle 알고리즘을 끈다.
+    int noDelay = 1;
+    ::setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &noDelay, sizeof(noDelay));
+    return fd;
+}
+
+} // namespace
+
+RemoteInferenceClient::RemoteInferenceClient(const std::string& modelPath, const std::string& deviceName, const InferenceOptions& options)
+    : opts(options) {
+    if (opts.batch != 1) {
+        throw std::invalid_argument("RemoteInferenceClient - the Inference.py protocol carries one frame per request");
+    }
+    size_t colon = opts.remoteAddress.rfind(':');
+    if (colon == std::string::npos || colon == 0 || colon + 1 == opts.remoteAddress.size()) {
+        throw std::invalid_argument("RemoteInferenceClient - remote address must be host:port, got '" + opts.remoteAddress + "'");
+    }
+    host = opts.remoteAddress.substr(0, colon);
+    port = opts.remoteAddress.substr(colon + 1);
+
+    const std::string fallbackName = opts.remoteFallback.empty() ? DefaultInferenceBackend() : opts.remoteFallback;
+    if (fallbackName == "remote") {
+        throw std::invalid_argument("RemoteInferenceClient - fallback backend must be a local backend");
+    }
+    fallback = CreateInferenceBackend(fallbackName, modelPath, deviceName, opts);
+
+    wakeFd = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (wakeFd < 0) {
+        throw std::runtime_error("RemoteInferenceClient - eventfd failed");
+    }
+    sendBuffer.resize(calc::aa::kStereoFrameSize);
+    receiver = std::thread([this] { receiverLoop(); });
+}
+
+RemoteInferenceClient::~RemoteInferenceClient() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    cv.notify_all();
+    wakeReceiver();
+    // 수신 스레드는 종료하면서 남은 요청을 대체 추론으로 완료한다.
+    receiver.join();
+    ::close(wakeFd);
+}
+
+std::string RemoteInferenceClient::name() const {
+    return "remote";
+}
+
+void RemoteInferenceClient::setInputData(const std::vector<uint8_t>& inputData) {
+    if (inputData.size() != calc::aa::kStereoFrameSize) {
+        throw std::invalid_argument("RemoteInferenceClient - unexpected frame size " + std::to_string(inputData.size()));
+    }
+    syncInput = inputData;
+}
+
+std::vector<float> RemoteInferenceClient::runInference() {
+    std::promise<std::vector<float>> promise;
+    std::future<std::vector<float>> future = promise.get_future();
+    submitAsync(syncInput, [&promise](const AsyncResult& result) {
+        promise.set_value(result.output);
+    });
+    std::vector<float> output = future.get();
+    if (output.empty()) {
+        throw std::runtime_error("RemoteInferenceClient - fallback inference failed");
+    }
+    return output;
+}
+
+const InferenceOptions& RemoteInferenceClient::options() const {
+    return opts;
+}
+
+bool RemoteInferenceClient::loadedFromCache() const {
+    return fallback->loadedFromCache();
+}
+
+std::string RemoteInferenceClient::cacheWarning() const {
+    return fallback->cacheWarning();
+}
+
+double RemoteInferenceClient::loadTimeMs() const {
+    return fallback->loadTimeMs();
+}
+
+void RemoteInferenceClient::enableAsync(size_t numRequests) {
+    if (numRequests < 2) {
+        throw std::invalid_argument("RemoteInferenceClient::enableAsync - at least 2 requests are required for pipelining");
+    }
+    std::lock_guard<std::mutex> lock(mutex);
+    maxInFlight = numRequests;
+    async = true;
+}
+
+bool RemoteInferenceClient::isAsync() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return async;
+}
+
+uint64_t RemoteInferenceClient::submitAsync(const std::vector<uint8_t>& inputData, CompletionCallback callback) {
+    if (inputData.size() != calc::aa::kStereoFrameSize) {
+        throw std::invalid_argument("RemoteInferenceClient - unexpected frame size " + std::to_string(inputData.size()));
+    }
+
+    std::unique_lock<std::mutex> lock(mutex);
+    // 보낸 요청이 모두 기한을 넘겼다면 늦은 응답을 기다리지 않는다 (아래에서 바로 대체 추론).
+    cv.wait(lock, [this] {
+        return stopping || socketFd < 0 || pending.size() < maxInFlight || pending.back().expired;
+    });
+
+    Request request;
+    request.sequence = nextSequence++;
+    request.frame = inputData;
+    request.callback = std::move(callback);
+    request.submitTime = Clock::now();
+    request.deadline = request.submitTime + std::chrono::microseconds(static_cast<int64_t>(opts.remoteDeadlineMs * 1000.0));
+    ++outstanding;
+    const uint64_t sequence = request.sequence;
+
+    if (socketFd < 0 || pending.size() >= maxInFlight) {
+        if (socketFd < 0) {
+            ++offlineFallbacks;
+        } else {
+            ++deadlineFallbacks;
+        }
+        lock.unlock();
+        std::vector<float> output = runFallback(request.frame);
+        complete(request, std::move(output), false);
+        return sequence;
+    }
+
+    const int fd = socketFd;
+    const Clock::time_point deadline = request.deadline;
+    pending.push_back(std::move(request));
+    const std::vector<uint8_t>& frame = pending.back().frame;
+
+    // 연결은 sendMutex를 잡은 채로만 닫히므로 보내는 동안 fd가 유효하다. 응답은 보내기 전에 올 수 없으므로
+    // pending을 먼저 넣고 mutex를 놓아도 된다. 프레임은 서버 입력 배치 (120, 160, 2)로 인터리브해서 보낸다.
+    std::unique_lock<std::mutex> sendLock(sendMutex);
+    calc::aa::InterleaveStereoU8(frame.data(), frame.data() + calc::aa::kStereoPlaneSize, sendBuffer.data(),
+                                 calc::aa::kStereoPlaneSize);
+    lock.unlock();
+    // 수신 스레드가 이전 기한으로 poll 중일 수 있으므로 새 기한을 반영하도록 깨운다.
+    wakeReceiver();
+
+    size_t sentBytes = 0;
+    const SendStatus status = SendWithin(fd, sendBuffer.data(), sendBuffer.size(), deadline, sentBytes);
+    if (status == SendStatus::Sent) {
+        return sequence;
+    }
+    if (status == SendStatus::TimedOut && sentBytes == 0) {
+        // 한 바이트도 보내지 못했으면 스트림이 어긋나지 않았으므로 연결은 두고 이 요청만 로컬에서 추론한다.
+        // 그 사이 수신 스레드가 기한 초과로 이미 대체 추론했을 수 있다.
+        sendLock.unlock();
+        lock.lock();
+        auto it = std::find_if(pending.begin(), pending.end(), [sequence](const Request& r) { return r.sequence == sequence; });
+        if (it == pending.end()) {
+            return sequence;
+        }
+        Request unsent = std::move(*it);
+        pending.erase(it);
+        ++sendTimeouts;
+        cv.notify_all();
+        if (unsent.expired) {
+            return sequence;
+        }
+        ++deadlineFallbacks;
+        lock.unlock();
+        std::vector<float> output = runFallback(unsent.frame);
+        complete(unsent, std::move(output), false);
+        return sequence;
+    }
+    // 전송 실패, 또는 프레임 일부만 나가 서버가 받을 바이트 경계가 어긋났다. 연결을 끊으면 수신 스레드가
+    // 남은 요청을 대체 추론으로 완료하고 다시 연결한다.
+    if (status == SendStatus::TimedOut) {
+        std::lock_guard<std::mutex> counterLock(mutex);
+        ++sendTimeouts;
+    }
+    ::shutdown(fd, SHUT_RDWR);
+    return sequence;
+}
+
+size_t RemoteInferenceClient::inFlight() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return outstanding;
+}
+
+void RemoteInferenceClient::waitAll() {
+    std::unique_lock<std::mutex> lock(mutex);
+    cv.wait(lock, [this] { return outstanding == 0; });
+}
+
+std::string RemoteInferenceClient::latencyReport() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    const uint64_t replies = remoteResults + lateReplies;
+
+    std::ostringstream report;
+    report << std::fixed << std::setprecision(2);
+    report << "remote " << host << ":" << port << (socketFd >= 0 ? " (connected)" : " (disconnected)")
+           << ": " << remoteResults << " results, " << lateReplies << " late replies, fallbacks "
+           << deadlineFallbacks << " deadline / " << offlineFallbacks << " offline, send timeouts " << sendTimeouts
+           << ", server stalls " << stalls << (stalled ? " (stalled now)" : "") << ", reconnects " << reconnects;
+    if (replies > 0) {
+        report << ", rtt mean " << latencySumMs / replies << " ms, max " << latencyMaxMs << " ms, histogram"
+               << std::defaultfloat << std::setprecision(6);
+        for (size_t i = 0; i < latencyHistogram.size(); ++i) {
+            report << (i < kLatencyBucketsMs.size() ? " <" : " >=")
+                   << kLatencyBucketsMs[std::min(i, kLatencyBucketsMs.size() - 1)]
+                   << "ms:" << latencyHistogram[i];
+        }
+    }
+    return report.str();
+}
+
+void RemoteInferenceClient::receiverLoop() {
+    uint8_t reply[kReplySize];
+    size_t replyBytes = 0;
+    auto nextConnect = Clock::now();
+    const auto stallTimeout = std::max<Clock::duration>(
+        kMinStallTimeout, std::chrono::microseconds(static_cast<int64_t>(opts.remoteDeadlineMs * 10000.0)));
+
+    std::unique_lock<std::mutex> lock(mutex);
+    while (!stopping) {
+        auto now = Clock::now();
+        if (socketFd < 0) {
+            if (now < nextConnect) {
+                cv.wait_until(lock, nextConnect, [this] { return stopping; });
+                continue;
+            }
+            lock.unlock();
+            bool connected = connectToServer();
+            lock.lock();
+            nextConnect = Clock::now() + kReconnectInterval;
+            replyBytes = 0;
+            if (connected) {
+                cv.notify_all();
+            }
+            continue;
+        }
+
+        // 기한이 지난 요청은 보낸 순서대로 대체 추론으로 완료한다. 요청은 응답(또는 연결 종료)까지 pending에 남는다.
+        std::vector<Request> expired;
+        for (auto& request : pending) {
+            if (request.expired || request.deadline > now) {
+                continue;
+            }
+            request.expired = true;
+            ++deadlineFallbacks;
+            Request copy;
+            copy.sequence = request.sequence;
+            copy.frame = request.frame;
+            copy.callback = std::move(request.callback);
+            copy.submitTime = request.submitTime;
+            expired.push_back(std::move(copy));
+        }
+        if (!expired.empty()) {
+            cv.notify_all();
+            lock.unlock();
+            for (auto& request : expired) {
+                std::vector<float> output = runFallback(request.frame);
+                complete(request, std::move(output), false);
+            }
+            lock.lock();
+            continue;
+        }
+
+        // 오래 응답이 없어도 다시 연결하지 않는다. Inference.py는 연결 하나를 순서대로 처리하므로 늦은 응답을 계속 받아 버리는 편이
+        // 연결을 새로 맺는 것보다 빨리 정상으로 돌아온다. 그동안 새 요청은 보낼 자리가 없으면 바로 로컬에서 추론한다 (submitAsync).
+        if (!stalled && !pending.empty() && pending.front().expired && now - pending.front().submitTime > stallTimeout) {
+            stalled = true;
+            ++stalls;
+        }
+
+        // 다음 기한(보낸 순서대로 증가)까지 응답을 기다린다.
+        auto wakeAt = now + kIdlePoll;
+        for (const auto& request : pending) {
+            if (!request.expired) {
+                wakeAt = std::min(wakeAt, request.deadline);
+                break;
+            }
+        }
+        const int fd = socketFd;
+        lock.unlock();
+
+        const int timeoutMs = static_cast<int>(std::ceil(std::max(0.0, std::chrono::duration<double, std::milli>(wakeAt - now).count())));
+        pollfd readFds[2] = {{fd, POLLIN, 0}, {wakeFd, POLLIN, 0}};
+        bool failed = false;
+        if (::poll(readFds, 2, timeoutMs) > 0 && readFds[1].revents != 0) {
+            uint64_t wakeups = 0;
+            ssize_t drained = ::read(wakeFd, &wakeups, sizeof(wakeups));
+            (void)drained;
+        }
+        if (readFds[0].revents != 0) {
+            ssize_t received = ::recv(fd, reply + replyBytes, kReplySize - replyBytes, 0);
+            if (received > 0) {
+                replyBytes += static_cast<size_t>(received);
+            } else if (received == 0 || errno != EINTR) {
+                failed = true;
+            }
+        }
+
+        lock.lock();
+        if (failed) {
+            closeConnection(lock);
+            continue;
+        }
+        if (replyBytes < kReplySize) {
+            continue;
+        }
+        replyBytes = 0;
+        if (pending.empty()) {
+            // 보내지 않은 요청의 응답: 순서를 더 이상 믿을 수 없으므로 다시 연결한다.
+            closeConnection(lock);
+            continue;
+        }
+
+        Request request = std::move(pending.front());
+        pending.pop_front();
+        stalled = false;
+        recordLatency(ElapsedMs(request.submitTime));
+        cv.notify_all();
+        if (request.expired) {
+            ++lateReplies;
+            continue;
+        }
+        ++remoteResults;
+
+        std::vector<float> output(kReplySize / sizeof(float));
+        std::memcpy(output.data(), reply, kReplySize);
+        lock.unlock();
+        complete(request, std::move(output), true);
+        lock.lock();
+    }
+    closeConnection(lock);
+}
+
+bool RemoteInferenceClient::connectToServer() {
+    addrinfo hints{};
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_STREAM;
+    addrinfo* addresses = nullptr;
+    if (::getaddrinfo(host.c_str(), port.c_str(), &hints, &addresses) != 0) {
+        return false;
+    }
+    int fd = -1;
+    for (addrinfo* address = addresses; address != nullptr && fd < 0; address = address->ai_next) {
+        fd = ConnectWithTimeout(address);
+    }
+    ::freeaddrinfo(addresses);
+    if (fd < 0) {
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex);
+    socketFd = fd;
+    stalled = false;
+    ++reconnects;
+    return true;
+}
+
+void RemoteInferenceClient::closeConnection(std::unique_lock<std::mutex>& lock) {
+    if (socketFd >= 0) {
+        std::lock_guard<std::mutex> sendLock(sendMutex);
+        ::close(socketFd);
+        socketFd = -1;
+    }
+
+    // 응답을 받지 못한 요청은 대체 추론으로 완료한다 (이미 기한 초과로 완료된 요청은 버린다).
+    std::deque<Request> orphaned;
+    orphaned.swap(pending);
+    for (const auto& request : orphaned) {
+        if (!request.expired) {
+            ++offlineFallbacks;
+        }
+    }
+    cv.notify_all();
+
+    lock.unlock();
+    for (auto& request : orphaned) {
+        if (!request.expired) {
+            std::vector<float> output = runFallback(request.frame);
+            complete(request, std::move(output), false);
+        }
+    }
+    lock.lock();
+}
+
+void RemoteInferenceClient::wakeReceiver() {
+    uint64_t one = 1;
+    ssize_t written = ::write(wakeFd, &one, sizeof(one));
+    (void)written;
+}
+
+void RemoteInferenceClient::recordLatency(double ms) {
+    size_t bucket = 0;
+    while (bucket < kLatencyBucketsMs.size() && ms >= kLatencyBucketsMs[bucket]) {
+        ++bucket;
+    }
+    ++latencyHistogram[bucket];
+    latencySumMs += ms;
+    latencyMaxMs = std::max(latencyMaxMs, ms);
+}
+
+void RemoteInferenceClient::complete(Request& request, std::vector<float> output, bool remote) {
+    AsyncResult result;
+    result.ok = !output.empty();
+    if (!result.ok) {
+        result.error = remote ? "remote inference returned no output" : "local fallback produced no output";
+    }
+    result.sequence = request.sequence;
+    result.output = std::move(output);
+    result.queuedMs = ElapsedMs(request.submitTime);
+    result.fallback = !remote;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        result.inFlight = outstanding;
+    }
+
+    if (request.callback) {
+        request.callback(result);
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        --outstanding;
+    }
+    cv.notify_all();
+}
+
+std::vector<float> RemoteInferenceClient::runFallback(const std::vector<uint8_t>& frame) {
+    std::lock_guard<std::mutex> lock(fallbackMutex);
+    try {
+        fallback->setInputData(frame);
+        return fallback->runInference();
+    } catch (const std::exception&) {
+        return std::vector<float>();
+    }
+}
@@ -0,0 +1,364 @@
+#include "calc/aa/shadow_evaluator.h"
+#include "calc/aa/stereo_preprocess.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <sstream>
+#include <stdexcept>
+
+#include <pthread.h>
+#include <sched.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+namespace calc
+{
+namespace aa
+{
+
+namespace
+{
+
+constexpr int kShadowWarmupIterations = 2;
+
+int64_t ToNs(ShadowEvaluator::Clock::time_point t)
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(t.time_since_epoch()).count();
+}
+
+} // namespace
+
+ShadowEvaluator::ShadowEvaluator()
+    : m_state(State::Off)
+    , m_suspendedUntil(0)
+    , m_suspensions(0)
+    , m_pendingSequence(-1)
+    , m_hasPending(false)
+    , m_stopping(false)
+    , m_latencySumMs(0.0)
+    , m_steeringDiffSum(0.0)
+    , m_throttleDiffSum(0.0)
+{
+}
+
+ShadowEvaluator::~ShadowEvaluator()
+{
+    Stop();
+}
+
+void ShadowEvaluator::Start(Loader loader, ActionDecoder decoder, const Settings& settings)
+{
+    Stop();
+    m_decoder = std::make_unique<ActionDecoder>(std::move(decoder));
+    m_settings = settings;
+    m_suspendedUntil.store(0);
+    m_suspensions.store(0);
+    {
+        std::lock_guard<std::mutex> lock(m_pairMutex);
+        m_primary.fill(PairEntry());
+        m_shadow.fill(PairEntry());
+    }
+    {
+        std::lock_guard<std::mutex> lock(m_statsMutex);
+        m_stats = Stats();
+        m_latencySumMs = 0.0;
+        m_steeringDiffSum = 0.0;
+        m_throttleDiffSum = 0.0;
+    }
+    {
+        std::lock_guard<std::mutex> lock(m_slotMutex);
+        m_hasPending = false;
+        m_stopping = false;
+    }
+    SetState(State::Loading);
+    m_thread = std::thread(&ShadowEvaluator::Run, this, std::move(loader));
+}
+
+void ShadowEvaluator::Stop()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_slotMutex);
+        m_stopping = true;
+    }
+    m_slotCv.notify_all();
+    if (m_thread.joinable())
+    {
+        m_thread.join();
+    }
+}
+
+void ShadowEvaluator::Offer(const std::vector<uint8_t>& frame, int64_t sequence)
+{
+    // 주 추론 스레드에서 호출되므로 섀도 스레드가 칸을 잡고 있으면 기다리지 않는다.
+    // 아직 가져가지 않은 프레임이 있으면 더 최신 프레임으로 덮어쓴다 (섀도 모델이 주 모델보다 느린 경우).
+    bool replaced = false;
+    {
+        std::unique_lock<std::mutex> lock(m_slotMutex, std::try_to_lock);
+        if (lock.owns_lock())
+        {
+            replaced = m_hasPending;
+            m_pending.assign(frame.begin(), frame.end());
+            m_pendingSequence = sequence;
+            m_hasPending = true;
+        }
+        else
+        {
+            replaced = true;
+        }
+    }
+    m_slotCv.notify_one();
+
+    std::lock_guard<std::mutex> lock(m_statsMutex);
+    ++m_stats.offered;
+    if (replaced)
+    {
+        ++m_stats.busyDrops;
+    }
+}
+
+void ShadowEvaluator::RecordPrimary(int64_t sequence, const ControlCommand& command)
+{
+    std::lock_guard<std::mutex> lock(m_pairMutex);
+    PairEntry& shadow = m_shadow[static_cast<size_t>(sequence) % kPairHistory];
+    if (shadow.sequence == sequence)
+    {
+        Compare(shadow.command, command);
+        shadow.sequence = -1;
+        return;
+    }
+    PairEntry& entry = m_primary[static_cast<size_t>(sequence) % kPairHistory];
+    entry.sequence = sequence;
+    entry.command = command;
+}
+
+bool ShadowEvaluator::Suspend(Clock::time_point until)
+{
+    if (m_state.load() != State::Running && m_state.load() != State::Loading)
+    {
+        return false;
+    }
+    // 이미 중단 중이면 연장만 하고 횟수는 세지 않는다 (한 번의 위험 구간을 여러 번 세지 않도록).
+    const int64_t now = ToNs(Clock::now());
+    const int64_t previous = m_suspendedUntil.exchange(std::max(ToNs(until), m_suspendedUntil.load()));
+    if (previous > now)
+    {
+        return false;
+    }
+
+    const uint32_t suspensions = m_suspensions.fetch_add(1) + 1;
+    {
+        std::lock_guard<std::mutex> lock(m_statsMutex);
+        m_stats.suspensions = suspensions;
+    }
+    if (suspensions < std::max<uint32_t>(1, m_settings.maxSuspensions))
+    {
+        return false;
+    }
+
+    SetState(State::Dropped);
+    m_slotCv.notify_all();
+    return true;
+}
+
+bool ShadowEvaluator::Accepting(Clock::time_point now) const
+{
+    return m_state.load() == State::Running && ToNs(now) >= m_suspendedUntil.load();
+}
+
+ShadowEvaluator::Stats ShadowEvaluator::GetStats() const
+{
+    std::lock_guard<std::mutex> lock(m_statsMutex);
+    Stats stats = m_stats;
+    stats.state = m_state.load();
+    return stats;
+}
+
+const char* ShadowEvaluator::StateName(State state)
+{
+    switch (state)
+    {
+    case State::Off:
+        return "off";
+    case State::Loading:
+        return "loading";
+    case State::Running:
+        return "running";
+    case State::Dropped:
+        return "dropped";
+    case State::Failed:
+        return "failed";
+    }
+    return "unknown";
+}
+
+void ShadowEvaluator::Run(Loader loader)
+{
+    // 로드 전에 코어와 우선순위를 정해야 백엔드 내부 스레드도 이를 물려받는다.
+    ApplyPlacement();
+
+    std::unique_ptr<InferenceBackend> engine;
+    std::vector<uint8_t> frame;
+    std::vector<float> output;
+    try
+    {
+        engine = loader();
+        // 첫 추론의 초기화 비용이 지연 통계에 섞이지 않도록 예열한다.
+        frame.assign(kStereoFrameSize * std::max<size_t>(1, engine->options().batch), 0);
+        for (int i = 0; i < kShadowWarmupIterations; ++i)
+        {
+            engine->setInputData(frame);
+            engine->runInferenceInto(output);
+        }
+    }
+    catch (const std::exception& e)
+    {
+        SetState(State::Failed, std::string("load failed: ") + e.what());
+        return;
+    }
+
+    State expected = State::Loading;
+    if (!m_state.compare_exchange_strong(expected, State::Running))
+    {
+        // 로드 중에 내려놓였다 (Suspend 누적)
+        return;
+    }
+
+    while (true)
+    {
+        int64_t sequence = -1;
+        {
+            std::unique_lock<std::mutex> lock(m_slotMutex);
+            m_slotCv.wait(lock, [this] { return m_stopping || m_hasPending || m_state.load() != State::Running; });
+            if (m_stopping || m_state.load() != State::Running)
+            {
+                break;
+            }
+            // 버퍼 교환: 다음 Offer는 이전 프레임 버퍼를 재사용한다.
+            frame.swap(m_pending);
+            sequence = m_pendingSequence;
+            m_hasPending = false;
+        }
+
+        ControlCommand command;
+        double latencyMs = 0.0;
+        try
+        {
+            const auto start = Clock::now();
+            engine->setInputData(frame);
+            engine->runInferenceInto(output);
+            latencyMs = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+            if (output.size() < m_decoder->OutputSize())
+            {
+                throw std::runtime_error("output size " + std::to_string(output.size()) + " < " +
+                                         std::to_string(m_decoder->OutputSize()));
+            }
+            command = m_decoder->Decode(output.data());
+        }
+        catch (const std::exception& e)
+        {
+            SetState(State::Failed, std::string("inference failed: ") + e.what());
+            break;
+        }
+
+        RecordShadow(sequence, command, latencyMs);
+    }
+
+    // 내려놓은 뒤에는 코어와 메모리를 돌려준다.
+    engine.reset();
+}
+
+void ShadowEvaluator::ApplyPlacement()
+{
+    if (!m_settings.cpus.empty())
+    {
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        for (int cpu : m_settings.cpus)
+        {
+            if (cpu >= 0 && cpu < CPU_SETSIZE)
+            {
+                CPU_SET(cpu, &set);
+            }
+        }
+        // 실패해도(코어 번호가 없는 머신 등) 평가는 계속한다. 우선순위만으로도 주 경로가 앞선다.
+        pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+    }
+    // Linux의 setpriority(PRIO_PROCESS, tid)는 스레드 하나에만 적용된다.
+    setpriority(PRIO_PROCESS, static_cast<id_t>(syscall(SYS_gettid)), m_settings.nice);
+}
+
+void ShadowEvaluator::SetState(State state, const std::string& error)
+{
+    m_state.store(state);
+    std::lock_guard<std::mutex> lock(m_statsMutex);
+    m_stats.state = state;
+    if (!error.empty())
+    {
+        m_stats.error = error;
+    }
+}
+
+void ShadowEvaluator::RecordShadow(int64_t sequence, const ControlCommand& command, double latencyMs)
+{
+    {
+        std::lock_guard<std::mutex> lock(m_statsMutex);
+        ++m_stats.inferred;
+        m_latencySumMs += latencyMs;
+        m_stats.meanLatencyMs = m_latencySumMs / m_stats.inferred;
+        m_stats.maxLatencyMs = std::max(m_stats.maxLatencyMs, latencyMs);
+    }
+
+    std::lock_guard<std::mutex> lock(m_pairMutex);
+    PairEntry& primary = m_primary[static_cast<size_t>(sequence) % kPairHistory];
+    if (primary.sequence == sequence)
+    {
+        Compare(command, primary.command);
+        primary.sequence = -1;
+        return;
+    }
+    // 주 모델 결과를 기다린다. 짝을 못 찾은 채 밀려나는 이전 결과는 비교하지 못한 것으로 센다.
+    PairEntry& entry = m_shadow[static_cast<size_t>(sequence) % kPairHistory];
+    if (entry.sequence >= 0)
+    {
+        std::lock_guard<std::mutex> statsLock(m_statsMutex);
+        ++m_stats.unpaired;
+    }
+    entry.sequence = sequence;
+    entry.command = command;
+}
+
+void ShadowEvaluator::Compare(const ControlCommand& shadow, const ControlCommand& primary)
+{
+    const double steeringDiff = std::fabs(shadow.steering - primary.steering);
+    const double throttleDiff = std::fabs(shadow.throttle - primary.throttle);
+    std::lock_guard<std::mutex> lock(m_statsMutex);
+    ++m_stats.compared;
+    m_steeringDiffSum += steeringDiff;
+    m_throttleDiffSum += throttleDiff;
+    m_stats.meanSteeringDiff = m_steeringDiffSum / m_stats.compared;
+    m_stats.meanThrottleDiff = m_throttleDiffSum / m_stats.compared;
+    m_stats.maxSteeringDiff = std::max(m_stats.maxSteeringDiff, steeringDiff);
+    m_stats.maxThrottleDiff = std::max(m_stats.maxThrottleDiff, throttleDiff);
+}
+
+std::vector<int> ParseCpuList(const std::string& text)
+{
+    std::vector<int> cpus;
+    std::istringstream iss(text);
+    std::string token;
+    while (std::getline(iss, token, ','))
+    {
+        char* end = nullptr;
+        const long cpu = std::strtol(token.c_str(), &end, 10);
+        if (end != token.c_str() && cpu >= 0)
+        {
+            cpus.push_back(static_cast<int>(cpu));
+        }
+    }
+    return cpus;
+}
+
+} /// namespace aa
+} /// namespace calc
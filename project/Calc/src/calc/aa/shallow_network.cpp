@@ -0,0 +1,123 @@
+#include "calc/aa/shallow_network.h"
+
+namespace calc
+{
+namespace aa
+{
+
+namespace
+{
+
+struct Buffers
+{
+    const float* conv1;
+    const float* conv1Bias;
+    const float* conv2;
+    const float* conv2Bias;
+    const float* conv3;
+    const float* conv3Bias;
+    const float* dense;
+    const float* denseBias;
+    float residualScale;
+    const float* head;
+    const float* headBias;
+    float* act1;
+    float* act2;
+    float* act3;
+    float* hidden;
+};
+
+using ForwardFn = void (*)(const Buffers&, const float*, float*);
+
+CALC_KERNEL_INLINE void ForwardImpl(const Buffers& b, const float* input, float* output)
+{
+    ShallowNetwork::Conv1::Run(input, b.conv1, b.conv1Bias, b.act1);
+    ShallowNetwork::Conv2::Run(b.act1, b.conv2, b.conv2Bias, b.act2);
+    ShallowNetwork::Conv3::Run(b.act2, b.conv3, b.conv3Bias, b.act3);
+    ShallowNetwork::Dense::Run(b.act3, b.dense, b.denseBias, b.hidden);
+    for (size_t i = 0; i < ShallowNetwork::Dense::kOutputSize; ++i)
+    {
+        b.hidden[i] = b.residualScale * b.hidden[i] + b.hidden[i];
+    }
+    ShallowNetwork::Head::Run(b.hidden, b.head, b.headBias, output);
+}
+
+void ForwardGeneric(const Buffers& b, const float* input, float* output)
+{
+    ForwardImpl(b, input, output);
+}
+
+#if defined(__x86_64__) || defined(__i386__)
+// 같은 템플릿 커널을 AVX2 + FMA로 다시 컴파일한 버전 (채널 블록 16 = ymm 2개)
+__attribute__((target("avx2,fma")))
+void ForwardAvx2(const Buffers& b, const float* input, float* output)
+{
+    ForwardImpl(b, input, output);
+}
+#endif
+
+struct Dispatch
+{
+    ForwardFn forward;
+    const char* isa;
+};
+
+const Dispatch& SelectForward()
+{
+    static const Dispatch dispatch = []() -> Dispatch {
+#if defined(__x86_64__) || defined(__i386__)
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma"))
+        {
+            return {ForwardAvx2, "avx2"};
+        }
+#endif
+        return {ForwardGeneric, "generic"};
+    }();
+    return dispatch;
+}
+
+} // namespace
+
+ShallowNetwork::ShallowNetwork(const Weights& weights)
+    : m_conv1(Conv1::kWeightSize)
+    , m_conv1Bias(weights.conv1Bias, weights.conv1Bias + Conv1::kOutChannels)
+    , m_conv2(Conv2::kWeightSize)
+    , m_conv2Bias(weights.conv2Bias, weights.conv2Bias + Conv2::kOutChannels)
+    , m_conv3(Conv3::kWeightSize)
+    , m_conv3Bias(weights.conv3Bias, weights.conv3Bias + Conv3::kOutChannels)
+    , m_dense(weights.dense, weights.dense + Dense::kWeightSize)
+    , m_denseBias(weights.denseBias, weights.denseBias + Dense::kOutputSize)
+    , m_residualScale(weights.residualScale)
+    , m_head(weights.head, weights.head + Head::kWeightSize)
+    , m_headBias(weights.headBias, weights.headBias + Head::kOutputSize)
+{
+    Conv1::PackWeights(weights.conv1, m_conv1.data());
+    Conv2::PackWeights(weights.conv2, m_conv2.data());
+    Conv3::PackWeights(weights.conv3, m_conv3.data());
+}
+
+ShallowNetwork::Workspace::Workspace()
+    : act1(Conv1::kOutputSize)
+    , act2(Conv2::kOutputSize)
+    , act3(Conv3::kOutputSize)
+    , hidden(Dense::kOutputSize)
+{
+}
+
+void ShallowNetwork::Forward(const float* input, float* output, Workspace& workspace) const
+{
+    Buffers buffers{m_conv1.data(), m_conv1Bias.data(), m_conv2.data(), m_conv2Bias.data(), m_conv3.data(),
+                    m_conv3Bias.data(), m_dense.data(), m_denseBias.data(), m_residualScale, m_head.data(),
+                    m_headBias.data(), workspace.act1.data(), workspace.act2.data(), workspace.act3.data(),
+                    workspace.hidden.data()};
+    SelectForward().forward(buffers, input, output);
+}
+
+const char* ShallowNetwork::Isa()
+{
+    return SelectForward().isa;
+}
+
+} /// namespace aa
+} /// namespace calc
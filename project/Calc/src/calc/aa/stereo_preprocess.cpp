@@ -0,0 +1,174 @@
+#include "calc/aa/stereo_preprocess.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define CALC_STEREO_PREPROCESS_X86 1
+#endif
+
+namespace calc
+{
+namespace aa
+{
+
+namespace
+{
+
+using KernelFn = void (*)(const uint8_t*, const uint8_t*, float*, size_t, float, float);
+
+inline void InterleaveTail(const uint8_t* left, const uint8_t* right, float* dst, size_t begin, size_t end,
+                           float scale, float offset)
+{
+    for (size_t i = begin; i < end; ++i)
+    {
+        dst[2 * i] = static_cast<float>(left[i]) * scale + offset;
+        dst[2 * i + 1] = static_cast<float>(right[i]) * scale + offset;
+    }
+}
+
+#ifdef CALC_STEREO_PREPROCESS_X86
+
+// 16 픽셀 단위: 좌/우 바이트를 먼저 인터리브(L0 R0 L1 R1 ...)한 뒤 u8 -> u16 -> u32 -> f32로 확장한다.
+void InterleaveSse2(const uint8_t* left, const uint8_t* right, float* dst, size_t pixels, float scale, float offset)
+{
+    const bool normalize = (scale != 1.0f) || (offset != 0.0f);
+    const __m128i zero = _mm_setzero_si128();
+    const __m128 vscale = _mm_set1_ps(scale);
+    const __m128 voffset = _mm_set1_ps(offset);
+
+    size_t i = 0;
+    for (; i + 16 <= pixels; i += 16)
+    {
+        __m128i l = _mm_loadu_si128(reinterpret_cast<const __m128i*>(left + i));
+        __m128i r = _mm_loadu_si128(reinterpret_cast<const __m128i*>(right + i));
+        __m128i lr[2] = {_mm_unpacklo_epi8(l, r), _mm_unpackhi_epi8(l, r)};
+
+        float* out = dst + 2 * i;
+        for (int h = 0; h < 2; ++h)
+        {
+            __m128i w16lo = _mm_unpacklo_epi8(lr[h], zero);
+            __m128i w16hi = _mm_unpackhi_epi8(lr[h], zero);
+            __m128 f[4] = {
+                _mm_cvtepi32_ps(_mm_unpacklo_epi16(w16lo, zero)),
+                _mm_cvtepi32_ps(_mm_unpackhi_epi16(w16lo, zero)),
+                _mm_cvtepi32_ps(_mm_unpacklo_epi16(w16hi, zero)),
+                _mm_cvtepi32_ps(_mm_unpackhi_epi16(w16hi, zero)),
+            };
+            for (int k = 0; k < 4; ++k)
+            {
+                if (normalize)
+                {
+                    f[k] = _mm_add_ps(_mm_mul_ps(f[k], vscale), voffset);
+                }
+                _mm_storeu_ps(out + 16 * h + 4 * k, f[k]);
+            }
+        }
+    }
+    InterleaveTail(left, right, dst, i, pixels, scale, offset);
+}
+
+// 16 픽셀 단위: SSE로 바이트 인터리브 후 8바이트씩 vpmovzxbd로 바로 8개의 int32로 확장한다.
+__attribute__((target("avx2")))
+void InterleaveAvx2(const uint8_t* left, const uint8_t* right, float* dst, size_t pixels, float scale, float offset)
+{
+    const bool normalize = (scale != 1.0f) || (offset != 0.0f);
+    const __m256 vscale = _mm256_set1_ps(scale);
+    const __m256 voffset = _mm256_set1_ps(offset);
+
+    size_t i = 0;
+    for (; i + 16 <= pixels; i += 16)
+    {
+        __m128i l = _mm_loadu_si128(reinterpret_cast<const __m128i*>(left + i));
+        __m128i r = _mm_loadu_si128(reinterpret_cast<const __m128i*>(right + i));
+        __m128i lr[2] = {_mm_unpacklo_epi8(l, r), _mm_unpackhi_epi8(l, r)};
+
+        float* out = dst + 2 * i;
+        for (int h = 0; h < 2; ++h)
+        {
+            __m256 f[2] = {
+                _mm256_cvtepi32_ps(_mm256_cvtepu8_epi32(lr[h])),
+                _mm256_cvtepi32_ps(_mm256_cvtepu8_epi32(_mm_unpackhi_epi64(lr[h], lr[h]))),
+            };
+            for (int k = 0; k < 2; ++k)
+            {
+                if (normalize)
+                {
+                    f[k] = _mm256_add_ps(_mm256_mul_ps(f[k], vscale), voffset);
+                }
+                _mm256_storeu_ps(out + 16 * h + 8 * k, f[k]);
+            }
+        }
+    }
+    InterleaveTail(left, right, dst, i, pixels, scale, offset);
+}
+
+#endif // CALC_STEREO_PREPROCESS_X86
+
+inline void InterleaveU8Tail(const uint8_t* left, const uint8_t* right, uint8_t* dst, size_t begin, size_t end)
+{
+    for (size_t i = begin; i < end; ++i)
+    {
+        dst[2 * i] = left[i];
+        dst[2 * i + 1] = right[i];
+    }
+}
+
+struct Dispatch
+{
+    KernelFn kernel;
+    const char* isa;
+};
+
+const Dispatch& SelectKernel()
+{
+    static const Dispatch dispatch = []() -> Dispatch {
+#ifdef CALC_STEREO_PREPROCESS_X86
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx2"))
+        {
+            return {InterleaveAvx2, "avx2"};
+        }
+        return {InterleaveSse2, "sse2"};
+#else
+        return {InterleaveStereoToFloatReference, "scalar"};
+#endif
+    }();
+    return dispatch;
+}
+
+} // namespace
+
+void InterleaveStereoToFloatReference(const uint8_t* left, const uint8_t* right, float* dst, size_t pixels,
+                                      float scale, float offset)
+{
+    InterleaveTail(left, right, dst, 0, pixels, scale, offset);
+}
+
+void InterleaveStereoToFloat(const uint8_t* left, const uint8_t* right, float* dst, size_t pixels,
+                             float scale, float offset)
+{
+    SelectKernel().kernel(left, right, dst, pixels, scale, offset);
+}
+
+void InterleaveStereoU8(const uint8_t* left, const uint8_t* right, uint8_t* dst, size_t pixels)
+{
+    size_t i = 0;
+#ifdef CALC_STEREO_PREPROCESS_X86
+    // 바이트 인터리브는 SSE2 unpack 두 번이면 충분하다 (x86-64는 SSE2를 항상 지원).
+    for (; i + 16 <= pixels; i += 16)
+    {
+        __m128i l = _mm_loadu_si128(reinterpret_cast<const __m128i*>(left + i));
+        __m128i r = _mm_loadu_si128(reinterpret_cast<const __m128i*>(right + i));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + 2 * i), _mm_unpacklo_epi8(l, r));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + 2 * i + 16), _mm_unpackhi_epi8(l, r));
+    }
+#endif
+    InterleaveU8Tail(left, right, dst, i, pixels);
+}
+
+const char* StereoPreprocessIsa()
+{
+    return SelectKernel().isa;
+}
+
+} /// namespace aa
+} /// namespace calc
@@ -0,0 +1,337 @@
+#include "calc/aa/thread_autotune.h"
+#include "calc/aa/stereo_preprocess.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+
+namespace calc
+{
+namespace aa
+{
+
+namespace
+{
+
+using Clock = std::chrono::steady_clock;
+
+constexpr int kTuneWarmupIterations = 3;
+
+// 5% 이내의 차이는 측정 잡음으로 보고 스레드를 적게 쓰는 구성을 고른다.
+constexpr double kTuneTolerance = 1.05;
+
+// FNV-1a 64bit: 캐시 키용 (암호학적 용도 아님)
+constexpr uint64_t kFnvOffset = 1469598103934665603ULL;
+constexpr uint64_t kFnvPrime = 1099511628211ULL;
+
+uint64_t HashBytes(uint64_t hash, const char* data, size_t size)
+{
+    for (size_t i = 0; i < size; ++i)
+    {
+        hash ^= static_cast<uint8_t>(data[i]);
+        hash *= kFnvPrime;
+    }
+    return hash;
+}
+
+uint64_t HashFile(uint64_t hash, const std::string& path)
+{
+    std::ifstream file(path, std::ios::binary);
+    char buffer[64 * 1024];
+    while (file)
+    {
+        file.read(buffer, sizeof(buffer));
+        hash = HashBytes(hash, buffer, static_cast<size_t>(file.gcount()));
+    }
+    return hash;
+}
+
+// 카메라 프레임과 비슷한 크기의 고정 시드 합성 프레임 (측정 결과가 입력에 따라 흔들리지 않도록)
+std::vector<std::vector<uint8_t>> MakeTuneFrames(size_t batch)
+{
+    std::mt19937 rng(7);
+    std::uniform_int_distribution<int> dist(0, 255);
+    std::vector<std::vector<uint8_t>> frames(4, std::vector<uint8_t>(batch * kStereoFrameSize));
+    for (auto& frame : frames)
+    {
+        for (auto& value : frame)
+        {
+            value = static_cast<uint8_t>(dist(rng));
+        }
+    }
+    return frames;
+}
+
+ThreadTuneResult MeasureCandidate(const ThreadTuneRequest& request, const ThreadingConfig& config,
+                                  const std::vector<std::vector<uint8_t>>& frames)
+{
+    ThreadTuneResult result;
+    result.config = config;
+    try
+    {
+        InferenceOptions options = request.options;
+        config.ApplyTo(options);
+        auto loadStart = Clock::now();
+        auto engine = CreateInferenceBackend(request.backend, request.modelPath, request.deviceName, options);
+        result.loadMs = std::chrono::duration<double, std::milli>(Clock::now() - loadStart).count();
+
+        for (int i = 0; i < kTuneWarmupIterations; ++i)
+        {
+            engine->setInputData(frames[i % frames.size()]);
+            engine->runInference();
+        }
+
+        const int iterations = std::max(1, request.iterations);
+        if (request.asyncRequests >= 2)
+        {
+            engine->enableAsync(request.asyncRequests);
+        }
+        if (engine->isAsync())
+        {
+            // 파이프라인 처리량: 요청을 쉬지 않고 넣었을 때 프레임당 평균 시간
+            std::atomic<int> failed{0};
+            auto start = Clock::now();
+            for (int i = 0; i < iterations; ++i)
+            {
+                engine->submitAsync(frames[i % frames.size()], [&failed](const InferenceBackend::AsyncResult& r) {
+                    if (!r.ok)
+                    {
+                        failed.fetch_add(1);
+                    }
+                });
+            }
+            engine->waitAll();
+            if (failed.load() > 0)
+            {
+                throw std::runtime_error(std::to_string(failed.load()) + " async request(s) failed");
+            }
+            result.scoreMs = std::chrono::duration<double, std::milli>(Clock::now() - start).count() / iterations;
+        }
+        else
+        {
+            // 동기 지연: 한 프레임씩 추론했을 때의 p90 (Calc 기본 모드와 같은 조건)
+            std::vector<double> samples;
+            samples.reserve(iterations);
+            for (int i = 0; i < iterations; ++i)
+            {
+                auto start = Clock::now();
+                engine->setInputData(frames[i % frames.size()]);
+                engine->runInference();
+                samples.push_back(std::chrono::duration<double, std::milli>(Clock::now() - start).count());
+            }
+            std::sort(samples.begin(), samples.end());
+            result.scoreMs = samples[std::min(samples.size() - 1, static_cast<size_t>(samples.size() * 0.9))];
+        }
+        result.ok = true;
+    }
+    catch (const std::exception& e)
+    {
+        result.error = e.what();
+    }
+    return result;
+}
+
+} // namespace
+
+std::string ThreadingConfig::ToString() const
+{
+    std::ostringstream oss;
+    oss << "threads=" << threads << " streams=" << streams << " bind=" << (bind.empty() ? "default" : bind);
+    return oss.str();
+}
+
+bool ThreadingConfig::Parse(const std::string& text, ThreadingConfig& config)
+{
+    ThreadingConfig parsed;
+    bool hasThreads = false;
+    std::istringstream iss(text);
+    std::string token;
+    while (iss >> token)
+    {
+        const size_t eq = token.find('=');
+        if (eq == std::string::npos)
+        {
+            continue;
+        }
+        const std::string key = token.substr(0, eq);
+        const std::string value = token.substr(eq + 1);
+        if (key == "threads")
+        {
+            parsed.threads = static_cast<size_t>(std::strtoul(value.c_str(), nullptr, 10));
+            hasThreads = true;
+        }
+        else if (key == "streams")
+        {
+            parsed.streams = static_cast<size_t>(std::strtoul(value.c_str(), nullptr, 10));
+        }
+        else if (key == "bind")
+        {
+            parsed.bind = (value == "default") ? std::string() : value;
+        }
+    }
+    if (!hasThreads)
+    {
+        return false;
+    }
+    config = parsed;
+    return true;
+}
+
+void ThreadingConfig::ApplyTo(InferenceOptions& options) const
+{
+    options.threads = threads;
+    options.streams = streams;
+    options.bindThreads = bind;
+}
+
+std::vector<ThreadingConfig> ThreadTuneCandidates(size_t cpuBudget, size_t asyncRequests)
+{
+    cpuBudget = std::max<size_t>(1, cpuBudget);
+    std::vector<size_t> threadCounts;
+    for (size_t threads = 1; threads < cpuBudget; threads *= 2)
+    {
+        threadCounts.push_back(threads);
+    }
+    threadCounts.push_back(cpuBudget);
+
+    std::vector<size_t> streamCounts = {1};
+    if (asyncRequests >= 2 && cpuBudget >= 2)
+    {
+        streamCounts.push_back(2);
+    }
+
+    std::vector<ThreadingConfig> candidates;
+    for (size_t streams : streamCounts)
+    {
+        for (size_t threads : threadCounts)
+        {
+            if (threads < streams)
+            {
+                continue;
+            }
+            for (const char* bind : {"NO", "YES"})
+            {
+                ThreadingConfig config;
+                config.threads = threads;
+                config.streams = streams;
+                config.bind = bind;
+                candidates.push_back(config);
+            }
+        }
+    }
+    return candidates;
+}
+
+std::vector<ThreadTuneResult> RunThreadTune(const ThreadTuneRequest& request)
+{
+    const auto frames = MakeTuneFrames(std::max<size_t>(1, request.options.batch));
+    std::vector<ThreadTuneResult> results;
+    for (const auto& config : ThreadTuneCandidates(request.cpuBudget, request.asyncRequests))
+    {
+        results.push_back(MeasureCandidate(request, config, frames));
+    }
+    return results;
+}
+
+size_t PickThreadTune(const std::vector<ThreadTuneResult>& results)
+{
+    size_t best = results.size();
+    for (size_t i = 0; i < results.size(); ++i)
+    {
+        if (results[i].ok && (best == results.size() || results[i].scoreMs < results[best].scoreMs))
+        {
+            best = i;
+        }
+    }
+    if (best == results.size())
+    {
+        return best;
+    }
+
+    // 가장 빠른 구성과 차이가 작으면 코어를 덜 쓰는 구성 (다른 스레드에 CPU를 남긴다)
+    size_t pick = best;
+    for (size_t i = 0; i < results.size(); ++i)
+    {
+        if (results[i].ok && results[i].scoreMs <= results[best].scoreMs * kTuneTolerance &&
+            results[i].config.threads < results[pick].config.threads)
+        {
+            pick = i;
+        }
+    }
+    return pick;
+}
+
+std::string ThreadTuneCachePath(const std::string& cacheDir, const ThreadTuneRequest& request)
+{
+    std::filesystem::path xmlPath(request.modelPath);
+    std::filesystem::path binPath = xmlPath;
+    binPath.replace_extension(".bin");
+
+    uint64_t hash = HashFile(kFnvOffset, xmlPath.string());
+    hash = HashFile(hash, binPath.string());
+    std::ostringstream key;
+    key << MachineId() << "|" << request.backend << "|" << request.deviceName << "|"
+        << (request.options.precision == InputPrecision::U8 ? "U8" : "FP32") << "|" << request.options.batch << "|"
+        << request.cpuBudget << "|" << request.asyncRequests;
+    const std::string text = key.str();
+    hash = HashBytes(hash, text.data(), text.size());
+
+    char hex[17];
+    std::snprintf(hex, sizeof(hex), "%016llx", static_cast<unsigned long long>(hash));
+    return (std::filesystem::path(cacheDir) / (std::string("threading-") + hex + ".txt")).string();
+}
+
+bool LoadThreadTune(const std::string& path, ThreadingConfig& config)
+{
+    std::ifstream file(path);
+    std::string line;
+    return std::getline(file, line) && ThreadingConfig::Parse(line, config);
+}
+
+void SaveThreadTune(const std::string& path, const ThreadTuneResult& result)
+{
+    // 캐시는 최적화일 뿐이므로 쓰기에 실패해도 무시한다 (다음 시작에서 다시 측정).
+    std::error_code ec;
+    std::filesystem::create_directories(std::filesystem::path(path).parent_path(), ec);
+    const std::string tmpPath = path + ".tmp";
+    {
+        std::ofstream file(tmpPath);
+        if (!file)
+        {
+            return;
+        }
+        file << result.config.ToString() << "\n"
+             << "# " << MachineId() << ", score " << result.scoreMs << " ms\n";
+    }
+    std::filesystem::rename(tmpPath, path, ec);
+}
+
+std::string MachineId()
+{
+    std::string model = "unknown";
+    std::ifstream cpuinfo("/proc/cpuinfo");
+    std::string line;
+    while (std::getline(cpuinfo, line))
+    {
+        if (line.compare(0, 10, "model name") == 0)
+        {
+            const size_t colon = line.find(':');
+            if (colon != std::string::npos)
+            {
+                model = line.substr(std::min(line.size(), colon + 2));
+            }
+            break;
+        }
+    }
+    return model + " x" + std::to_string(std::max(1u, std::thread::hardware_concurrency()));
+}
+
+} /// namespace aa
+} /// namespace calc
@@ -0,0 +1,958 @@
+// Calc 오프라인 벤치마크 (AUTOSAR 런타임 없이 단독 실행)
+//
+// 사용법:
+//   calc_bench preprocess [반복 횟수]
+//     - 스테레오 전처리 커널(SIMD)과 스칼라 기준 구현의 결과 일치 여부 확인 및 프레임당 처리 시간 비교
+//   calc_bench precision <model.xml> [반복 횟수]
+//     - FP32 입력과 U8 입력 네트워크의 출력이 허용 오차 안에서 같은지 확인하고 프레임당 추론 시간 비교
+//   calc_bench backends <model.xml> [반복 횟수]
+//     - 빌드에 포함된 모든 추론 백엔드(openvino, native, native-generic)의 출력 일치 여부와 프레임당 지연 시간(평균/p50/p99) 비교
+//       native는 DEEP_CONVOLUTIONAL_NETWORK_SHALLOW용 shape 특화 커널, native-generic은 같은 엔진의 일반 연산 경로
+//   calc_bench latency <model.xml> [옵션]
+//     - 모델을 한 번 로드해 녹화 또는 합성 프레임으로 추론하고 콜드 스타트, p50/p90/p99/max, FPS, 최대 RSS를 출력
+//     - 스레드 수 x 입력 정밀도 조합마다 반복한다. 모델을 재학습하거나 교체할 때 회귀 확인용
+//       --backend <이름>        추론 백엔드 (기본: 빌드 기본값)
+//       --frames <파일>         38400바이트 프레임을 이어 붙인 녹화 파일 (없으면 합성 프레임)
+//       --iterations <N>        조합마다 측정할 프레임 수 (기본 500)
+//       --threads <n,n,...>     추론 스레드 수 목록 (기본 0 = 백엔드 기본값)
+//       --precision <FP32,U8>   입력 정밀도 목록 (기본 FP32)
+//       --max-p99 <ms>          p99가 이 값을 넘으면 실패 종료 (회귀 게이트)
+//   calc_bench changes <recording.bin> [옵션]
+//     - 변화 감지(SAD) 커널의 기준 구현 일치 여부와 프레임당 시간, 임계값별 추론 생략 비율을 출력
+//       --threshold <t,t,...>   격자 픽셀당 평균 절대 차이 임계값 목록 (기본 1,2,4,8)
+//       --max-skips <N>         연속 생략 상한 (기본 2)
+//       --model <model.xml>     지정하면 모든 프레임을 추론해 생략으로 재사용한 조향/스로틀의 최대 오차와 절약 시간도 출력
+//   calc_bench remote <model.xml> [옵션]
+//     - 같은 프레임을 로컬 백엔드와 원격 서버(Inference.py)로 추론해 지연 시간(동기 p50/p99, 파이프라인 FPS)과 출력 차이를 비교
+//       --address <host:port>   서버 주소 (기본 127.0.0.1:8080)
+//       --frames <파일>         녹화 파일 (없으면 합성 프레임)
+//       --iterations <N>        측정할 프레임 수 (기본 500)
+//       --requests <N>          파이프라인 요청 수 (기본 4)
+//       --deadline <ms>         요청별 기한, 넘기면 로컬 대체 추론 (기본 50)
+//       --fallback <이름>       로컬/대체 추론 백엔드 (기본: 빌드 기본값)
+//   calc_bench allocs <model.xml> [옵션]
+//     - Calc의 동기 프레임 경로(우편함 -> 변화 감지 -> 추론 -> 출력 변환 -> 기한 기록)를 그대로 돌리며
+//       전역 operator new를 세어, 예열 후 정상 상태에서 프레임당 힙 할당이 0인지 확인한다 (0이 아니면 실패 종료).
+//       ControlData 포트 쓰기(ara::com)는 AUTOSAR 런타임이 필요해 측정 범위에 없으므로 Calc 전체 경로의 할당 수는 아니다.
+//       비교용으로 이전 방식(샘플 복사, 값 전달, runInference 반환 벡터)의 프레임당 할당 수도 출력한다.
+//       --backend <이름>        추론 백엔드 (기본: 빌드 기본값)
+//       --frames <파일>         녹화 파일 (없으면 합성 프레임)
+//       --iterations <N>        측정할 프레임 수 (기본 500)
+//   calc_bench tune <model.xml> [옵션]
+//     - Calc 시작 시 자동 조정과 같은 방법으로 스레드 수 x 코어 고정 (x 스트림) 후보를 측정해 표로 출력하고 고른 구성을 표시
+//       --backend <이름>        추론 백엔드 (기본: 빌드 기본값, native 백엔드는 스레드 설정을 무시하므로 비교용)
+//       --budget <N>            추론에 쓸 최대 코어 수 (기본: 논리 코어 수 - 1)
+//       --requests <N>          2 이상이면 파이프라인 처리량으로 비교 (기본 0 = 동기 지연 p90)
+//       --iterations <N>        후보마다 측정할 프레임 수 (기본 30)
+//   calc_bench profile <model.xml> [옵션]
+//     - 프로파일링 모드로 추론해 레이어별 실행 시간 표(평균 내림차순)를 출력하고 JSON으로 저장
+//       --backend <이름>        추론 백엔드 (기본: 빌드 기본값)
+//       --frames <파일>         녹화 파일 (없으면 합성 프레임)
+//       --iterations <N>        측정할 프레임 수 (기본 200, 통계 창도 같은 크기)
+//       --json <경로>           JSON 출력 파일 (기본: 출력하지 않음)
+#include "calc/aa/action_decoder.h"
+#include "calc/aa/deadline_monitor.h"
+#include "calc/aa/frame_change_detector.h"
+#include "calc/aa/frame_inference.h"
+#include "calc/aa/frame_mailbox.h"
+#include "calc/aa/inference_backend.h"
+#include "calc/aa/layer_profiler.h"
+#include "calc/aa/shallow_network.h"
+#include "calc/aa/stereo_preprocess.h"
+#include "calc/aa/thread_autotune.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <new>
+#include <vector>
+
+// allocs 모드용 할당 계수기: 전역 operator new를 바꿔 호출 횟수와 바이트를 센다 (다른 모드에서는 세기만 하고 쓰지 않는다).
+namespace
+{
+std::atomic<uint64_t> g_allocations{0};
+std::atomic<uint64_t> g_allocatedBytes{0};
+}
+
+void* operator new(std::size_t size)
+{
+    g_allocations.fetch_add(1, std::memory_order_relaxed);
+    g_allocatedBytes.fetch_add(size, std::memory_order_relaxed);
+    if (void* p = std::malloc(size == 0 ? 1 : size))
+    {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment)
+{
+    g_allocations.fetch_add(1, std::memory_order_relaxed);
+    g_allocatedBytes.fetch_add(size, std::memory_order_relaxed);
+    const std::size_t align = static_cast<std::size_t>(alignment);
+    if (void* p = std::aligned_alloc(align, (std::max<std::size_t>(size, 1) + align - 1) / align * align))
+    {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+// 인라인되면 GCC가 new/free 짝을 잘못 경고하므로 호출로 남긴다.
+__attribute__((noinline)) void operator delete(void* p) noexcept
+{
+    std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept
+{
+    ::operator delete(p);
+}
+
+void operator delete(void* p, std::align_val_t) noexcept
+{
+    ::operator delete(p);
+}
+
+void operator delete(void* p, std::size_t, std::align_val_t) noexcept
+{
+    ::operator delete(p);
+}
+
+namespace
+{
+
+using Clock = std::chrono::steady_clock;
+
+template <typename F>
+double MeasureNsPerCall(F&& fn, int iterations)
+{
+    auto start = Clock::now();
+    for (int i = 0; i < iterations; ++i)
+    {
+        fn();
+    }
+    auto end = Clock::now();
+    return std::chrono::duration<double, std::nano>(end - start).count() / iterations;
+}
+
+int RunPreprocess(int iterations)
+{
+    using namespace calc::aa;
+
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<int> dist(0, 255);
+    std::vector<uint8_t> frame(kStereoFrameSize);
+    for (auto& v : frame)
+    {
+        v = static_cast<uint8_t>(dist(rng));
+    }
+    const uint8_t* left = frame.data();
+    const uint8_t* right = left + kStereoPlaneSize;
+
+    std::vector<float> expected(kStereoFrameSize);
+    std::vector<float> actual(kStereoFrameSize);
+
+    // 정규화 없음 / 있음 두 경우 모두 기준 구현과 비교 (픽셀 수가 16의 배수가 아닌 경우의 tail 처리 포함)
+    const float params[][2] = {{1.0f, 0.0f}, {1.0f / 255.0f, -0.5f}};
+    const size_t pixelCounts[] = {kStereoPlaneSize, kStereoPlaneSize - 7};
+    for (const auto& p : params)
+    {
+        for (size_t pixels : pixelCounts)
+        {
+            std::fill(actual.begin(), actual.end(), -1.0f);
+            InterleaveStereoToFloatReference(left, right, expected.data(), pixels, p[0], p[1]);
+            InterleaveStereoToFloat(left, right, actual.data(), pixels, p[0], p[1]);
+
+            float maxDiff = 0.0f;
+            for (size_t i = 0; i < 2 * pixels; ++i)
+            {
+                maxDiff = std::max(maxDiff, std::fabs(expected[i] - actual[i]));
+            }
+            if (maxDiff > 1e-6f)
+            {
+                std::cerr << "preprocess: mismatch against reference (scale=" << p[0] << ", offset=" << p[1]
+                          << ", pixels=" << pixels << ", max diff=" << maxDiff << ")" << std::endl;
+                return EXIT_FAILURE;
+            }
+        }
+    }
+
+    double referenceNs = MeasureNsPerCall([&] {
+        InterleaveStereoToFloatReference(left, right, expected.data(), kStereoPlaneSize);
+    }, iterations);
+    double kernelNs = MeasureNsPerCall([&] {
+        InterleaveStereoToFloat(left, right, actual.data(), kStereoPlaneSize);
+    }, iterations);
+
+    std::cout << "preprocess: kernel = " << StereoPreprocessIsa() << ", matches reference" << std::endl;
+    std::cout << "preprocess: reference " << referenceNs / 1000.0 << " us/frame, kernel "
+              << kernelNs / 1000.0 << " us/frame, speedup x" << referenceNs / kernelNs << std::endl;
+    return EXIT_SUCCESS;
+}
+
+std::vector<std::vector<uint8_t>> MakeRandomFrames(size_t count, unsigned seed)
+{
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<int> dist(0, 255);
+    std::vector<std::vector<uint8_t>> frames(count, std::vector<uint8_t>(calc::aa::kStereoFrameSize));
+    for (auto& frame : frames)
+    {
+        for (auto& v : frame)
+        {
+            v = static_cast<uint8_t>(dist(rng));
+        }
+    }
+    return frames;
+}
+
+int RunPrecision(const std::string& modelPath, int iterations)
+{
+    // U8 경로는 변환이 네트워크 안에서 일어날 뿐 같은 정수 입력이므로 출력 차이는 커널 차이 수준이어야 한다.
+    constexpr float kTolerance = 1e-3f;
+
+    InferenceOptions fp32Options;
+    fp32Options.precision = InputPrecision::FP32;
+    InferenceOptions u8Options;
+    u8Options.precision = InputPrecision::U8;
+
+    auto fp32Engine = CreateInferenceBackend(DefaultInferenceBackend(), modelPath, "CPU", fp32Options);
+    auto u8Engine = CreateInferenceBackend(DefaultInferenceBackend(), modelPath, "CPU", u8Options);
+    InferenceBackend& fp32 = *fp32Engine;
+    InferenceBackend& u8 = *u8Engine;
+
+    auto frames = MakeRandomFrames(16, 7);
+    frames.push_back(std::vector<uint8_t>(calc::aa::kStereoFrameSize, 0));
+    frames.push_back(std::vector<uint8_t>(calc::aa::kStereoFrameSize, 255));
+
+    float maxDiff = 0.0f;
+    for (const auto& frame : frames)
+    {
+        fp32.setInputData(frame);
+        auto expected = fp32.runInference();
+        u8.setInputData(frame);
+        auto actual = u8.runInference();
+        if (expected.size() != actual.size())
+        {
+            std::cerr << "precision: output size mismatch (" << expected.size() << " vs " << actual.size() << ")" << std::endl;
+            return EXIT_FAILURE;
+        }
+        for (size_t i = 0; i < expected.size(); ++i)
+        {
+            maxDiff = std::max(maxDiff, std::fabs(expected[i] - actual[i]));
+        }
+    }
+    std::cout << "precision: max |FP32 - U8| output diff = " << maxDiff << " (tolerance " << kTolerance << ")" << std::endl;
+    if (maxDiff > kTolerance)
+    {
+        return EXIT_FAILURE;
+    }
+
+    size_t index = 0;
+    double fp32Ns = MeasureNsPerCall([&] {
+        fp32.setInputData(frames[index++ % frames.size()]);
+        fp32.runInference();
+    }, iterations);
+    index = 0;
+    double u8Ns = MeasureNsPerCall([&] {
+        u8.setInputData(frames[index++ % frames.size()]);
+        u8.runInference();
+    }, iterations);
+
+    std::cout << "precision: FP32 input " << fp32Ns / 1e6 << " ms/frame, U8 input " << u8Ns / 1e6
+              << " ms/frame, speedup x" << fp32Ns / u8Ns << std::endl;
+    return EXIT_SUCCESS;
+}
+
+int RunBackends(const std::string& modelPath, int iterations)
+{
+    // 백엔드마다 커널과 누적 순서가 다르므로 float 오차 수준의 차이만 허용한다.
+    constexpr float kTolerance = 1e-3f;
+
+    auto frames = MakeRandomFrames(16, 11);
+    std::vector<std::vector<float>> expected;
+    std::cout << "backends: shallow kernel isa = " << calc::aa::ShallowNetwork::Isa() << std::endl;
+    std::string expectedBackend;
+
+    for (const auto& backendName : AvailableInferenceBackends())
+    {
+        auto engine = CreateInferenceBackend(backendName, modelPath, "CPU");
+
+        float maxDiff = 0.0f;
+        for (size_t i = 0; i < frames.size(); ++i)
+        {
+            engine->setInputData(frames[i]);
+            auto output = engine->runInference();
+            if (expectedBackend.empty())
+            {
+                expected.push_back(output);
+                continue;
+            }
+            if (output.size() != expected[i].size())
+            {
+                std::cerr << "backends: output size mismatch between " << expectedBackend << " and " << backendName << std::endl;
+                return EXIT_FAILURE;
+            }
+            for (size_t k = 0; k < output.size(); ++k)
+            {
+                maxDiff = std::max(maxDiff, std::fabs(output[k] - expected[i][k]));
+            }
+        }
+
+        std::vector<double> latencies;
+        latencies.reserve(iterations);
+        for (int i = 0; i < iterations; ++i)
+        {
+            auto start = Clock::now();
+            engine->setInputData(frames[i % frames.size()]);
+            engine->runInference();
+            latencies.push_back(std::chrono::duration<double, std::milli>(Clock::now() - start).count());
+        }
+        std::sort(latencies.begin(), latencies.end());
+        double mean = 0.0;
+        for (double latency : latencies)
+        {
+            mean += latency;
+        }
+        mean /= latencies.size();
+
+        std::cout << "backends: " << backendName << " load " << engine->loadTimeMs() << " ms, mean " << mean
+                  << " ms/frame, p50 " << latencies[latencies.size() / 2] << " ms, p99 "
+                  << latencies[std::min(latencies.size() - 1, latencies.size() * 99 / 100)] << " ms";
+        if (!expectedBackend.empty())
+        {
+            std::cout << ", max |" << expectedBackend << " - " << backendName << "| = " << maxDiff;
+        }
+        std::cout << std::endl;
+
+        if (maxDiff > kTolerance)
+        {
+            std::cerr << "backends: " << backendName << " output differs from " << expectedBackend
+                      << " (tolerance " << kTolerance << ")" << std::endl;
+            return EXIT_FAILURE;
+        }
+        if (expectedBackend.empty())
+        {
+            expectedBackend = backendName;
+        }
+    }
+    return EXIT_SUCCESS;
+}
+
+// --key value 옵션 값, 없으면 defaultValue
+std::string ArgOr(const std::map<std::string, std::string>& args, const std::string& key, const std::string& defaultValue)
+{
+    auto it = args.find(key);
+    return it == args.end() ? defaultValue : it->second;
+}
+
+// 녹화 파일(kStereoFrameSize 바이트 프레임의 연속)을 읽는다. mode는 경고 앞에 붙일 calc_bench 모드 이름
+std::vector<std::vector<uint8_t>> LoadRecordedFrames(const std::string& path, const std::string& mode)
+{
+    std::ifstream file(path, std::ios::binary);
+    if (!file)
+    {
+        throw std::runtime_error("cannot read " + path);
+    }
+    std::vector<std::vector<uint8_t>> frames;
+    std::vector<uint8_t> frame(calc::aa::kStereoFrameSize);
+    while (file.read(reinterpret_cast<char*>(frame.data()), frame.size()))
+    {
+        frames.push_back(frame);
+    }
+    if (file.gcount() != 0)
+    {
+        std::cerr << mode << ": ignoring trailing " << file.gcount() << " bytes of " << path << std::endl;
+    }
+    if (frames.empty())
+    {
+        throw std::runtime_error(path + " has no complete " + std::to_string(calc::aa::kStereoFrameSize) + "-byte frame");
+    }
+    return frames;
+}
+
+// /proc/self/status의 항목 (kB), 읽을 수 없으면 0
+size_t ReadProcStatusKb(const std::string& key)
+{
+    std::ifstream status("/proc/self/status");
+    std::string line;
+    while (std::getline(status, line))
+    {
+        if (line.compare(0, key.size() + 1, key + ":") == 0)
+        {
+            return static_cast<size_t>(std::strtoull(line.c_str() + key.size() + 1, nullptr, 10));
+        }
+    }
+    return 0;
+}
+
+// 조합마다 최대 RSS를 따로 재기 위해 VmHWM을 현재 RSS로 되돌린다 (Linux 4.0+, 실패하면 누적 최대값).
+void ResetPeakRss()
+{
+    std::ofstream clearRefs("/proc/self/clear_refs");
+    clearRefs << "5";
+}
+
+double Percentile(const std::vector<double>& sorted, double percent)
+{
+    size_t index = static_cast<size_t>(percent / 100.0 * (sorted.size() - 1) + 0.5);
+    return sorted[std::min(index, sorted.size() - 1)];
+}
+
+std::vector<std::string> SplitList(const std::string& text)
+{
+    std::vector<std::string> items;
+    std::stringstream stream(text);
+    std::string item;
+    while (std::getline(stream, item, ','))
+    {
+        if (!item.empty())
+        {
+            items.push_back(item);
+        }
+    }
+    return items;
+}
+
+int RunLatency(const std::string& modelPath, const std::map<std::string, std::string>& args)
+{
+    const std::string backend = ArgOr(args, "backend", DefaultInferenceBackend());
+    const int iterations = std::max(1, std::atoi(ArgOr(args, "iterations", "500").c_str()));
+    const double maxP99 = std::atof(ArgOr(args, "max-p99", "0").c_str());
+
+    std::vector<std::vector<uint8_t>> frames;
+    std::string source;
+    if (args.count("frames"))
+    {
+        frames = LoadRecordedFrames(args.at("frames"), "latency");
+        source = args.at("frames") + " (" + std::to_string(frames.size()) + " frames)";
+    }
+    else
+    {
+        frames = MakeRandomFrames(64, 5);
+        source = "synthetic (" + std::to_string(frames.size()) + " frames)";
+    }
+
+    std::cout << "latency: model " << modelPath << ", backend " << backend << ", input " << source
+              << ", " << iterations << " iterations per run" << std::endl;
+    std::cout << std::left << std::setw(8) << "threads" << std::setw(10) << "precision" << std::right
+              << std::setw(11) << "load ms" << std::setw(11) << "cold ms" << std::setw(9) << "p50"
+              << std::setw(9) << "p90" << std::setw(9) << "p99" << std::setw(9) << "max"
+              << std::setw(9) << "fps" << std::setw(12) << "peak RSS MB" << std::endl;
+
+    bool regression = false;
+    for (const auto& threads : SplitList(ArgOr(args, "threads", "0")))
+    {
+        for (const auto& precision : SplitList(ArgOr(args, "precision", "FP32")))
+        {
+            InferenceOptions options;
+            options.threads = static_cast<size_t>(std::strtoul(threads.c_str(), nullptr, 10));
+            if (precision == "U8")
+            {
+                options.precision = InputPrecision::U8;
+            }
+            else if (precision != "FP32")
+            {
+                std::cerr << "latency: unknown precision " << precision << std::endl;
+                return EXIT_FAILURE;
+            }
+
+            ResetPeakRss();
+
+            // 콜드 스타트: 모델 로드부터 첫 번째 추론 결과까지 (캐시 없이)
+            auto coldStart = Clock::now();
+            auto engine = CreateInferenceBackend(backend, modelPath, "CPU", options);
+            engine->setInputData(frames[0]);
+            engine->runInference();
+            double coldMs = std::chrono::duration<double, std::milli>(Clock::now() - coldStart).count();
+
+            std::vector<double> latencies;
+            latencies.reserve(iterations);
+            auto runStart = Clock::now();
+            for (int i = 0; i < iterations; ++i)
+            {
+                auto start = Clock::now();
+                engine->setInputData(frames[i % frames.size()]);
+                engine->runInference();
+                latencies.push_back(std::chrono::duration<double, std::milli>(Clock::now() - start).count());
+            }
+            double runSeconds = std::chrono::duration<double>(Clock::now() - runStart).count();
+            std::sort(latencies.begin(), latencies.end());
+
+            double p99 = Percentile(latencies, 99);
+            std::cout << std::fixed << std::setprecision(2) << std::left << std::setw(8) << threads
+                      << std::setw(10) << precision << std::right << std::setw(11) << engine->loadTimeMs()
+                      << std::setw(11) << coldMs << std::setw(9) << Percentile(latencies, 50)
+                      << std::setw(9) << Percentile(latencies, 90) << std::setw(9) << p99
+                      << std::setw(9) << latencies.back() << std::setw(9) << iterations / runSeconds
+                      << std::setw(12) << ReadProcStatusKb("VmHWM") / 1024.0 << std::endl;
+            std::cout.unsetf(std::ios::floatfield);
+
+            if (maxP99 > 0.0 && p99 > maxP99)
+            {
+                std::cerr << "latency: p99 " << p99 << " ms exceeds --max-p99 " << maxP99 << " ms (threads "
+                          << threads << ", " << precision << ")" << std::endl;
+                regression = true;
+            }
+        }
+    }
+    if (backend.compare(0, 6, "native") == 0)
+    {
+        std::cout << "latency: native backends are single-threaded, --threads has no effect" << std::endl;
+    }
+    return regression ? EXIT_FAILURE : EXIT_SUCCESS;
+}
+
+int RunChanges(const std::string& recordingPath, const std::map<std::string, std::string>& args)
+{
+    using namespace calc::aa;
+
+    const uint32_t maxSkips = static_cast<uint32_t>(std::strtoul(ArgOr(args, "max-skips", "2").c_str(), nullptr, 10));
+    std::vector<std::vector<uint8_t>> frames = LoadRecordedFrames(recordingPath, "changes");
+
+    // 커널 검증: 녹화의 연속 프레임 쌍과 합성 프레임 쌍
+    std::vector<std::vector<uint8_t>> random = MakeRandomFrames(2, 11);
+    std::vector<uint8_t> grid(kChangeGridSize);
+    for (size_t i = 0; i < frames.size() + 1; ++i)
+    {
+        const auto& a = (i < frames.size()) ? frames[i] : random[0];
+        const auto& b = (i < frames.size()) ? frames[(i + 1) % frames.size()] : random[1];
+        SampleChangeGrid(b.data(), grid.data());
+        if (ChangeGridSad(a.data(), grid.data()) != ChangeGridSadReference(a.data(), grid.data()))
+        {
+            std::cerr << "changes: SAD kernel mismatch against reference (pair " << i << ")" << std::endl;
+            return EXIT_FAILURE;
+        }
+    }
+    SampleChangeGrid(frames[0].data(), grid.data());
+    const int iterations = 20000;
+    double referenceNs = MeasureNsPerCall([&] { ChangeGridSadReference(frames.back().data(), grid.data()); }, iterations);
+    double kernelNs = MeasureNsPerCall([&] { ChangeGridSad(frames.back().data(), grid.data()); }, iterations);
+    std::cout << "changes: kernel = " << ChangeGridIsa() << ", matches reference, reference " << referenceNs / 1000.0
+              << " us/frame, kernel " << kernelNs / 1000.0 << " us/frame" << std::endl;
+
+    // 모델이 있으면 모든 프레임의 실제 결과를 구해 두고, 생략한 프레임에서 재사용한 값과 비교한다.
+    std::vector<ControlCommand> actual;
+    double inferenceMs = 0.0;
+    if (args.count("model"))
+    {
+        const std::string modelPath = args.at("model");
+        bool hasMetadata = false;
+        ActionDecoder decoder(ModelMetadata::LoadOrBaseline(ModelMetadata::DefaultPath(modelPath), hasMetadata));
+        auto engine = CreateInferenceBackend(DefaultInferenceBackend(), modelPath, "CPU");
+        auto start = Clock::now();
+        for (const auto& frame : frames)
+        {
+            engine->setInputData(frame);
+            actual.push_back(decoder.Decode(engine->runInference().data()));
+        }
+        inferenceMs = std::chrono::duration<double, std::milli>(Clock::now() - start).count() / frames.size();
+        std::cout << "changes: " << engine->name() << " inference " << inferenceMs << " ms/frame" << std::endl;
+    }
+
+    std::cout << "changes: " << recordingPath << " (" << frames.size() << " frames), max consecutive skips " << maxSkips << std::endl;
+    for (const auto& text : SplitList(ArgOr(args, "threshold", "1,2,4,8")))
+    {
+        FrameChangeDetector detector(std::strtof(text.c_str(), nullptr), maxSkips);
+        ControlCommand last;
+        float maxSteeringError = 0.0f;
+        float maxThrottleError = 0.0f;
+        for (size_t i = 0; i < frames.size(); ++i)
+        {
+            const bool skip = detector.ShouldSkip(frames[i].data());
+            if (actual.empty())
+            {
+                continue;
+            }
+            if (skip)
+            {
+                maxSteeringError = std::max(maxSteeringError, std::fabs(last.steering - actual[i].steering));
+                maxThrottleError = std::max(maxThrottleError, std::fabs(last.throttle - actual[i].throttle));
+            }
+            else
+            {
+                last = actual[i];
+            }
+        }
+
+        std::cout << "  threshold " << std::setw(6) << text << ": skipped " << detector.SkippedCount() << " / "
+                  << detector.FrameCount() << " (" << detector.SkipRate() * 100.0 << " %)";
+        if (!actual.empty())
+        {
+            double savedMs = detector.SkippedCount() * inferenceMs - frames.size() * kernelNs / 1e6;
+            std::cout << ", saved " << savedMs / frames.size() << " ms/frame, max reuse error steering "
+                      << maxSteeringError << " throttle " << maxThrottleError;
+        }
+        std::cout << std::endl;
+    }
+    return EXIT_SUCCESS;
+}
+
+int RunRemote(const std::string& modelPath, const std::map<std::string, std::string>& args)
+{
+    const int iterations = std::max(1, std::atoi(ArgOr(args, "iterations", "500").c_str()));
+    const size_t requests = std::max<size_t>(2, std::strtoul(ArgOr(args, "requests", "4").c_str(), nullptr, 10));
+
+    InferenceOptions options;
+    options.remoteAddress = ArgOr(args, "address", options.remoteAddress);
+    options.remoteDeadlineMs = std::atof(ArgOr(args, "deadline", "50").c_str());
+    options.remoteFallback = ArgOr(args, "fallback", DefaultInferenceBackend());
+
+    std::vector<std::vector<uint8_t>> frames =
+        args.count("frames") ? LoadRecordedFrames(args.at("frames"), "remote") : MakeRandomFrames(64, 5);
+
+    auto measure = [&](InferenceBackend& engine, std::vector<std::vector<float>>& outputs) {
+        std::vector<double> latencies;
+        for (int i = 0; i < iterations; ++i)
+        {
+            auto start = Clock::now();
+            engine.setInputData(frames[i % frames.size()]);
+            outputs[i] = engine.runInference();
+            latencies.push_back(std::chrono::duration<double, std::milli>(Clock::now() - start).count());
+        }
+        std::sort(latencies.begin(), latencies.end());
+        return latencies;
+    };
+
+    std::cout << "remote: model " << modelPath << ", server " << options.remoteAddress << ", deadline "
+              << options.remoteDeadlineMs << " ms, " << iterations << " frames" << std::endl;
+
+    // 기준: 로컬 백엔드 동기 추론
+    auto local = CreateInferenceBackend(options.remoteFallback, modelPath, "CPU", options);
+    std::vector<std::vector<float>> localOutputs(iterations);
+    std::vector<double> localLatencies = measure(*local, localOutputs);
+
+    // 원격: 연결은 백그라운드에서 맺으므로 잠시 기다린 뒤 몇 프레임으로 예열한다 (예열도 통계에 포함된다).
+    auto remote = CreateInferenceBackend("remote", modelPath, "CPU", options);
+    std::this_thread::sleep_for(std::chrono::milliseconds(700));
+    for (int i = 0; i < 5; ++i)
+    {
+        remote->setInputData(frames[0]);
+        remote->runInference();
+    }
+    std::vector<std::vector<float>> remoteOutputs(iterations);
+    std::vector<double> remoteLatencies = measure(*remote, remoteOutputs);
+
+    // 파이프라인: requests개를 동시에 보내 둔다.
+    remote->enableAsync(requests);
+    std::vector<std::vector<float>> pipelinedOutputs(iterations);
+    std::vector<char> fellBack(iterations, 0);
+    auto pipelineStart = Clock::now();
+    for (int i = 0; i < iterations; ++i)
+    {
+        remote->submitAsync(frames[i % frames.size()], [&, i](const InferenceBackend::AsyncResult& result) {
+            pipelinedOutputs[i] = result.output;
+            fellBack[i] = result.fallback ? 1 : 0;
+        });
+    }
+    remote->waitAll();
+    double pipelineSeconds = std::chrono::duration<double>(Clock::now() - pipelineStart).count();
+
+    // 원격 결과와 로컬 결과의 차이 (서버 모델이 같더라도 프레임워크가 달라 약간의 차이는 정상)
+    double maxDiff = 0.0;
+    size_t remoteCount = 0;
+    for (int i = 0; i < iterations; ++i)
+    {
+        if (fellBack[i] || pipelinedOutputs[i].size() != localOutputs[i].size())
+        {
+            continue;
+        }
+        ++remoteCount;
+        for (size_t j = 0; j < localOutputs[i].size(); ++j)
+        {
+            maxDiff = std::max(maxDiff, static_cast<double>(std::fabs(pipelinedOutputs[i][j] - localOutputs[i][j])));
+        }
+    }
+
+    std::cout << std::fixed << std::setprecision(3);
+    std::cout << "  local  " << std::setw(16) << local->name() << ": p50 " << Percentile(localLatencies, 50)
+              << " ms, p99 " << Percentile(localLatencies, 99) << " ms" << std::endl;
+    std::cout << "  remote " << std::setw(16) << "sync" << ": p50 " << Percentile(remoteLatencies, 50)
+              << " ms, p99 " << Percentile(remoteLatencies, 99) << " ms" << std::endl;
+    std::cout << "  remote " << std::setw(16) << ("pipelined x" + std::to_string(requests)) << ": "
+              << iterations / pipelineSeconds << " frames/s, " << remoteCount << "/" << iterations
+              << " remote results, max diff vs local " << maxDiff << std::endl;
+    std::cout.unsetf(std::ios::floatfield);
+    std::cout << "  " << remote->latencyReport() << std::endl;
+    return EXIT_SUCCESS;
+}
+
+int RunAllocs(const std::string& modelPath, const std::map<std::string, std::string>& args)
+{
+    using namespace calc::aa;
+
+    const int iterations = std::max(1, std::atoi(ArgOr(args, "iterations", "500").c_str()));
+    const std::string backend = ArgOr(args, "backend", DefaultInferenceBackend());
+    std::vector<std::vector<uint8_t>> frames = args.count("frames") ? LoadRecordedFrames(args.at("frames"), "allocs") : MakeRandomFrames(16, 5);
+
+    // Calc와 같이 메타데이터가 없으면 기존 매핑으로 변환한다.
+    bool hasMetadata = false;
+    ActionDecoder decoder(ModelMetadata::LoadOrBaseline(ModelMetadata::DefaultPath(modelPath), hasMetadata));
+    auto engine = CreateInferenceBackend(backend, modelPath, "CPU");
+
+    // Calc와 같은 구성: 수신 스레드가 게시한 프레임을 추론 스레드가 가져가 Calc와 같은 FrameInference로 추론하고
+    // ControlData 값으로 변환한다. 포트 쓰기(Calc::PublishControl)는 AUTOSAR 런타임이 필요해 배열에 기록하는 것으로 대신한다
+    // (Calc의 프레임 경로에는 프레임마다 만드는 로그가 없다).
+    FrameMailbox mailbox(kStereoFrameSize);
+    FrameInference inference;
+    inference.Configure(2.0f, 2);
+    DeadlineMonitor monitor;
+    DeadlineMonitor::Settings settings;
+    settings.deadline = std::chrono::milliseconds(100);
+    monitor.Configure(settings);
+    std::array<float, 2> published = {0.0f, 0.0f};
+
+    auto framePath = [&](size_t i) {
+        // Calc::OnReceiveREvent
+        mailbox.Publish(frames[i % frames.size()].data(), kStereoFrameSize);
+        // Calc::TaskInferenceCyclic
+        const std::vector<uint8_t>* frame = nullptr;
+        uint64_t skipped = 0;
+        if (!mailbox.TryTake(frame, skipped))
+        {
+            return;
+        }
+        DeadlineMonitor::Event event;
+        monitor.UseFallback(Clock::now(), event);
+        ControlCommand command;
+        if (inference.Process(*frame, 1, *engine, decoder, command) != FrameInference::Outcome::Inferred)
+        {
+            return;
+        }
+        published = {command.steering, command.throttle};
+        monitor.Record(false, mailbox.TakenPublishTime(), Clock::now());
+    };
+
+    // 이전 방식: 샘플 복사 -> 값으로 전달 -> 새 출력 벡터
+    auto copyingPath = [&](size_t i) {
+        std::vector<uint8_t> sample = frames[i % frames.size()];
+        auto process = [&](std::vector<uint8_t> input) {
+            engine->setInputData(input);
+            return engine->runInference();
+        };
+        std::vector<float> result = process(sample);
+        ControlCommand command = decoder.Decode(result.data());
+        published = {command.steering, command.throttle};
+    };
+
+    auto measure = [&](auto&& path, uint64_t& allocations, uint64_t& bytes) {
+        for (size_t i = 0; i < 20; ++i)
+        {
+            path(i);
+        }
+        const uint64_t startCount = g_allocations.load();
+        const uint64_t startBytes = g_allocatedBytes.load();
+        for (int i = 0; i < iterations; ++i)
+        {
+            path(static_cast<size_t>(i));
+        }
+        allocations = g_allocations.load() - startCount;
+        bytes = g_allocatedBytes.load() - startBytes;
+    };
+
+    uint64_t copyingAllocations = 0;
+    uint64_t copyingBytes = 0;
+    uint64_t allocations = 0;
+    uint64_t bytes = 0;
+    measure(copyingPath, copyingAllocations, copyingBytes);
+    measure(framePath, allocations, bytes);
+
+    std::cout << "allocs: " << engine->name() << (hasMetadata ? "" : " (no model_metadata.json, baseline mapping)") << ", "
+              << iterations << " frames after warm-up, change detector skipped " << inference.Detector().SkippedCount() << std::endl;
+    std::cout << "  copying path:                    " << static_cast<double>(copyingAllocations) / iterations << " allocations, "
+              << copyingBytes / iterations << " bytes per frame" << std::endl;
+    std::cout << "  frame path (without port write): " << static_cast<double>(allocations) / iterations << " allocations, "
+              << bytes / iterations << " bytes per frame (last command " << published[0] << ", " << published[1] << ")" << std::endl;
+    if (allocations != 0)
+    {
+        std::cerr << "allocs: steady-state frame path allocated " << allocations << " times" << std::endl;
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
+
+int RunTune(const std::string& modelPath, const std::map<std::string, std::string>& args)
+{
+    using namespace calc::aa;
+
+    const size_t cores = std::max(1u, std::thread::hardware_concurrency());
+
+    ThreadTuneRequest request;
+    request.backend = ArgOr(args, "backend", DefaultInferenceBackend());
+    request.modelPath = modelPath;
+    request.deviceName = "CPU";
+    request.cpuBudget = std::max<size_t>(1, std::strtoul(ArgOr(args, "budget", std::to_string(std::max<size_t>(1, cores - 1))).c_str(), nullptr, 10));
+    request.asyncRequests = std::strtoul(ArgOr(args, "requests", "0").c_str(), nullptr, 10);
+    request.iterations = std::max(1, std::atoi(ArgOr(args, "iterations", "30").c_str()));
+
+    std::cout << "tune: " << request.backend << ", " << MachineId() << ", CPU budget " << request.cpuBudget << ", "
+              << (request.asyncRequests >= 2 ? "pipeline ms/frame with " + std::to_string(request.asyncRequests) + " requests"
+                                             : std::string("sync p90 ms")) << std::endl;
+    auto start = Clock::now();
+    std::vector<ThreadTuneResult> results = RunThreadTune(request);
+    const double tuneMs = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+    const size_t pick = PickThreadTune(results);
+
+    std::cout << std::fixed << std::setprecision(2);
+    for (size_t i = 0; i < results.size(); ++i)
+    {
+        std::cout << (i == pick ? "* " : "  ") << std::left << std::setw(34) << results[i].config.ToString() << std::right;
+        if (results[i].ok)
+        {
+            std::cout << std::setw(10) << results[i].scoreMs << " ms  (load " << results[i].loadMs << " ms)" << std::endl;
+        }
+        else
+        {
+            std::cout << "  failed: " << results[i].error << std::endl;
+        }
+    }
+    std::cout << "tune: " << results.size() << " candidates in " << tuneMs << " ms" << std::endl;
+    if (request.backend.compare(0, 6, "native") == 0)
+    {
+        std::cout << "tune: native backends are single-threaded, differences are measurement noise" << std::endl;
+    }
+    return pick == results.size() ? EXIT_FAILURE : EXIT_SUCCESS;
+}
+
+int RunProfile(const std::string& modelPath, const std::map<std::string, std::string>& args)
+{
+    const int iterations = std::max(1, std::atoi(ArgOr(args, "iterations", "200").c_str()));
+    std::vector<std::vector<uint8_t>> frames = args.count("frames") ? LoadRecordedFrames(args.at("frames"), "profile") : MakeRandomFrames(16, 5);
+
+    InferenceOptions options;
+    options.profiling = true;
+    options.profileWindow = static_cast<size_t>(iterations);
+    auto engine = CreateInferenceBackend(ArgOr(args, "backend", DefaultInferenceBackend()), modelPath, "CPU", options);
+    for (int i = 0; i < iterations; ++i)
+    {
+        engine->setInputData(frames[i % frames.size()]);
+        engine->runInference();
+    }
+
+    std::vector<InferenceBackend::LayerTiming> layers = engine->layerProfile();
+    if (layers.empty())
+    {
+        std::cerr << "profile: backend " << engine->name() << " does not report layer timings" << std::endl;
+        return EXIT_FAILURE;
+    }
+    std::cout << "profile: " << engine->name() << ", " << layers.size() << " layer(s)" << std::endl;
+    std::cout << calc::aa::FormatLayerProfileTable(layers) << std::endl;
+    if (args.count("json"))
+    {
+        std::ofstream file(args.at("json"));
+        file << calc::aa::LayerProfileJson(layers, engine->name()) << "\n";
+        if (!file)
+        {
+            std::cerr << "profile: cannot write " << args.at("json") << std::endl;
+            return EXIT_FAILURE;
+        }
+        std::cout << "profile: JSON written to " << args.at("json") << std::endl;
+    }
+    return EXIT_SUCCESS;
+}
+
+void PrintUsage()
+{
+    std::cerr << "usage: calc_bench preprocess [iterations]" << std::endl;
+    std::cerr << "       calc_bench precision <model.xml> [iterations]" << std::endl;
+    std::cerr << "       calc_bench backends <model.xml> [iterations]" << std::endl;
+    std::cerr << "       calc_bench latency <model.xml> [--backend name] [--frames recording.bin] [--iterations N]" << std::endl;
+    std::cerr << "                          [--threads n,n,...] [--precision FP32,U8] [--max-p99 ms]" << std::endl;
+    std::cerr << "       calc_bench changes <recording.bin> [--threshold t,t,...] [--max-skips N] [--model model.xml]" << std::endl;
+    std::cerr << "       calc_bench remote <model.xml> [--address host:port] [--frames recording.bin] [--iterations N]" << std::endl;
+    std::cerr << "                         [--requests N] [--deadline ms] [--fallback name]" << std::endl;
+    std::cerr << "       calc_bench allocs <model.xml> [--backend name] [--frames recording.bin] [--iterations N]" << std::endl;
+    std::cerr << "       calc_bench tune <model.xml> [--backend name] [--budget N] [--requests N] [--iterations N]" << std::endl;
+    std::cerr << "       calc_bench profile <model.xml> [--backend name] [--frames recording.bin] [--iterations N] [--json path]" << std::endl;
+}
+
+// 모델 로드/추론 오류(std::exception)를 모드 이름과 함께 출력하고 실패로 끝낸다 (모델을 쓰는 모든 모드 공용).
+template <typename F>
+int RunMode(const std::string& mode, F&& run)
+{
+    try
+    {
+        return run();
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << mode << ": " << e.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    if (argc < 2)
+    {
+        PrintUsage();
+        return EXIT_FAILURE;
+    }
+
+    std::string mode = argv[1];
+    if (mode == "preprocess")
+    {
+        int iterations = (argc > 2) ? std::atoi(argv[2]) : 10000;
+        return RunPreprocess(std::max(1, iterations));
+    }
+    if (mode == "precision" && argc > 2)
+    {
+        int iterations = (argc > 3) ? std::atoi(argv[3]) : 200;
+        return RunMode(mode, [&] { return RunPrecision(argv[2], std::max(1, iterations)); });
+    }
+    if (mode == "backends" && argc > 2)
+    {
+        int iterations = (argc > 3) ? std::atoi(argv[3]) : 200;
+        return RunMode(mode, [&] { return RunBackends(argv[2], std::max(1, iterations)); });
+    }
+    if ((mode == "latency" || mode == "remote" || mode == "changes" || mode == "allocs" ||
+         mode == "tune" || mode == "profile") && argc > 2)
+    {
+        std::map<std::string, std::string> args;
+        for (int i = 3; i + 1 < argc; i += 2)
+        {
+            std::string key = argv[i];
+            if (key.compare(0, 2, "--") != 0)
+            {
+                PrintUsage();
+                return EXIT_FAILURE;
+            }
+            args[key.substr(2)] = argv[i + 1];
+        }
+        return RunMode(mode, [&] {
+            if (mode == "changes")
+            {
+                return RunChanges(argv[2], args);
+            }
+            if (mode == "allocs")
+            {
+                return RunAllocs(argv[2], args);
+            }
+            if (mode == "tune")
+            {
+                return RunTune(argv[2], args);
+            }
+            if (mode == "profile")
+            {
+                return RunProfile(argv[2], args);
+            }
+            return (mode == "latency") ? RunLatency(argv[2], args) : RunRemote(argv[2], args);
+        });
+    }
+
+    PrintUsage();
+    return EXIT_FAILURE;
+}
@@ -0,0 +1,283 @@
+// Calc 오프라인 배치 평가 (AUTOSAR 런타임 없이 단독 실행)
+//
+// 사용법:
+//   calc_eval <model.xml> <recording.bin> <output.csv> [옵션]
+//     - 녹화 파일(38400바이트 스테레오 프레임을 이어 붙인 것)을 메모리 매핑해 batch개씩 추론하고,
+//       Calc와 같은 변환(ActionDecoder, model_metadata.json)을 적용한 프레임별 조향/스로틀을 CSV로 기록한다.
+//     - 처리량 모드: 여러 요청을 동시에 실행해 코어 수에 비례해 빨라진다.
+//       --backend <이름>   추론 백엔드 (기본: 빌드 기본값)
+//       --metadata <경로>  model_metadata.json (기본: 모델과 같은 디렉토리)
+//       --batch <N>        한 요청에 넣을 프레임 수 (기본 8)
+//       --streams <N>      OpenVINO CPU 스트림 수 (기본: 하드웨어 스레드 수)
+//       --requests <N>     동시에 실행할 요청 수 (기본: 스트림 수, native 백엔드는 워커 스레드 수)
+#include "calc/aa/action_decoder.h"
+#include "calc/aa/inference_backend.h"
+#include "calc/aa/stereo_preprocess.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+
+using Clock = std::chrono::steady_clock;
+
+// 읽기 전용 메모리 매핑 (수천 프레임짜리 녹화도 한 번에 읽지 않고 페이지 단위로 가져온다)
+class MappedRecording
+{
+public:
+    explicit MappedRecording(const std::string& path)
+    {
+        m_fd = ::open(path.c_str(), O_RDONLY);
+        if (m_fd < 0)
+        {
+            throw std::runtime_error("cannot open " + path);
+        }
+        struct stat st;
+        if (::fstat(m_fd, &st) != 0 || st.st_size <= 0)
+        {
+            ::close(m_fd);
+            throw std::runtime_error("cannot stat " + path + " or file is empty");
+        }
+        m_size = static_cast<size_t>(st.st_size);
+        void* data = ::mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, m_fd, 0);
+        if (data == MAP_FAILED)
+        {
+            ::close(m_fd);
+            throw std::runtime_error("cannot mmap " + path);
+        }
+        ::madvise(data, m_size, MADV_SEQUENTIAL);
+        m_data = static_cast<const uint8_t*>(data);
+    }
+
+    ~MappedRecording()
+    {
+        ::munmap(const_cast<uint8_t*>(m_data), m_size);
+        ::close(m_fd);
+    }
+
+    MappedRecording(const MappedRecording&) = delete;
+    MappedRecording& operator=(const MappedRecording&) = delete;
+
+    size_t FrameCount() const
+    {
+        return m_size / calc::aa::kStereoFrameSize;
+    }
+
+    size_t TrailingBytes() const
+    {
+        return m_size % calc::aa::kStereoFrameSize;
+    }
+
+    const uint8_t* Frame(size_t index) const
+    {
+        return m_data + index * calc::aa::kStereoFrameSize;
+    }
+
+private:
+    int m_fd = -1;
+    const uint8_t* m_data = nullptr;
+    size_t m_size = 0;
+};
+
+void PrintUsage()
+{
+    std::cerr << "usage: calc_eval <model.xml> <recording.bin> <output.csv> [--backend name] [--metadata path]" << std::endl;
+    std::cerr << "                 [--batch N] [--streams N] [--requests N]" << std::endl;
+}
+
+int RunEval(const std::string& modelPath, const std::string& recordingPath, const std::string& csvPath,
+            const std::map<std::string, std::string>& args)
+{
+    using calc::aa::kStereoFrameSize;
+
+    auto arg = [&](const std::string& key, size_t defaultValue) {
+        auto it = args.find(key);
+        return it == args.end() ? defaultValue : static_cast<size_t>(std::strtoul(it->second.c_str(), nullptr, 10));
+    };
+    auto it = args.find("backend");
+    const std::string backend = (it == args.end()) ? DefaultInferenceBackend() : it->second;
+    it = args.find("metadata");
+    const std::string metadataPath = (it == args.end()) ? calc::aa::ModelMetadata::DefaultPath(modelPath) : it->second;
+    // Calc와 같이 메타데이터가 없으면 기존 매핑으로 평가한다.
+    bool hasMetadata = false;
+    const calc::aa::ModelMetadata metadata = calc::aa::ModelMetadata::LoadOrBaseline(metadataPath, hasMetadata);
+    if (!hasMetadata)
+    {
+        std::cerr << "calc_eval: " << metadataPath << " not found, using the baseline continuous mapping" << std::endl;
+    }
+    const calc::aa::ActionDecoder decoder(metadata);
+    const size_t outputs = decoder.OutputSize();
+    const size_t hardwareThreads = std::max(1u, std::thread::hardware_concurrency());
+
+    InferenceOptions options;
+    options.batch = std::max<size_t>(1, arg("batch", 8));
+    options.streams = std::max<size_t>(1, arg("streams", hardwareThreads));
+    const size_t requests = std::max<size_t>(1, arg("requests", options.streams));
+
+    MappedRecording recording(recordingPath);
+    const size_t frameCount = recording.FrameCount();
+    if (frameCount == 0)
+    {
+        throw std::runtime_error(recordingPath + " has no complete " + std::to_string(kStereoFrameSize) + "-byte frame");
+    }
+    if (recording.TrailingBytes() != 0)
+    {
+        std::cerr << "calc_eval: ignoring trailing " << recording.TrailingBytes() << " bytes of " << recordingPath << std::endl;
+    }
+
+    auto loadStart = Clock::now();
+    auto engine = CreateInferenceBackend(backend, modelPath, "CPU", options);
+    if (requests >= 2)
+    {
+        engine->enableAsync(requests);
+    }
+    double loadMs = std::chrono::duration<double, std::milli>(Clock::now() - loadStart).count();
+
+    std::cout << "calc_eval: " << frameCount << " frames, backend " << engine->name() << ", batch " << options.batch
+              << ", streams " << options.streams << ", requests " << (engine->isAsync() ? requests : 1)
+              << ", model loaded in " << loadMs << " ms" << std::endl;
+    std::cout << "calc_eval: " << metadataPath << " : " << decoder.Description() << std::endl;
+
+    // 프레임별 네트워크 출력 (outputs개씩). 콜백은 서로 다른 구간에만 쓰므로 잠금이 필요 없다.
+    std::vector<float> raw(frameCount * outputs, 0.0f);
+    std::atomic<size_t> failedBatches{0};
+    std::mutex errorMutex;
+    std::string firstError; // 처음 실패한 비동기 배치의 이유
+
+    auto store = [&](size_t start, size_t count, const std::vector<float>& output) {
+        if (output.size() != options.batch * outputs)
+        {
+            failedBatches.fetch_add(1);
+            return;
+        }
+        std::copy(output.begin(), output.begin() + count * outputs, raw.begin() + start * outputs);
+    };
+
+    auto runStart = Clock::now();
+    std::vector<uint8_t> batch(options.batch * kStereoFrameSize);
+    for (size_t start = 0; start < frameCount; start += options.batch)
+    {
+        // 마지막 배치가 모자라면 마지막 프레임을 반복해 채우고, 채운 프레임의 결과는 버린다.
+        const size_t count = std::min(options.batch, frameCount - start);
+        for (size_t i = 0; i < options.batch; ++i)
+        {
+            std::memcpy(batch.data() + i * kStereoFrameSize, recording.Frame(start + std::min(i, count - 1)), kStereoFrameSize);
+        }
+
+        if (engine->isAsync())
+        {
+            engine->submitAsync(batch, [&, start, count](const InferenceBackend::AsyncResult& result) {
+                if (!result.ok)
+                {
+                    failedBatches.fetch_add(1);
+                    std::lock_guard<std::mutex> lock(errorMutex);
+                    if (firstError.empty())
+                    {
+                        firstError = result.error;
+                    }
+                    return;
+                }
+                store(start, count, result.output);
+            });
+        }
+        else
+        {
+            engine->setInputData(batch);
+            store(start, count, engine->runInference());
+        }
+    }
+    engine->waitAll();
+    double runSeconds = std::chrono::duration<double>(Clock::now() - runStart).count();
+
+    std::ofstream csv(csvPath);
+    if (!csv)
+    {
+        throw std::runtime_error("cannot write " + csvPath);
+    }
+    // 네트워크 출력 열: continuous는 steering_raw, throttle_raw / discrete는 행동별 action_<i>
+    csv << "frame";
+    if (metadata.actionSpaceType == calc::aa::ActionSpaceType::Continuous)
+    {
+        csv << ",steering_raw,throttle_raw";
+    }
+    else
+    {
+        for (size_t j = 0; j < outputs; ++j)
+        {
+            csv << ",action_" << j;
+        }
+    }
+    csv << ",steering,throttle\n";
+    for (size_t i = 0; i < frameCount; ++i)
+    {
+        const float* output = raw.data() + i * outputs;
+        const calc::aa::ControlCommand command = decoder.Decode(output);
+        csv << i;
+        for (size_t j = 0; j < outputs; ++j)
+        {
+            csv << ',' << output[j];
+        }
+        csv << ',' << command.steering << ',' << command.throttle << '\n';
+    }
+
+    std::cout << "calc_eval: " << frameCount << " frames in " << runSeconds << " s (" << frameCount / runSeconds
+              << " frames/s), results written to " << csvPath << std::endl;
+    if (failedBatches.load() > 0)
+    {
+        std::cerr << "calc_eval: " << failedBatches.load() << " batch(es) failed, their rows are zero"
+                  << (firstError.empty() ? std::string() : " (first error: " + firstError + ")") << std::endl;
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    if (argc < 4 || (argc - 4) % 2 != 0)
+    {
+        PrintUsage();
+        return EXIT_FAILURE;
+    }
+
+    std::map<std::string, std::string> args;
+    for (int i = 4; i + 1 < argc; i += 2)
+    {
+        std::string key = argv[i];
+        if (key.compare(0, 2, "--") != 0)
+        {
+            PrintUsage();
+            return EXIT_FAILURE;
+        }
+        args[key.substr(2)] = argv[i + 1];
+    }
+
+    try
+    {
+        return RunEval(argv[1], argv[2], argv[3], args);
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << "calc_eval: " << e.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+}
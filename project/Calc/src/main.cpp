@@ -26,9 +26,15 @@ calc::aa::Calc* g_swcCalc{nullptr};
  
 static void SignalHandler(std::int32_t signal)
 {
-    if (signal == SIGTERM || signal == SIGINT)
+    if ((signal == SIGTERM || signal == SIGINT) && g_swcCalc != nullptr)
     {
-        g_swcCalc->Terminate();
+        // 핸들러에서는 요청만 하고, 정리(엔진 대기, 스레드 join)는 swcCalc.Start()를 호출한 메인 스레드가 한다.
+        g_swcCalc->RequestStop();
+    }
+    else if (signal == SIGUSR1 && g_swcCalc != nullptr)
+    {
+        // 레이어별 추론 시간 내보내기 (CALC_PROFILE=1일 때)
+        g_swcCalc->RequestProfileDump();
     }
 }
  
@@ -52,6 +58,7 @@ int main(int argc, char *argv[], char* envp[])
         // regist signals
         std::signal(SIGTERM, SignalHandler);
         std::signal(SIGINT, SignalHandler);
+        std::signal(SIGUSR1, SignalHandler);
         
         // declaration of software components
         calc::aa::Calc swcCalc;
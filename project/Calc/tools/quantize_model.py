@@ -0,0 +1,166 @@
+# DeepRacer 정책 네트워크 INT8 후처리 양자화(Post-Training Quantization) 도구
+#
+# Sensor가 저장한 스테레오 프레임을 보정(calibration) 데이터로 사용해 FP32 IR을 INT8 IR로 변환하고,
+# FP32 대비 steering / throttle 출력 차이를 보고한다 (continuous action space 모델 기준). 결과 IR은 CALC_MODEL_PATH로 Calc에서 바로 로드할 수 있다.
+#
+# 필요 환경: OpenVINO 2021.4 (Inference Engine Python API + Post-Training Optimization Tool)
+#   source /opt/intel/openvino_2021/bin/setupvars.sh
+#
+# 사용법:
+#   python3 quantize_model.py --model model.xml --frames /home/ubuntu/test_socket_AA_data --output int8/
+#
+# 보정 데이터 형식 (--frames 디렉터리):
+#   - Sensor::save_camera_data가 저장하는 left_<timestamp>.png / right_<timestamp>.png 쌍
+#   - 또는 Sensor가 REvent로 보내는 그대로의 38400 바이트 프레임(좌측 평면 + 우측 평면)을 담은 *.bin 파일
+import argparse
+import glob
+import os
+import sys
+
+import numpy as np
+
+try:
+    from openvino.inference_engine import IECore
+    from openvino.tools.pot import DataLoader, IEEngine, load_model, save_model, compress_model_weights, create_pipeline
+except ImportError as e:
+    sys.exit(f"OpenVINO 2021.4 Python API / POT를 찾을 수 없습니다 (setupvars.sh 확인): {e}")
+
+HEIGHT = 120
+WIDTH = 160
+PLANE_SIZE = HEIGHT * WIDTH
+FRAME_SIZE = PLANE_SIZE * 2
+
+
+def planar_to_input(frame):
+    # Calc와 같은 배치: 좌/우 평면을 (1, 120, 160, 2)로 인터리브, 채널 0 = 좌측
+    left = frame[:PLANE_SIZE].reshape(HEIGHT, WIDTH)
+    right = frame[PLANE_SIZE:].reshape(HEIGHT, WIDTH)
+    return np.stack([left, right], axis=-1)[np.newaxis].astype(np.float32)
+
+
+def load_frames(frame_dir):
+    frames = []
+
+    for path in sorted(glob.glob(os.path.join(frame_dir, "*.bin"))):
+        data = np.fromfile(path, dtype=np.uint8)
+        if data.size % FRAME_SIZE != 0:
+            print(f"skip {path}: size {data.size} is not a multiple of {FRAME_SIZE}")
+            continue
+        frames.extend(data.reshape(-1, FRAME_SIZE))
+
+    left_images = sorted(glob.glob(os.path.join(frame_dir, "left_*.png")))
+    if left_images:
+        import cv2
+        for left_path in left_images:
+            # 디렉터리 이름에 left_가 들어 있을 수 있으므로 파일 이름만 바꾼다.
+            right_name = os.path.basename(left_path).replace("left_", "right_", 1)
+            right_path = os.path.join(os.path.dirname(left_path), right_name)
+            if not os.path.exists(right_path):
+                continue
+            left = cv2.imread(left_path, cv2.IMREAD_GRAYSCALE)
+            right = cv2.imread(right_path, cv2.IMREAD_GRAYSCALE)
+            if left is None or right is None or left.shape != (HEIGHT, WIDTH) or right.shape != (HEIGHT, WIDTH):
+                continue
+            frames.append(np.concatenate([left.reshape(-1), right.reshape(-1)]))
+
+    return frames
+
+
+class StereoFrameLoader(DataLoader):
+    def __init__(self, frames):
+        super().__init__(config={})
+        self._frames = frames
+
+    def __len__(self):
+        return len(self._frames)
+
+    def __getitem__(self, index):
+        # 정확도 측정 없이 통계만 수집하므로 annotation은 없다.
+        return (index, None), planar_to_input(self._frames[index])
+
+
+def map_steering(value):
+    # calc/aa/control_mapping.h MapSteering 과 동일
+    return np.clip(value, -1.0, 1.0)
+
+
+def map_throttle(value):
+    # calc/aa/control_mapping.h MapThrottle 과 동일
+    x = np.abs(value)
+    return np.clip(-0.133333 * x * x + 0.733333 * x, 0.0, 1.0)
+
+
+def run_network(ie, xml_path, frames):
+    net = ie.read_network(model=xml_path, weights=os.path.splitext(xml_path)[0] + ".bin")
+    input_name = next(iter(net.input_info))
+    output_name = next(iter(net.outputs))
+    exec_net = ie.load_network(network=net, device_name="CPU", num_requests=1)
+    outputs = []
+    for frame in frames:
+        result = exec_net.infer({input_name: planar_to_input(frame)})
+        outputs.append(result[output_name].reshape(-1)[:2])
+    return np.array(outputs)
+
+
+def report_drift(fp32, int8):
+    # continuous action space(출력 2개 = 조향, 스로틀)를 가정한다.
+    # discrete 모델은 Calc에서 ActionDecoder가 행동 확률의 최댓값으로 변환하므로 이 표의 cmd 행과 다르다.
+    print(f"{'':10s} {'mean |d|':>10s} {'p99 |d|':>10s} {'max |d|':>10s}")
+    rows = [
+        ("steering", fp32[:, 0], int8[:, 0]),
+        ("throttle", fp32[:, 1], int8[:, 1]),
+        ("steer cmd", map_steering(fp32[:, 0]), map_steering(int8[:, 0])),
+        ("thr cmd", map_throttle(fp32[:, 1]), map_throttle(int8[:, 1])),
+    ]
+    for name, a, b in rows:
+        d = np.abs(a - b)
+        print(f"{name:10s} {d.mean():10.5f} {np.percentile(d, 99):10.5f} {d.max():10.5f}")
+
+
+def main():
+    parser = argparse.ArgumentParser(description="INT8 post-training quantization for the DeepRacer policy network")
+    parser.add_argument("--model", required=True, help="FP32 IR (.xml), weights (.bin) must be next to it")
+    parser.add_argument("--frames", required=True, help="directory with recorded stereo frames")
+    parser.add_argument("--output", required=True, help="output directory for the INT8 IR")
+    parser.add_argument("--name", default="model_int8", help="output model name")
+    parser.add_argument("--subset", type=int, default=300, help="number of frames used for statistics")
+    parser.add_argument("--preset", default="performance", choices=["performance", "mixed"])
+    args = parser.parse_args()
+
+    frames = load_frames(args.frames)
+    if not frames:
+        sys.exit(f"no calibration frames found in {args.frames}")
+    print(f"calibration frames: {len(frames)}")
+
+    model_config = {
+        "model_name": args.name,
+        "model": args.model,
+        "weights": os.path.splitext(args.model)[0] + ".bin",
+    }
+    engine_config = {"device": "CPU", "stat_requests_number": 1, "eval_requests_number": 1}
+    algorithms = [{
+        "name": "DefaultQuantization",
+        "params": {
+            "target_device": "CPU",
+            "preset": args.preset,
+            "stat_subset_size": min(args.subset, len(frames)),
+        },
+    }]
+
+    model = load_model(model_config)
+    engine = IEEngine(config=engine_config, data_loader=StereoFrameLoader(frames), metric=None)
+    pipeline = create_pipeline(algorithms, engine)
+    compressed = pipeline.run(model)
+    compress_model_weights(compressed)
+    paths = save_model(compressed, save_path=args.output, model_name=args.name)
+    int8_xml = paths[0]["model"]
+    print(f"INT8 IR written to {int8_xml}")
+
+    ie = IECore()
+    fp32_out = run_network(ie, args.model, frames)
+    int8_out = run_network(ie, int8_xml, frames)
+    report_drift(fp32_out, int8_out)
+
+
+if __name__ == "__main__":
+    main()
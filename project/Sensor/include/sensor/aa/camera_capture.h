@@ -0,0 +1,68 @@
+#ifndef CAMERA_CAPTURE_H
+#define CAMERA_CAPTURE_H
+
+#include "sensor/aa/gray_jpeg_decoder.h"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+namespace sensor
+{
+namespace aa
+{
+
+// 카메라 한 대에서 받은 프레임. data는 같은 캡처 객체의 다음 Grab 호출 전까지만 유효하다.
+struct CapturedFrame
+{
+    enum class Format
+    {
+        Mjpeg, // 카메라가 보낸 JPEG 비트스트림 그대로
+        Bgr,   // OpenCV가 디코딩한 BGR 24bit
+        Gray
+    };
+
+    const uint8_t* data = nullptr;
+    size_t size = 0;
+    Format format = Format::Mjpeg;
+    int width = 0;
+    int height = 0;
+    std::chrono::steady_clock::time_point timestamp; // 캡처 시각 (V4L2는 드라이버가 기록한 시각, 그 외에는 수신 시각)
+    uint32_t sequence = 0;                           // 카메라가 매긴 프레임 순번 (건너뛴 프레임 확인용)
+};
+
+struct CaptureSettings
+{
+    int width = 160;
+    int height = 120;
+    size_t buffers = 2; // V4L2 mmap 버퍼 수
+    size_t fps = 30;
+};
+
+class CameraCapture
+{
+public:
+    virtual ~CameraCapture() = default;
+
+    // 다음 프레임을 기다린다 (timeout 안에 오지 않거나 장치 오류이면 false). 이전 프레임의 버퍼는 여기서 반환된다.
+    virtual bool Grab(CapturedFrame& frame, std::chrono::milliseconds timeout) = 0;
+
+    // 로그용 설명 (예: "v4l2 /dev/video0 MJPG 160x120 x2")
+    virtual std::string Describe() const = 0;
+};
+
+// backend: "auto"(V4L2, 실패하면 OpenCV), "v4l2", "opencv". device가 일반 파일이면 녹화된 MJPEG 스트림을 재생한다.
+// 열지 못하면 nullptr을 반환하고 error에 이유를 남긴다.
+std::unique_ptr<CameraCapture> OpenCameraCapture(const std::string& backend, const std::string& device,
+                                                 const CaptureSettings& settings, std::string& error);
+
+// 프레임을 width x height 8bit 그레이 영상으로 dst에 쓴다 (크기가 다르거나 디코딩에 실패하면 false).
+// MJPEG는 jpeg로 디코딩한다 (디코더는 스레드마다 하나).
+bool DecodeGray(const CapturedFrame& frame, uint8_t* dst, int width, int height, GrayJpegDecoder& jpeg);
+
+} /// namespace aa
+} /// namespace sensor
+
+#endif // CAMERA_CAPTURE_H
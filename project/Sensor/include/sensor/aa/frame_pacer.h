@@ -0,0 +1,97 @@
+#ifndef FRAME_PACER_H
+#define FRAME_PACER_H
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+namespace sensor
+{
+namespace aa
+{
+
+// 카메라 프레임 도착에 맞춘 발행 주기 조절
+//
+// 목표 프레임률이 0이거나 카메라 이상이면 도착한 짝을 모두 발행한다. 더 낮으면 발행 시각을 절대 시각 일정
+// (시작 시각 + k x 주기)으로 관리해 처리 시간이 늘어도 주기가 밀리지 않게 하고, 정책에 따라 프레임을 솎아낸다.
+//   Arrival: 짝이 도착하는 대로 받고, 캡처 시각이 다음 발행 시각에 이른 짝만 발행한다 (추가 대기 없음, 기본)
+//   Timer:   다음 발행 시각까지 자고 깨어나 가장 최근 짝을 발행한다 (발행 간격이 카메라와 무관하게 고르다)
+class FramePacer
+{
+public:
+    using Clock = std::chrono::steady_clock;
+
+    enum class Policy
+    {
+        Arrival,
+        Timer
+    };
+
+    struct Settings
+    {
+        double targetFps = 0.0; // 0이면 카메라 프레임률 그대로
+        double cameraFps = 30.0;
+        Policy policy = Policy::Arrival;
+    };
+
+    // 마지막 TakeStats 이후 발행 간격 통계 (실제로 포트에서 전송된 시각 기준)
+    struct Stats
+    {
+        uint64_t published = 0;
+        uint64_t sendFailures = 0;  // 발행하기로 했지만 포트 전송이 실패한 짝
+        uint64_t decimated = 0;     // 목표 프레임률에 맞추려고 버린 짝
+        uint64_t missedSlots = 0;   // 처리가 늦어 발행 시각을 한 주기 이상 넘긴 횟수 (일정을 현재 시각으로 다시 맞춘다)
+        double achievedFps = 0.0;
+        double meanIntervalMs = 0.0;
+        double jitterMs = 0.0;      // 발행 간격의 표준편차
+        double maxIntervalMs = 0.0;
+        double meanAgeMs = 0.0;     // 캡처부터 전송 완료까지
+        double maxAgeMs = 0.0;
+    };
+
+    FramePacer();
+
+    void Reset(const Settings& settings);
+
+    // 발행 주기 조절이 필요한지 (목표 프레임률이 카메라보다 낮을 때)
+    bool Throttling() const;
+
+    // Timer 정책에서 다음 발행 시각까지 잔다. 다른 경우에는 바로 반환한다.
+    void WaitForSlot();
+
+    // 캡처 시각이 captureTime인 짝을 발행할지 정한다.
+    bool Admit(Clock::time_point captureTime, Clock::time_point now);
+
+    // Admit한 짝의 포트 전송 결과를 기록한다. 성공하면 sentTime을 발행 시각으로 삼아 간격과 캡처 이후 경과 시간을 잰다.
+    void Sent(Clock::time_point captureTime, Clock::time_point sentTime, bool success);
+
+    // 통계를 돌려주고 다음 구간을 위해 비운다.
+    Stats TakeStats();
+
+    static const char* PolicyName(Policy policy);
+
+    // "arrival" 또는 "timer" (그 외에는 false)
+    static bool ParsePolicy(const std::string& text, Policy& policy);
+
+private:
+    void AdvanceDeadline(Clock::time_point reference);
+
+    Settings m_settings;
+    Clock::duration m_period;
+    Clock::duration m_slack;     // 카메라 타임스탬프 흔들림 허용 (카메라 프레임 간격의 절반)
+    bool m_scheduled;
+    Clock::time_point m_deadline; // 다음 발행 시각 (절대 시각)
+
+    Stats m_stats;
+    bool m_published;            // m_lastPublish가 유효한지 (구간을 넘어 간격을 잇는다)
+    Clock::time_point m_lastPublish;
+    uint64_t m_intervals;
+    double m_intervalSumMs;
+    double m_intervalSquareSumMs;
+    double m_ageSumMs;
+};
+
+} /// namespace aa
+} /// namespace sensor
+
+#endif // FRAME_PACER_H
@@ -0,0 +1,57 @@
+#ifndef GRAY_JPEG_DECODER_H
+#define GRAY_JPEG_DECODER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace sensor
+{
+namespace aa
+{
+
+// MJPEG 프레임의 밝기(Y) 성분만 디코딩하는 디코더
+//
+// JPEG의 Y 성분이 곧 그레이 영상이므로 libjpeg에 JCS_GRAYSCALE 출력을 요청해 색차(Cb, Cr) 성분의 역DCT, 업샘플링,
+// 색 변환을 모두 건너뛰고, 출력 행을 호출자 버퍼에 바로 쓴다 (중간 cv::Mat 없음).
+// 원본이 요청 크기의 2/4/8배이면 DCT 축소 디코딩으로 맞춘다. 디코더 상태를 재사용하므로 스레드마다 하나씩 둔다.
+// libjpeg 없이 빌드하면(SENSOR_WITH_LIBJPEG 미정의) cv::imdecode의 그레이 디코딩을 쓴다.
+class GrayJpegDecoder
+{
+public:
+    GrayJpegDecoder();
+    ~GrayJpegDecoder();
+
+    GrayJpegDecoder(const GrayJpegDecoder&) = delete;
+    GrayJpegDecoder& operator=(const GrayJpegDecoder&) = delete;
+
+    // JPEG 하나를 width x height 8bit 그레이로 dst에 쓴다. 크기가 맞지 않거나 손상되었으면 false (이유는 LastError)
+    bool Decode(const uint8_t* data, size_t size, uint8_t* dst, int width, int height);
+
+    const std::string& LastError() const;
+
+    // 로그용 구현 이름 ("libjpeg-luma" 또는 "opencv-gray")
+    static const char* Implementation();
+
+private:
+    struct Impl;
+    std::unique_ptr<Impl> m_impl;
+    std::string m_error;
+};
+
+// JPEG를 이어 붙인 MJPEG 스트림(ffmpeg -f mjpeg, 녹화 파일)의 프레임 위치
+struct JpegFrameSpan
+{
+    size_t offset;
+    size_t size;
+};
+
+// SOI(FFD8)~EOI(FFD9) 표지로 프레임을 나눈다. 엔트로피 부호화 구간에서는 0xFF 뒤에 0xD8/0xD9가 오지 않는다.
+std::vector<JpegFrameSpan> SplitMjpegStream(const uint8_t* data, size_t size);
+
+} /// namespace aa
+} /// namespace sensor
+
+#endif // GRAY_JPEG_DECODER_H
@@ -93,11 +93,17 @@ public:
     /// @brief Write event data to buffer, REvent
     void WriteDataREvent(const deepracer::service::rawdata::skeleton::events::REvent::SampleType& data);
      
+    /// @brief Exchange event data with buffer without copy, REvent (data receives the previous buffer for reuse)
+    void SwapDataREvent(deepracer::service::rawdata::skeleton::events::REvent::SampleType& data);
+     
+    /// @brief Hand data to the event buffer without copy and send it once, REvent (data receives the previous buffer for reuse)
+    bool SendEventREventSwapped(deepracer::service::rawdata::skeleton::events::REvent::SampleType& data);
+     
     /// @brief Send event cyclic from buffer data, REvent
     void SendEventREventCyclic();
      
-    /// @brief Send event directly from buffer data, REvent
-    void SendEventREventTriggered();
+    /// @brief Send event directly from buffer data, REvent (returns false when the send fails)
+    bool SendEventREventTriggered();
      
     /// @brief Send event directly with argument, REvent
     void SendEventREventTriggered(const deepracer::service::rawdata::skeleton::events::REvent::SampleType& data);
@@ -18,6 +18,10 @@
 /// INCLUSION HEADER FILES
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////
 #include "sensor/aa/port/rawdata.h"
+#include "sensor/aa/camera_capture.h"
+#include "sensor/aa/frame_pacer.h"
+#include "sensor/aa/sensor_config.h"
+#include "sensor/aa/stereo_capture.h"
  
 #include "para/swc/port_pool.h"
 
@@ -61,6 +65,8 @@ private:
     void Run();
 
     void TaskGenerateREventValue();
+    void ReportStereo(const char *where);
+    void ReportPacing(const char *where);
 
     void save_data(
     double timestamp,
@@ -85,8 +91,12 @@ private:
     std::chrono::_V2::system_clock::time_point last_save_time;
     std::chrono::seconds save_interval;
 
-    cv::VideoCapture capR;
-    cv::VideoCapture capL;
+    SensorConfig m_config; // 환경 변수로 지정된 실행 옵션
+
+    std::unique_ptr<CameraCapture> capR; // 오른쪽 카메라 (V4L2 직접 캡처 또는 OpenCV, 캡처 시작 시 m_stereo로 넘어간다)
+    std::unique_ptr<CameraCapture> capL; // 왼쪽 카메라
+    StereoCapture m_stereo;              // 카메라별 캡처 스레드와 좌우 짝 맞추기
+    FramePacer m_pacer;                  // 발행 프레임률 조절과 발행 간격 통계
 
     bool m_running;
 
@@ -0,0 +1,50 @@
+#ifndef SENSOR_CONFIG_H
+#define SENSOR_CONFIG_H
+
+#include <cstddef>
+#include <string>
+
+namespace sensor
+{
+namespace aa
+{
+
+// Sensor 실행 옵션
+// 실행 매니페스트(Sensor.json)의 environment-variables 또는 쉘 환경 변수로 지정한다.
+struct SensorConfig
+{
+    // SENSOR_CAPTURE: 카메라 캡처 방식 "auto"(V4L2 직접 캡처, 실패하면 OpenCV), "v4l2" 또는 "opencv"
+    std::string captureBackend = "auto";
+
+    // SENSOR_CAMERA_RIGHT / SENSOR_CAMERA_LEFT: 카메라 장치. 일반 파일을 지정하면 녹화된 MJPEG 스트림(JPEG를 이어 붙인 파일)을
+    // 카메라처럼 반복 재생한다 (카메라 없는 개발 환경용).
+    std::string rightDevice = "/dev/video0";
+    std::string leftDevice = "/dev/video2";
+
+    // SENSOR_CAPTURE_BUFFERS: V4L2 mmap 버퍼 수. 드라이버에 쌓인 프레임만큼 지연이 늘어나므로 작게 유지한다 (최소 2).
+    size_t captureBuffers = 2;
+
+    // SENSOR_CAMERA_FPS: 카메라에 요청할 프레임률 (녹화 파일 재생 속도도 이 값을 따른다)
+    size_t cameraFps = 30;
+
+    // SENSOR_CAPTURE_RING: 카메라별 캡처 스레드의 링 버퍼 프레임 수
+    size_t captureRing = 4;
+
+    // SENSOR_PAIR_TOLERANCE_US: 좌우 프레임을 한 쌍으로 볼 캡처 시각 차이. 0이면 카메라 프레임 간격의 절반
+    size_t pairToleranceUs = 0;
+
+    // SENSOR_TARGET_FPS: Calc로 발행할 프레임률. 0이면 카메라 프레임률 그대로 (도착한 짝을 모두 발행)
+    size_t targetFps = 0;
+
+    // SENSOR_DECIMATION: 목표 프레임률이 카메라보다 낮을 때 짝을 솎아내는 방식
+    //   "arrival": 도착한 짝 중 발행 시각에 이른 것만 바로 발행 (지연 최소), "timer": 발행 시각까지 자고 최신 짝을 발행
+    std::string decimation = "arrival";
+
+    // 환경 변수에서 설정을 읽는다. 지정되지 않았거나 잘못된 값은 기본값을 사용한다.
+    static SensorConfig FromEnvironment();
+};
+
+} /// namespace aa
+} /// namespace sensor
+
+#endif // SENSOR_CONFIG_H
@@ -0,0 +1,124 @@
+#ifndef STEREO_CAPTURE_H
+#define STEREO_CAPTURE_H
+
+#include "sensor/aa/camera_capture.h"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace sensor
+{
+namespace aa
+{
+
+// 좌우 카메라 동시 캡처
+//
+// 카메라마다 캡처 스레드가 프레임을 받아 그레이로 디코딩하고 자기 링 버퍼에 넣는다. NextPair는 두 링에서
+// 캡처 시각 차이가 허용 범위 안인 가장 최근 좌우 프레임을 짝지어 꺼내고, 그보다 오래되었거나 짝이 될 수 없는 프레임은 버린다.
+//
+// 링 칸은 Calc로 보내는 [좌 | 우] 배치 그대로의 스테레오 버퍼(2 x width x height)이고, 디코더는 자기 쪽 절반에 바로 쓴다.
+// 버퍼는 시작할 때 한 번 할당해 캡처 스레드, 링, 호출자(와 발행 포트) 사이에서 교환으로만 오가므로 프레임마다 할당하지 않는다.
+class StereoCapture
+{
+public:
+    using Clock = std::chrono::steady_clock;
+
+    enum Side
+    {
+        kLeft = 0,
+        kRight = 1
+    };
+
+    struct Settings
+    {
+        int width = 160;
+        int height = 120;
+        size_t ringFrames = 4;                     // 카메라별 링 버퍼 크기 (가득 차면 가장 오래된 프레임을 덮어쓴다)
+        std::chrono::microseconds tolerance{16667}; // 좌우 캡처 시각 차이 허용 범위
+    };
+
+    // 짝지은 프레임의 정보
+    struct PairInfo
+    {
+        Clock::time_point timestamp[2]; // 좌, 우 캡처 시각
+        uint32_t sequence[2] = {0, 0};
+        int64_t skewUs = 0;             // 우 - 좌 캡처 시각 (us)
+    };
+
+    struct Stats
+    {
+        uint64_t captured[2] = {0, 0};       // 좌, 우 디코딩까지 끝난 프레임
+        uint64_t failures[2] = {0, 0};       // 캡처 제한 시간 초과 또는 디코딩 실패
+        uint64_t consecutiveFailures[2] = {0, 0}; // 지금까지 이어진 실패 (0이면 마지막 캡처 성공)
+        uint64_t unpairedDrops[2] = {0, 0};  // 상대 카메라에 허용 범위 안의 프레임이 없어 버린 프레임
+        uint64_t skipped[2] = {0, 0};        // 더 최신 짝에 밀려 쓰지 않은 프레임 (소비가 카메라보다 느릴 때)
+        uint64_t pairs = 0;
+        double meanSkewUs = 0.0;             // |우 - 좌| 평균/최대
+        double maxSkewUs = 0.0;
+    };
+
+    StereoCapture();
+    ~StereoCapture();
+
+    StereoCapture(const StereoCapture&) = delete;
+    StereoCapture& operator=(const StereoCapture&) = delete;
+
+    // 캡처 스레드를 시작한다.
+    void Start(std::unique_ptr<CameraCapture> left, std::unique_ptr<CameraCapture> right, const Settings& settings);
+
+    // 캡처 스레드를 멈추고 기다린다.
+    void Stop();
+
+    // 다음 짝을 기다려 frame에 [좌 | 우] 그레이 영상을 넘긴다 (timeout 안에 짝이 없으면 false).
+    // frame은 왼쪽 링 칸의 버퍼와 교환되고 오른쪽 절반만 복사된다. 넘겨준 버퍼는 다음 캡처에 다시 쓰인다.
+    bool NextPair(std::vector<uint8_t>& frame, PairInfo& info, std::chrono::milliseconds timeout);
+
+    Stats GetStats() const;
+
+private:
+    struct Slot
+    {
+        std::vector<uint8_t> frame; // 스테레오 버퍼 (이 카메라의 영상은 자기 쪽 절반)
+        Clock::time_point timestamp;
+        uint32_t sequence = 0;
+    };
+
+    // 카메라 하나의 링 버퍼: ring[(first + i) % size], i = 0(가장 오래됨) ... count - 1(가장 최근)
+    struct Camera
+    {
+        std::unique_ptr<CameraCapture> capture;
+        std::thread thread;
+        std::vector<Slot> ring;
+        size_t first = 0;
+        size_t count = 0;
+    };
+
+    void CaptureLoop(Side side);
+    bool FindPair(size_t& left, size_t& right);
+    bool HasPartner(Side side, size_t i);
+    void CountDrops(Side side, size_t frames);
+    void Advance(Side side, size_t frames);
+    Slot& At(Side side, size_t i);
+    size_t StereoFrameSize() const;
+
+    Settings m_settings;
+    Camera m_cameras[2];
+    std::atomic<bool> m_running;
+
+    mutable std::mutex m_mutex; // 링 버퍼와 통계
+    std::condition_variable m_cv;
+    Stats m_stats;
+    double m_skewSumUs;
+};
+
+} /// namespace aa
+} /// namespace sensor
+
+#endif // STEREO_CAPTURE_H
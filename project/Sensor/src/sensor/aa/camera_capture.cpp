@@ -0,0 +1,484 @@
+#include "sensor/aa/camera_capture.h"
+
+#include <opencv2/opencv.hpp>
+
+#include <fcntl.h>
+#include <linux/videodev2.h>
+#include <poll.h>
+#include <sys/ioctl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+namespace sensor
+{
+namespace aa
+{
+
+namespace
+{
+
+using Clock = std::chrono::steady_clock;
+
+std::string ErrnoText(const char* what)
+{
+    return std::string(what) + ": " + std::strerror(errno);
+}
+
+std::string FourccText(uint32_t fourcc)
+{
+    char text[5] = {static_cast<char>(fourcc & 0xff), static_cast<char>((fourcc >> 8) & 0xff),
+                    static_cast<char>((fourcc >> 16) & 0xff), static_cast<char>((fourcc >> 24) & 0xff), '\0'};
+    return text;
+}
+
+// V4L2 직접 캡처: 드라이버 버퍼를 mmap해 복사 없이 읽고, 최신 프레임만 꺼낸다.
+class V4l2Capture : public CameraCapture
+{
+public:
+    explicit V4l2Capture(const std::string& device)
+        : m_device(device)
+        , m_fd(-1)
+        , m_streaming(false)
+        , m_held(-1)
+        , m_width(0)
+        , m_height(0)
+        , m_pixelFormat(0)
+    {
+    }
+
+    ~V4l2Capture() override
+    {
+        if (m_streaming)
+        {
+            v4l2_buf_type type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+            Xioctl(VIDIOC_STREAMOFF, &type);
+        }
+        for (auto& buffer : m_buffers)
+        {
+            munmap(buffer.start, buffer.length);
+        }
+        if (m_fd >= 0)
+        {
+            close(m_fd);
+        }
+    }
+
+    bool Open(const CaptureSettings& settings, std::string& error)
+    {
+        m_fd = open(m_device.c_str(), O_RDWR | O_NONBLOCK);
+        if (m_fd < 0)
+        {
+            error = ErrnoText(("open " + m_device).c_str());
+            return false;
+        }
+
+        v4l2_capability cap{};
+        if (Xioctl(VIDIOC_QUERYCAP, &cap) < 0)
+        {
+            error = ErrnoText("VIDIOC_QUERYCAP");
+            return false;
+        }
+        const uint32_t caps = (cap.capabilities & V4L2_CAP_DEVICE_CAPS) ? cap.device_caps : cap.capabilities;
+        if (!(caps & V4L2_CAP_VIDEO_CAPTURE) || !(caps & V4L2_CAP_STREAMING))
+        {
+            error = m_device + " is not a streaming capture device";
+            return false;
+        }
+
+        // MJPEG를 우선 요청하고, 드라이버가 바꾼 형식이 그레이가 아니면 포기한다 (OpenCV 경로가 변환을 맡는다).
+        v4l2_format fmt{};
+        fmt.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+        fmt.fmt.pix.width = static_cast<uint32_t>(settings.width);
+        fmt.fmt.pix.height = static_cast<uint32_t>(settings.height);
+        fmt.fmt.pix.pixelformat = V4L2_PIX_FMT_MJPEG;
+        fmt.fmt.pix.field = V4L2_FIELD_ANY;
+        if (Xioctl(VIDIOC_S_FMT, &fmt) < 0)
+        {
+            error = ErrnoText("VIDIOC_S_FMT");
+            return false;
+        }
+        m_pixelFormat = fmt.fmt.pix.pixelformat;
+        m_width = static_cast<int>(fmt.fmt.pix.width);
+        m_height = static_cast<int>(fmt.fmt.pix.height);
+        if (m_pixelFormat != V4L2_PIX_FMT_MJPEG && m_pixelFormat != V4L2_PIX_FMT_GREY)
+        {
+            error = m_device + " offers " + FourccText(m_pixelFormat) + " instead of MJPG";
+            return false;
+        }
+
+        // 프레임률은 요청일 뿐이다 (지원하지 않는 드라이버도 있다).
+        v4l2_streamparm parm{};
+        parm.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+        parm.parm.capture.timeperframe.numerator = 1;
+        parm.parm.capture.timeperframe.denominator = static_cast<uint32_t>(settings.fps);
+        Xioctl(VIDIOC_S_PARM, &parm);
+
+        v4l2_requestbuffers req{};
+        req.count = static_cast<uint32_t>(settings.buffers);
+        req.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+        req.memory = V4L2_MEMORY_MMAP;
+        if (Xioctl(VIDIOC_REQBUFS, &req) < 0 || req.count < 1)
+        {
+            error = ErrnoText("VIDIOC_REQBUFS");
+            return false;
+        }
+
+        for (uint32_t i = 0; i < req.count; ++i)
+        {
+            v4l2_buffer buf{};
+            buf.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+            buf.memory = V4L2_MEMORY_MMAP;
+            buf.index = i;
+            if (Xioctl(VIDIOC_QUERYBUF, &buf) < 0)
+            {
+                error = ErrnoText("VIDIOC_QUERYBUF");
+                return false;
+            }
+            void* start = mmap(nullptr, buf.length, PROT_READ | PROT_WRITE, MAP_SHARED, m_fd, buf.m.offset);
+            if (start == MAP_FAILED)
+            {
+                error = ErrnoText("mmap");
+                return false;
+            }
+            m_buffers.push_back(Buffer{start, buf.length});
+            if (Xioctl(VIDIOC_QBUF, &buf) < 0)
+            {
+                error = ErrnoText("VIDIOC_QBUF");
+                return false;
+            }
+        }
+
+        v4l2_buf_type type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+        if (Xioctl(VIDIOC_STREAMON, &type) < 0)
+        {
+            error = ErrnoText("VIDIOC_STREAMON");
+            return false;
+        }
+        m_streaming = true;
+        return true;
+    }
+
+    bool Grab(CapturedFrame& frame, std::chrono::milliseconds timeout) override
+    {
+        Requeue();
+
+        pollfd pfd{m_fd, POLLIN, 0};
+        const int ready = poll(&pfd, 1, static_cast<int>(timeout.count()));
+        if (ready <= 0 || !(pfd.revents & POLLIN))
+        {
+            return false;
+        }
+
+        v4l2_buffer buf{};
+        if (!Dequeue(buf))
+        {
+            return false;
+        }
+        // 처리하는 사이 드라이버에 더 최신 프레임이 쌓였으면 오래된 것은 바로 돌려주고 최신 프레임을 쓴다.
+        v4l2_buffer newer{};
+        while (Dequeue(newer))
+        {
+            Xioctl(VIDIOC_QBUF, &buf);
+            buf = newer;
+        }
+        m_held = static_cast<int>(buf.index);
+        if (buf.flags & V4L2_BUF_FLAG_ERROR)
+        {
+            return false;
+        }
+
+        frame.data = static_cast<const uint8_t*>(m_buffers[buf.index].start);
+        frame.size = buf.bytesused;
+        frame.format = (m_pixelFormat == V4L2_PIX_FMT_GREY) ? CapturedFrame::Format::Gray : CapturedFrame::Format::Mjpeg;
+        frame.width = m_width;
+        frame.height = m_height;
+        frame.sequence = buf.sequence;
+        // 드라이버가 CLOCK_MONOTONIC으로 기록했으면 steady_clock과 같은 시간축이다 (Linux).
+        if ((buf.flags & V4L2_BUF_FLAG_TIMESTAMP_MASK) == V4L2_BUF_FLAG_TIMESTAMP_MONOTONIC)
+        {
+            frame.timestamp = Clock::time_point(std::chrono::duration_cast<Clock::duration>(
+                std::chrono::seconds(buf.timestamp.tv_sec) + std::chrono::microseconds(buf.timestamp.tv_usec)));
+        }
+        else
+        {
+            frame.timestamp = Clock::now();
+        }
+        return true;
+    }
+
+    std::string Describe() const override
+    {
+        std::ostringstream oss;
+        oss << "v4l2 " << m_device << " " << FourccText(m_pixelFormat) << " " << m_width << "x" << m_height << " x"
+            << m_buffers.size();
+        return oss.str();
+    }
+
+private:
+    struct Buffer
+    {
+        void* start;
+        size_t length;
+    };
+
+    int Xioctl(unsigned long request, void* arg)
+    {
+        int result;
+        do
+        {
+            result = ioctl(m_fd, request, arg);
+        } while (result < 0 && errno == EINTR);
+        return result;
+    }
+
+    bool Dequeue(v4l2_buffer& buf)
+    {
+        buf = v4l2_buffer{};
+        buf.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+        buf.memory = V4L2_MEMORY_MMAP;
+        return Xioctl(VIDIOC_DQBUF, &buf) == 0;
+    }
+
+    // 이전 Grab에서 내준 버퍼를 드라이버에 돌려준다.
+    void Requeue()
+    {
+        if (m_held < 0)
+        {
+            return;
+        }
+        v4l2_buffer buf{};
+        buf.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+        buf.memory = V4L2_MEMORY_MMAP;
+        buf.index = static_cast<uint32_t>(m_held);
+        Xioctl(VIDIOC_QBUF, &buf);
+        m_held = -1;
+    }
+
+    std::string m_device;
+    int m_fd;
+    bool m_streaming;
+    std::vector<Buffer> m_buffers;
+    int m_held; // 호출자에게 내준 버퍼 번호 (-1: 없음)
+    int m_width;
+    int m_height;
+    uint32_t m_pixelFormat;
+};
+
+// cv::VideoCapture 경로 (V4L2로 열 수 없는 장치, 기존 동작)
+class OpenCvCapture : public CameraCapture
+{
+public:
+    explicit OpenCvCapture(const std::string& device)
+        : m_device(device)
+        , m_sequence(0)
+    {
+    }
+
+    bool Open(const CaptureSettings& settings, std::string& error)
+    {
+        // "/dev/videoN"은 기존과 같이 장치 번호로 연다.
+        int index = -1;
+        char tail = '\0';
+        if (std::sscanf(m_device.c_str(), "/dev/video%d%c", &index, &tail) == 1)
+        {
+            m_capture.open(index);
+        }
+        else
+        {
+            m_capture.open(m_device);
+        }
+        if (!m_capture.isOpened())
+        {
+            error = "cv::VideoCapture cannot open " + m_device;
+            return false;
+        }
+
+        // MJPEG 코덱 및 크기 설정
+        m_capture.set(cv::CAP_PROP_FOURCC, cv::VideoWriter::fourcc('M', 'J', 'P', 'G'));
+        m_capture.set(cv::CAP_PROP_FRAME_WIDTH, settings.width);
+        m_capture.set(cv::CAP_PROP_FRAME_HEIGHT, settings.height);
+        m_capture.set(cv::CAP_PROP_FPS, static_cast<double>(settings.fps));
+        return true;
+    }
+
+    bool Grab(CapturedFrame& frame, std::chrono::milliseconds timeout) override
+    {
+        // cv::VideoCapture::read는 제한 시간을 받지 않는다.
+        (void)timeout;
+        if (!m_capture.read(m_frame) || m_frame.empty() || m_frame.type() != CV_8UC3 || !m_frame.isContinuous())
+        {
+            return false;
+        }
+        frame.data = m_frame.data;
+        frame.size = m_frame.total() * m_frame.elemSize();
+        frame.format = CapturedFrame::Format::Bgr;
+        frame.width = m_frame.cols;
+        frame.height = m_frame.rows;
+        frame.timestamp = Clock::now();
+        frame.sequence = m_sequence++;
+        return true;
+    }
+
+    std::string Describe() const override
+    {
+        return "opencv " + m_device;
+    }
+
+private:
+    std::string m_device;
+    cv::VideoCapture m_capture;
+    cv::Mat m_frame;
+    uint32_t m_sequence;
+};
+
+// 녹화 파일 재생: JPEG를 이어 붙인 MJPEG 스트림(ffmpeg -f mjpeg 등)을 지정한 프레임률로 반복한다.
+class ReplayCapture : public CameraCapture
+{
+public:
+    explicit ReplayCapture(const std::string& path)
+        : m_path(path)
+        , m_next(0)
+        , m_sequence(0)
+    {
+    }
+
+    bool Open(const CaptureSettings& settings, std::string& error)
+    {
+        std::ifstream file(m_path, std::ios::binary);
+        m_data.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+
+        m_frames = SplitMjpegStream(m_data.data(), m_data.size());
+        if (m_frames.empty())
+        {
+            error = "no JPEG frames in " + m_path;
+            return false;
+        }
+        m_width = settings.width;
+        m_height = settings.height;
+        m_interval = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(1.0 / settings.fps));
+        m_due = Clock::now();
+        return true;
+    }
+
+    bool Grab(CapturedFrame& frame, std::chrono::milliseconds timeout) override
+    {
+        const Clock::time_point now = Clock::now();
+        if (m_due > now + timeout)
+        {
+            std::this_thread::sleep_for(timeout);
+            return false;
+        }
+        std::this_thread::sleep_until(m_due);
+        // 늦게 불렸으면 밀린 프레임을 한꺼번에 내지 않고 지금부터 다시 센다 (카메라도 최신 프레임만 준다).
+        m_due = std::max(m_due, Clock::now() - m_interval) + m_interval;
+
+        const JpegFrameSpan& span = m_frames[m_next];
+        m_next = (m_next + 1) % m_frames.size();
+        frame.data = m_data.data() + span.offset;
+        frame.size = span.size;
+        frame.format = CapturedFrame::Format::Mjpeg;
+        frame.width = m_width;
+        frame.height = m_height;
+        frame.timestamp = Clock::now();
+        frame.sequence = m_sequence++;
+        return true;
+    }
+
+    std::string Describe() const override
+    {
+        std::ostringstream oss;
+        oss << "replay " << m_path << " (" << m_frames.size() << " frames)";
+        return oss.str();
+    }
+
+private:
+    std::string m_path;
+    std::vector<uint8_t> m_data;
+    std::vector<JpegFrameSpan> m_frames;
+    size_t m_next;
+    uint32_t m_sequence;
+    int m_width = 0;
+    int m_height = 0;
+    Clock::duration m_interval{};
+    Clock::time_point m_due;
+};
+
+template <typename Capture>
+std::unique_ptr<CameraCapture> TryOpen(const std::string& device, const CaptureSettings& settings, std::string& error)
+{
+    auto capture = std::make_unique<Capture>(device);
+    if (!capture->Open(settings, error))
+    {
+        return nullptr;
+    }
+    return capture;
+}
+
+} // namespace
+
+std::unique_ptr<CameraCapture> OpenCameraCapture(const std::string& backend, const std::string& device,
+                                                 const CaptureSettings& settings, std::string& error)
+{
+    struct stat st{};
+    if (stat(device.c_str(), &st) == 0 && S_ISREG(st.st_mode))
+    {
+        return TryOpen<ReplayCapture>(device, settings, error);
+    }
+    if (backend == "opencv")
+    {
+        return TryOpen<OpenCvCapture>(device, settings, error);
+    }
+
+    auto capture = TryOpen<V4l2Capture>(device, settings, error);
+    if (capture || backend == "v4l2")
+    {
+        return capture;
+    }
+    // auto: V4L2로 열 수 없으면(드라이버가 MJPEG/mmap을 지원하지 않는 등) 기존 OpenCV 경로를 쓴다.
+    std::string v4l2Error = error;
+    capture = TryOpen<OpenCvCapture>(device, settings, error);
+    error = capture ? v4l2Error : v4l2Error + "; " + error;
+    return capture;
+}
+
+bool DecodeGray(const CapturedFrame& frame, uint8_t* dst, int width, int height, GrayJpegDecoder& jpeg)
+{
+    switch (frame.format)
+    {
+    case CapturedFrame::Format::Gray:
+        if (frame.width != width || frame.height != height || frame.size < static_cast<size_t>(width) * height)
+        {
+            return false;
+        }
+        std::memcpy(dst, frame.data, static_cast<size_t>(width) * height);
+        return true;
+    case CapturedFrame::Format::Bgr:
+        if (frame.width != width || frame.height != height)
+        {
+            return false;
+        }
+    {
+        cv::Mat gray(height, width, CV_8UC1, dst);
+        cv::cvtColor(cv::Mat(height, width, CV_8UC3, const_cast<uint8_t*>(frame.data)), gray, cv::COLOR_BGR2GRAY);
+        return gray.data == dst;
+    }
+    case CapturedFrame::Format::Mjpeg:
+        // 밝기 성분만 dst에 바로 디코딩한다 (색차 업샘플링, BGR 변환, 중간 cv::Mat 없음).
+        return jpeg.Decode(frame.data, frame.size, dst, width, height);
+    }
+    return false;
+}
+
+} /// namespace aa
+} /// namespace sensor
@@ -0,0 +1,157 @@
+#include "sensor/aa/frame_pacer.h"
+
+#include <algorithm>
+#include <cmath>
+#include <thread>
+
+namespace sensor
+{
+namespace aa
+{
+
+FramePacer::FramePacer()
+    : m_period(Clock::duration::zero())
+    , m_slack(Clock::duration::zero())
+    , m_scheduled(false)
+    , m_published(false)
+    , m_intervals(0)
+    , m_intervalSumMs(0.0)
+    , m_intervalSquareSumMs(0.0)
+    , m_ageSumMs(0.0)
+{
+}
+
+void FramePacer::Reset(const Settings& settings)
+{
+    m_settings = settings;
+    m_period = Clock::duration::zero();
+    m_slack = Clock::duration::zero();
+    if (Throttling())
+    {
+        m_period = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(1.0 / settings.targetFps));
+        m_slack = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(0.5 / settings.cameraFps));
+    }
+    m_scheduled = false;
+    m_stats = Stats();
+    m_published = false;
+    m_intervals = 0;
+    m_intervalSumMs = 0.0;
+    m_intervalSquareSumMs = 0.0;
+    m_ageSumMs = 0.0;
+}
+
+bool FramePacer::Throttling() const
+{
+    return m_settings.targetFps > 0.0 && m_settings.targetFps < m_settings.cameraFps;
+}
+
+void FramePacer::WaitForSlot()
+{
+    // steady_clock 절대 시각으로 자므로 (clock_nanosleep TIMER_ABSTIME) 처리 시간만큼 주기가 밀리지 않는다.
+    if (Throttling() && m_settings.policy == Policy::Timer && m_scheduled)
+    {
+        std::this_thread::sleep_until(m_deadline);
+    }
+}
+
+bool FramePacer::Admit(Clock::time_point captureTime, Clock::time_point now)
+{
+    if (Throttling())
+    {
+        // Arrival은 카메라 캡처 시각으로, Timer는 깨어난 시각으로 일정을 따진다.
+        const Clock::time_point reference = (m_settings.policy == Policy::Arrival) ? captureTime : now;
+        if (!m_scheduled)
+        {
+            m_deadline = reference;
+            m_scheduled = true;
+        }
+        if (m_settings.policy == Policy::Arrival && captureTime + m_slack < m_deadline)
+        {
+            ++m_stats.decimated;
+            return false;
+        }
+        AdvanceDeadline(reference);
+    }
+    return true;
+}
+
+void FramePacer::Sent(Clock::time_point captureTime, Clock::time_point sentTime, bool success)
+{
+    if (!success)
+    {
+        ++m_stats.sendFailures;
+        return;
+    }
+
+    if (m_published)
+    {
+        const double intervalMs = std::chrono::duration<double, std::milli>(sentTime - m_lastPublish).count();
+        ++m_intervals;
+        m_intervalSumMs += intervalMs;
+        m_intervalSquareSumMs += intervalMs * intervalMs;
+        m_stats.maxIntervalMs = std::max(m_stats.maxIntervalMs, intervalMs);
+    }
+    m_published = true;
+    m_lastPublish = sentTime;
+    ++m_stats.published;
+
+    const double ageMs = std::chrono::duration<double, std::milli>(sentTime - captureTime).count();
+    m_ageSumMs += ageMs;
+    m_stats.maxAgeMs = std::max(m_stats.maxAgeMs, ageMs);
+}
+
+FramePacer::Stats FramePacer::TakeStats()
+{
+    Stats stats = m_stats;
+    if (m_intervals > 0 && m_intervalSumMs > 0.0)
+    {
+        stats.meanIntervalMs = m_intervalSumMs / m_intervals;
+        stats.achievedFps = 1000.0 / stats.meanIntervalMs;
+        const double variance = m_intervalSquareSumMs / m_intervals - stats.meanIntervalMs * stats.meanIntervalMs;
+        stats.jitterMs = std::sqrt(std::max(0.0, variance));
+    }
+    if (stats.published > 0)
+    {
+        stats.meanAgeMs = m_ageSumMs / stats.published;
+    }
+    m_stats = Stats();
+    m_intervals = 0;
+    m_intervalSumMs = 0.0;
+    m_intervalSquareSumMs = 0.0;
+    m_ageSumMs = 0.0;
+    return stats;
+}
+
+const char* FramePacer::PolicyName(Policy policy)
+{
+    return (policy == Policy::Timer) ? "timer" : "arrival";
+}
+
+bool FramePacer::ParsePolicy(const std::string& text, Policy& policy)
+{
+    if (text == "arrival")
+    {
+        policy = Policy::Arrival;
+        return true;
+    }
+    if (text == "timer")
+    {
+        policy = Policy::Timer;
+        return true;
+    }
+    return false;
+}
+
+// 일정은 이전 발행 시각이 아닌 이전 일정에 주기를 더해 잡는다. 한 주기 이상 밀렸으면 몰아서 발행하지 않고 지금부터 다시 센다.
+void FramePacer::AdvanceDeadline(Clock::time_point reference)
+{
+    m_deadline += m_period;
+    if (m_deadline <= reference)
+    {
+        ++m_stats.missedSlots;
+        m_deadline = reference + m_period;
+    }
+}
+
+} /// namespace aa
+} /// namespace sensor
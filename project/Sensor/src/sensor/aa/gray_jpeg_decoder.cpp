@@ -0,0 +1,186 @@
+#include "sensor/aa/gray_jpeg_decoder.h"
+
+#ifdef SENSOR_WITH_LIBJPEG
+// jpeglib.h는 FILE과 size_t 선언을 먼저 요구한다.
+#include <csetjmp>
+#include <cstdio>
+#include <jpeglib.h>
+#else
+#include <opencv2/opencv.hpp>
+#endif
+
+namespace sensor
+{
+namespace aa
+{
+
+#ifdef SENSOR_WITH_LIBJPEG
+
+namespace
+{
+
+// libjpeg 기본 오류 처리는 프로세스를 끝내므로 longjmp로 Decode에 돌아온다.
+struct ErrorManager
+{
+    jpeg_error_mgr pub;
+    jmp_buf jump;
+    char message[JMSG_LENGTH_MAX];
+};
+
+void OnJpegError(j_common_ptr cinfo)
+{
+    ErrorManager* err = reinterpret_cast<ErrorManager*>(cinfo->err);
+    (*cinfo->err->format_message)(cinfo, err->message);
+    longjmp(err->jump, 1);
+}
+
+// 경고(데이터 끝 누락 등)는 stderr로 내보내지 않는다. 프레임은 읽힌 만큼 쓴다.
+void OnJpegMessage(j_common_ptr cinfo, int level)
+{
+    (void)cinfo;
+    (void)level;
+}
+
+} // namespace
+
+struct GrayJpegDecoder::Impl
+{
+    jpeg_decompress_struct cinfo;
+    ErrorManager err;
+    std::vector<JSAMPROW> rows; // 출력 행 포인터 (dst의 각 행)
+};
+
+GrayJpegDecoder::GrayJpegDecoder()
+    : m_impl(std::make_unique<Impl>())
+{
+    m_impl->cinfo.err = jpeg_std_error(&m_impl->err.pub);
+    m_impl->err.pub.error_exit = OnJpegError;
+    m_impl->err.pub.emit_message = OnJpegMessage;
+    jpeg_create_decompress(&m_impl->cinfo);
+}
+
+GrayJpegDecoder::~GrayJpegDecoder()
+{
+    jpeg_destroy_decompress(&m_impl->cinfo);
+}
+
+bool GrayJpegDecoder::Decode(const uint8_t* data, size_t size, uint8_t* dst, int width, int height)
+{
+    jpeg_decompress_struct& cinfo = m_impl->cinfo;
+    std::vector<JSAMPROW>& rows = m_impl->rows;
+    rows.resize(static_cast<size_t>(height));
+    for (int y = 0; y < height; ++y)
+    {
+        rows[y] = dst + static_cast<size_t>(y) * width;
+    }
+
+    // setjmp 이후에는 소멸자가 필요한 지역 객체를 만들지 않는다 (longjmp가 건너뛴다).
+    if (setjmp(m_impl->err.jump))
+    {
+        jpeg_abort_decompress(&cinfo);
+        m_error = m_impl->err.message;
+        return false;
+    }
+
+    // 카메라 MJPEG는 Huffman 표(DHT)를 생략하기도 한다. libjpeg-turbo는 이때 표준 표를 쓴다.
+    jpeg_mem_src(&cinfo, const_cast<unsigned char*>(data), static_cast<unsigned long>(size));
+    jpeg_read_header(&cinfo, TRUE);
+
+    unsigned int scale = 1;
+    while (scale < 8 && cinfo.image_width > static_cast<JDIMENSION>(width) * scale)
+    {
+        scale *= 2;
+    }
+    if (cinfo.image_width != static_cast<JDIMENSION>(width) * scale ||
+        cinfo.image_height != static_cast<JDIMENSION>(height) * scale)
+    {
+        snprintf(m_impl->err.message, sizeof(m_impl->err.message), "JPEG is %ux%u, expected %dx%d (or 2/4/8x)",
+                 cinfo.image_width, cinfo.image_height, width, height);
+        jpeg_abort_decompress(&cinfo);
+        m_error = m_impl->err.message;
+        return false;
+    }
+    cinfo.scale_num = 1;
+    cinfo.scale_denom = scale;
+    cinfo.out_color_space = JCS_GRAYSCALE;
+
+    jpeg_start_decompress(&cinfo);
+    while (cinfo.output_scanline < cinfo.output_height)
+    {
+        jpeg_read_scanlines(&cinfo, rows.data() + cinfo.output_scanline, cinfo.output_height - cinfo.output_scanline);
+    }
+    // 남은 표지(EOI)는 읽지 않는다. 다음 프레임에서 디코더 상태만 다시 쓴다.
+    jpeg_abort_decompress(&cinfo);
+    return true;
+}
+
+const char* GrayJpegDecoder::Implementation()
+{
+    return "libjpeg-luma";
+}
+
+#else
+
+struct GrayJpegDecoder::Impl
+{
+};
+
+GrayJpegDecoder::GrayJpegDecoder()
+    : m_impl(std::make_unique<Impl>())
+{
+}
+
+GrayJpegDecoder::~GrayJpegDecoder()
+{
+}
+
+bool GrayJpegDecoder::Decode(const uint8_t* data, size_t size, uint8_t* dst, int width, int height)
+{
+    // 크기가 맞으면 imdecode가 dst 위에 바로 디코딩한다 (다르면 새로 할당하므로 실패로 본다).
+    cv::Mat gray(height, width, CV_8UC1, dst);
+    cv::imdecode(cv::Mat(1, static_cast<int>(size), CV_8UC1, const_cast<uint8_t*>(data)), cv::IMREAD_GRAYSCALE, &gray);
+    if (gray.data != dst || gray.cols != width || gray.rows != height)
+    {
+        m_error = "cv::imdecode failed or returned a different size";
+        return false;
+    }
+    return true;
+}
+
+const char* GrayJpegDecoder::Implementation()
+{
+    return "opencv-gray";
+}
+
+#endif
+
+const std::string& GrayJpegDecoder::LastError() const
+{
+    return m_error;
+}
+
+std::vector<JpegFrameSpan> SplitMjpegStream(const uint8_t* data, size_t size)
+{
+    std::vector<JpegFrameSpan> frames;
+    size_t start = size;
+    for (size_t i = 0; i + 1 < size; ++i)
+    {
+        if (data[i] != 0xFF)
+        {
+            continue;
+        }
+        if (data[i + 1] == 0xD8 && start == size)
+        {
+            start = i;
+        }
+        else if (data[i + 1] == 0xD9 && start != size)
+        {
+            frames.push_back(JpegFrameSpan{start, i + 2 - start});
+            start = size;
+        }
+    }
+    return frames;
+}
+
+} /// namespace aa
+} /// namespace sensor
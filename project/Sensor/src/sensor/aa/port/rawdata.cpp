@@ -158,6 +158,27 @@ void RawData::WriteDataREvent(const deepracer::service::rawdata::skeleton::event
     m_REventData = data;
 }
  
+void RawData::SwapDataREvent(deepracer::service::rawdata::skeleton::events::REvent::SampleType& data)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_REventData.swap(data);
+}
+ 
+bool RawData::SendEventREventSwapped(deepracer::service::rawdata::skeleton::events::REvent::SampleType& data)
+{
+    // 교환과 전송을 한 번의 잠금 안에서 해 교환한 버퍼가 정확히 한 번 전송되게 한다.
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_REventData.swap(data);
+    auto send = m_interface->REvent.Send(m_REventData);
+    if (send.HasValue())
+    {
+        m_logger.LogVerbose() << "RawData::SendEventREventSwapped::Send";
+        return true;
+    }
+    m_logger.LogError() << "RawData::SendEventREventSwapped::Send::" << send.Error().Message();
+    return false;
+}
+ 
 void RawData::SendEventREventCyclic()
 {
     while (m_running)
@@ -178,18 +199,17 @@ void RawData::SendEventREventCyclic()
     }
 }
  
-void RawData::SendEventREventTriggered()
+bool RawData::SendEventREventTriggered()
 {
     std::lock_guard<std::mutex> lock(m_mutex);
     auto send = m_interface->REvent.Send(m_REventData);
     if (send.HasValue())
     {
         m_logger.LogVerbose() << "RawData::SendEventREventTriggered::Send";
+        return true;
     }
-    else
-    {
-        m_logger.LogError() << "RawData::SendEventREventTriggered::Send::" << send.Error().Message();
-    }
+    m_logger.LogError() << "RawData::SendEventREventTriggered::Send::" << send.Error().Message();
+    return false;
 }
  
 void RawData::SendEventREventTriggered(const deepracer::service::rawdata::skeleton::events::REvent::SampleType& data)
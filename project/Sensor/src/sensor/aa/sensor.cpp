@@ -20,10 +20,24 @@ namespace sensor
 {
 namespace aa
 {
+
+namespace
+{
+// Calc가 기대하는 카메라 한 대의 영상 (160x120 그레이)
+constexpr int kCameraWidth = 160;
+constexpr int kCameraHeight = 120;
+constexpr size_t kCameraFrameSize = static_cast<size_t>(kCameraWidth) * kCameraHeight;
+
+// 카메라가 멈췄을 때도 종료 여부를 확인하도록 캡처 대기 시간을 제한한다.
+constexpr std::chrono::milliseconds kCaptureTimeout(500);
+
+// 좌우 짝 / 발행 간격 통계를 로그로 남기는 간격 (발행한 짝 수)
+constexpr uint64_t kStereoReportPairs = 300;
+}
  
 Sensor::Sensor()
     : m_logger(ara::log::CreateLogger("SENS", "SWC", ara::log::LogLevel::kVerbose))
-    , m_workers(3)
+    , m_workers(2)
     , m_running(false)
     , m_simulation(false)
     , udp_ip("172.31.41.14") // IP on the receiving side of the data
@@ -31,7 +45,6 @@ Sensor::Sensor()
     , sock(socket(AF_INET, SOCK_DGRAM, 0)) // udp 통신 소켓
     , data_path("/home/ubuntu/test_socket_AA_data"), last_save_time(std::chrono::system_clock::now()) // 데이터 저장 시간
     , save_interval(std::chrono::seconds(5)) // path로 데이터 저장 주기
-    , capR(), capL()
 {
 }
  
@@ -45,27 +58,29 @@ bool Sensor::Initialize()
     
     bool init{true};
     
+    m_config = SensorConfig::FromEnvironment();
     m_RawData = std::make_shared<sensor::aa::port::RawData>();
     
-    // Camera 접근
-    capR.open(0);
-    capL.open(2);
+    // Camera 접근 (MJPEG 160x120)
+    CaptureSettings settings;
+    settings.width = kCameraWidth;
+    settings.height = kCameraHeight;
+    settings.buffers = m_config.captureBuffers;
+    settings.fps = m_config.cameraFps;
+    std::string errorR;
+    std::string errorL;
+    capR = OpenCameraCapture(m_config.captureBackend, m_config.rightDevice, settings, errorR);
+    capL = OpenCameraCapture(m_config.captureBackend, m_config.leftDevice, settings, errorL);
+    if (!errorR.empty() || !errorL.empty())
+    {
+        m_logger.LogInfo() << "Sensor::Initialize - capture backend notes: right = " << errorR << ", left = " << errorL;
+    }
 
     // 접근 여부 파악
-    if (capR.isOpened() && capL.isOpened())
+    if (capR && capL)
     { // 카메라 접근 되면 카메라에서 데이터 받아온다.
-        m_logger.LogInfo() << "Sensor::TaskGenerateREventValue - Open Stereo Camera Successfully";
-
-        // MJPEC 코덱 및 크기 설정
-        capR.set(cv::CAP_PROP_FOURCC, cv::VideoWriter::fourcc('M', 'J', 'P', 'G'));
-        capR.set(cv::CAP_PROP_FRAME_WIDTH, 160);
-        capR.set(cv::CAP_PROP_FRAME_HEIGHT, 120);
-
-        capL.set(cv::CAP_PROP_FOURCC, cv::VideoWriter::fourcc('M', 'J', 'P', 'G'));
-        capL.set(cv::CAP_PROP_FRAME_WIDTH, 160);
-        capL.set(cv::CAP_PROP_FRAME_HEIGHT, 120);
-
-        m_logger.LogInfo() << "Sensor::TaskGenerateREventValue - Setting CODEC Successfully";
+        m_logger.LogInfo() << "Sensor::Initialize - Open Stereo Camera Successfully (R = " << capR->Describe() << " , L = "
+                           << capL->Describe() << ")";
 
         m_simulation = false;
         close(sock);
@@ -74,6 +89,8 @@ bool Sensor::Initialize()
     else
     { // Simulation에서 센서 데이터 받아온다.
         m_logger.LogVerbose() << "Sensor::TaskGenerateREventValue - Camera access failed";
+        capR.reset();
+        capL.reset();
         m_logger.LogInfo() << "Sensor - RUNNING ON SIMULATION";
         m_simulation = true;
 
@@ -126,8 +143,8 @@ void Sensor::Run()
 
     m_running = true;
     
+    // REvent는 캡처 루프가 짝마다 직접 전송한다 (주기 전송을 두면 100 ms마다 묵은 짝을 보내고 그 사이 짝은 버린다).
     m_workers.Async([this] { TaskGenerateREventValue(); });
-    m_workers.Async([this] { m_RawData->SendEventREventCyclic(); });
     m_workers.Async([this] { m_RawData->NotifyFieldRFieldCyclic(); });
     
     m_workers.Wait();
@@ -135,14 +152,39 @@ void Sensor::Run()
 
 void Sensor::TaskGenerateREventValue()
 {
-    cv::Mat frameR;               // 카메라1 이미지 프레임
-    cv::Mat frameL;               // 카메라2 이미지 프레임
-    cv::Mat frameR_grayscaled;    // GrayScaled 처리된 프레임1
-    cv::Mat frameL_grayscaled;    // GrayScaled 처리된 프레임2
-    std::vector<uint8_t> bufferR; // 비트맵 Flatten vector1
-    std::vector<uint8_t> bufferL; // 비트맵 Flatten vector2
-    bufferR.reserve(19200);
-    bufferL.reserve(19200);
+    StereoCapture::PairInfo pair; // 좌우 프레임의 캡처 시각과 순번
+    // Calc로 보낼 [좌 | 우] 스테레오 프레임. 캡처 링 버퍼, 이 루프, RawData 포트 사이에서 교환으로만 오간다 (복사 없음).
+    deepracer::service::rawdata::skeleton::events::REvent::SampleType frame(2 * kCameraFrameSize);
+    uint64_t pairs = 0;
+
+    // 카메라마다 캡처 스레드를 두고 두 프레임을 같은 순간에 받는다 (좌우를 차례로 읽으면 캡처 시각이 어긋난다).
+    if (!m_simulation)
+    {
+        StereoCapture::Settings settings;
+        settings.width = kCameraWidth;
+        settings.height = kCameraHeight;
+        settings.ringFrames = m_config.captureRing;
+        settings.tolerance = std::chrono::microseconds(m_config.pairToleranceUs > 0 ? m_config.pairToleranceUs
+                                                                                     : 500000 / m_config.cameraFps);
+        m_stereo.Start(std::move(capL), std::move(capR), settings);
+        m_logger.LogInfo() << "Sensor::TaskGenerateREventValue - stereo pairing tolerance = " << settings.tolerance.count()
+                           << " us, ring = " << settings.ringFrames << ", jpeg decoder = " << GrayJpegDecoder::Implementation();
+
+        // 고정 대기 없이 짝이 도착하는 대로 발행하고, 목표 프레임률이 낮으면 절대 시각 일정에 맞춰 솎아낸다.
+        FramePacer::Settings pacing;
+        pacing.targetFps = static_cast<double>(m_config.targetFps);
+        pacing.cameraFps = static_cast<double>(m_config.cameraFps);
+        if (!FramePacer::ParsePolicy(m_config.decimation, pacing.policy))
+        {
+            m_logger.LogWarn() << "Sensor::TaskGenerateREventValue - unknown SENSOR_DECIMATION " << m_config.decimation
+                               << ", using " << FramePacer::PolicyName(pacing.policy);
+        }
+        m_pacer.Reset(pacing);
+        m_logger.LogInfo() << "Sensor::TaskGenerateREventValue - camera " << m_config.cameraFps << " fps, target "
+                           << (m_pacer.Throttling() ? std::to_string(m_config.targetFps) + " fps (" +
+                                                          FramePacer::PolicyName(pacing.policy) + ")"
+                                                    : std::string("camera rate"));
+    }
 
     char buffer[65536]; // udp 통신 데이터 받을 버퍼
     sockaddr_in addr;
@@ -160,8 +202,7 @@ void Sensor::TaskGenerateREventValue()
                     double timestamp;
                     std::memcpy(&timestamp, buffer, sizeof(double)); // Copy timestamp
 
-                    bufferL.assign(buffer + 8, buffer + 19208);     // Extract left image data
-                    bufferR.assign(buffer + 19208, buffer + 38408); // Extract right image data
+                    frame.assign(buffer + 8, buffer + 38408);       // Extract left | right image data
                     std::vector<float> lidar_data(8);               // Extract lidar data
                     std::memcpy(lidar_data.data(), buffer + 38408, 8 * sizeof(float));
 
@@ -175,22 +216,35 @@ void Sensor::TaskGenerateREventValue()
                 catch (const std::exception &e)
                 {
                     m_logger.LogVerbose() << "Sensor::TaskGenerateREventValue - Error unpacking data: " << e.what();
+                    continue;
                 }
             }
+            else
+            {
+                // 받은 데이터가 없으면 발행하지 않는다 (교환으로 돌려받은 이전 버퍼가 다시 나가지 않도록).
+                continue;
+            }
         }
         else
         {
-            // 카메라 캡처
-            capR >> frameR;
-            capL >> frameL;
-
-            // GrayScale
-            cv::cvtColor(frameR, frameR_grayscaled, cv::COLOR_BGR2GRAY);
-            cv::cvtColor(frameL, frameL_grayscaled, cv::COLOR_BGR2GRAY);
+            // 카메라 캡처 (GrayScale, 19200 고정된 크기로 Flatten된 좌우 짝을 이어 붙인 38400 바이트)
+            m_pacer.WaitForSlot();
+            if (!m_stereo.NextPair(frame, pair, kCaptureTimeout))
+            {
+                const StereoCapture::Stats stats = m_stereo.GetStats();
+                m_logger.LogWarn() << "Sensor::TaskGenerateREventValue - no stereo pair within " << kCaptureTimeout.count()
+                                   << " ms, consecutive capture failures L/R " << stats.consecutiveFailures[StereoCapture::kLeft]
+                                   << " / " << stats.consecutiveFailures[StereoCapture::kRight];
+                continue;
+            }
 
-            // 19200 고정된 크기로 Flatten(imencode하면 벡터 사이즈 변환 가능...)
-            bufferR.assign(frameR_grayscaled.datastart, frameR_grayscaled.dataend);
-            bufferL.assign(frameL_grayscaled.datastart, frameL_grayscaled.dataend);
+            // 좌우 캡처 시각 차이 (발행 간격과 캡처 이후 경과 시간은 전송 뒤에 FramePacer가 잰다)
+            if (!m_pacer.Admit(pair.timestamp[StereoCapture::kLeft], std::chrono::steady_clock::now()))
+            {
+                continue;
+            }
+            m_logger.LogVerbose() << "Sensor::TaskGenerateREventValue - skew = " << pair.skewUs << " us, seq L = "
+                                  << pair.sequence[StereoCapture::kLeft] << " , R = " << pair.sequence[StereoCapture::kRight];
 
             // cv::imshow("frameR_grayscaled", frameR_grayscaled);
             // cv::imshow("frameL_grayscaled", frameL_grayscaled);
@@ -199,22 +253,57 @@ void Sensor::TaskGenerateREventValue()
             // {
             //     m_running = false;
             // }
-            std::this_thread::sleep_for(std::chrono::milliseconds(100)); // fps
         }
 
-        std::vector<uint8_t> bufferCombined; // Calc로 보낼 벡터
-        bufferCombined.reserve(bufferR.size() + bufferL.size());
-        bufferCombined.insert(bufferCombined.end(), bufferL.begin(), bufferL.end());
-        bufferCombined.insert(bufferCombined.end(), bufferR.begin(), bufferR.end());
+        // RawData 서비스의 REvent로 이번 짝을 넘기고 바로 전송한다. 짝마다 정확히 한 번 전송된다.
+        // 복사 대신 버퍼를 교환하고, 돌려받은 이전 버퍼는 다음 캡처에 쓴다.
+        const size_t frameSize = frame.size();
+        const bool sent = m_RawData->SendEventREventSwapped(frame);
 
-        deepracer::service::rawdata::skeleton::events::REvent::SampleType settingSampleValue = bufferCombined;
-        // RawData 서비스의 REvent로 전송해야 할 값을 변경한다. 이 함수는 전송 타겟 값을 변경할 뿐 실제 전송은 다른 부분에서 진행된다.
-        m_RawData->WriteDataREvent(settingSampleValue);
+        m_logger.LogVerbose() << "Sensor::Call RawData->SendEventREventSwapped size = " << frameSize;
+
+        if (!m_simulation)
+        {
+            m_pacer.Sent(pair.timestamp[StereoCapture::kLeft], std::chrono::steady_clock::now(), sent);
+            if (++pairs % kStereoReportPairs == 0)
+            {
+                ReportStereo("Sensor::TaskGenerateREventValue");
+                ReportPacing("Sensor::TaskGenerateREventValue");
+            }
+        }
+    }
 
-        m_logger.LogInfo() << "Sensor::Call RawData->WriteDataREvent size (R = " << bufferR.size() << " , L = " << bufferL.size() << ")";
+    if (!m_simulation)
+    {
+        m_stereo.Stop();
+        ReportStereo("Sensor::TaskGenerateREventValue");
+        ReportPacing("Sensor::TaskGenerateREventValue");
     }
 }
 
+// 카메라별 캡처/실패/버림 수와 좌우 캡처 시각 차이
+void Sensor::ReportStereo(const char *where)
+{
+    StereoCapture::Stats stats = m_stereo.GetStats();
+    m_logger.LogInfo() << where << " - stereo pairs " << stats.pairs << ", skew mean " << stats.meanSkewUs << " us max "
+                       << stats.maxSkewUs << " us, captured L/R " << stats.captured[StereoCapture::kLeft] << " / "
+                       << stats.captured[StereoCapture::kRight] << ", unpaired drops L/R " << stats.unpairedDrops[StereoCapture::kLeft]
+                       << " / " << stats.unpairedDrops[StereoCapture::kRight] << ", skipped L/R " << stats.skipped[StereoCapture::kLeft]
+                       << " / " << stats.skipped[StereoCapture::kRight] << ", failures L/R " << stats.failures[StereoCapture::kLeft]
+                       << " / " << stats.failures[StereoCapture::kRight];
+}
+
+// 마지막 보고 이후 포트에서 전송한 프레임률, 전송 간격 흔들림과 캡처 이후 경과 시간
+void Sensor::ReportPacing(const char *where)
+{
+    FramePacer::Stats stats = m_pacer.TakeStats();
+    m_logger.LogInfo() << where << " - sent " << stats.published << " pairs at " << stats.achievedFps
+                       << " fps, interval mean " << stats.meanIntervalMs << " ms jitter " << stats.jitterMs << " ms max "
+                       << stats.maxIntervalMs << " ms, age at send mean " << stats.meanAgeMs << " ms max " << stats.maxAgeMs
+                       << " ms, decimated " << stats.decimated << ", missed slots " << stats.missedSlots << ", send failures "
+                       << stats.sendFailures;
+}
+
 void Sensor::save_data(double timestamp, const std::vector<uint8_t> &left_image, const std::vector<uint8_t> &right_image, const std::vector<float> &lidar_data)
 {
     save_camera_data(left_image, timestamp, "left");
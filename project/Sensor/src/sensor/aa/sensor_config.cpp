@@ -0,0 +1,58 @@
+#include "sensor/aa/sensor_config.h"
+
+#include <algorithm>
+#include <cstdlib>
+
+namespace sensor
+{
+namespace aa
+{
+
+namespace
+{
+
+std::string GetEnvString(const char* name, const std::string& defaultValue)
+{
+    const char* value = std::getenv(name);
+    if (value == nullptr || *value == '\0')
+    {
+        return defaultValue;
+    }
+    return value;
+}
+
+size_t GetEnvSize(const char* name, size_t defaultValue)
+{
+    const char* value = std::getenv(name);
+    if (value == nullptr || *value == '\0')
+    {
+        return defaultValue;
+    }
+    char* end = nullptr;
+    unsigned long long parsed = std::strtoull(value, &end, 10);
+    if (end == value || *end != '\0')
+    {
+        return defaultValue;
+    }
+    return static_cast<size_t>(parsed);
+}
+
+} // namespace
+
+SensorConfig SensorConfig::FromEnvironment()
+{
+    SensorConfig config;
+    config.captureBackend = GetEnvString("SENSOR_CAPTURE", config.captureBackend);
+    config.rightDevice = GetEnvString("SENSOR_CAMERA_RIGHT", config.rightDevice);
+    config.leftDevice = GetEnvString("SENSOR_CAMERA_LEFT", config.leftDevice);
+    config.captureBuffers = std::max<size_t>(2, GetEnvSize("SENSOR_CAPTURE_BUFFERS", config.captureBuffers));
+    config.cameraFps = std::max<size_t>(1, GetEnvSize("SENSOR_CAMERA_FPS", config.cameraFps));
+    config.captureRing = std::max<size_t>(1, GetEnvSize("SENSOR_CAPTURE_RING", config.captureRing));
+    config.pairToleranceUs = GetEnvSize("SENSOR_PAIR_TOLERANCE_US", config.pairToleranceUs);
+    config.targetFps = GetEnvSize("SENSOR_TARGET_FPS", config.targetFps);
+    config.decimation = GetEnvString("SENSOR_DECIMATION", config.decimation);
+    return config;
+}
+
+} /// namespace aa
+} /// namespace sensor
@@ -0,0 +1,266 @@
+#include "sensor/aa/stereo_capture.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+
+namespace sensor
+{
+namespace aa
+{
+
+namespace
+{
+// 카메라가 멈췄을 때도 종료 여부를 확인하도록 캡처 대기 시간을 제한한다.
+constexpr std::chrono::milliseconds kGrabTimeout(200);
+
+// 디코딩 실패가 이만큼 이어지면 캡처 실패처럼 쉬었다가 다시 시도한다 (깨진 프레임 하나로는 쉬지 않는다).
+constexpr uint64_t kDecodeFailuresBeforeBackoff = 3;
+
+int64_t DiffUs(StereoCapture::Clock::time_point a, StereoCapture::Clock::time_point b)
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>(a - b).count();
+}
+}
+
+StereoCapture::StereoCapture()
+    : m_running(false)
+    , m_skewSumUs(0.0)
+{
+}
+
+StereoCapture::~StereoCapture()
+{
+    Stop();
+}
+
+void StereoCapture::Start(std::unique_ptr<CameraCapture> left, std::unique_ptr<CameraCapture> right, const Settings& settings)
+{
+    Stop();
+    m_settings = settings;
+    m_settings.ringFrames = std::max<size_t>(1, m_settings.ringFrames);
+    m_cameras[kLeft].capture = std::move(left);
+    m_cameras[kRight].capture = std::move(right);
+    for (auto& camera : m_cameras)
+    {
+        camera.ring.assign(m_settings.ringFrames, Slot());
+        for (auto& slot : camera.ring)
+        {
+            slot.frame.resize(StereoFrameSize());
+        }
+        camera.first = 0;
+        camera.count = 0;
+    }
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stats = Stats();
+        m_skewSumUs = 0.0;
+    }
+
+    m_running = true;
+    m_cameras[kLeft].thread = std::thread(&StereoCapture::CaptureLoop, this, kLeft);
+    m_cameras[kRight].thread = std::thread(&StereoCapture::CaptureLoop, this, kRight);
+}
+
+void StereoCapture::Stop()
+{
+    m_running = false;
+    m_cv.notify_all();
+    for (auto& camera : m_cameras)
+    {
+        if (camera.thread.joinable())
+        {
+            camera.thread.join();
+        }
+    }
+}
+
+bool StereoCapture::NextPair(std::vector<uint8_t>& frame, PairInfo& info, std::chrono::milliseconds timeout)
+{
+    // 처음 한 번만 할당된다. 이후에는 링 칸과 교환된 스테레오 버퍼가 돌아온다.
+    frame.resize(StereoFrameSize());
+    std::unique_lock<std::mutex> lock(m_mutex);
+    size_t l = 0;
+    size_t r = 0;
+    if (!m_cv.wait_for(lock, timeout, [&] { return !m_running || FindPair(l, r); }) || !m_running)
+    {
+        return false;
+    }
+
+    // 왼쪽 영상은 디코딩된 버퍼째로 넘기고 (링 칸은 호출자의 버퍼를 받아 다음 캡처에 쓴다), 오른쪽 절반만 복사한다.
+    Slot& slotL = At(kLeft, l);
+    const Slot& slotR = At(kRight, r);
+    const size_t half = StereoFrameSize() / 2;
+    slotL.frame.swap(frame);
+    std::memcpy(frame.data() + half, slotR.frame.data() + half, half);
+    info.timestamp[kLeft] = slotL.timestamp;
+    info.timestamp[kRight] = slotR.timestamp;
+    info.sequence[kLeft] = slotL.sequence;
+    info.sequence[kRight] = slotR.sequence;
+    info.skewUs = DiffUs(slotR.timestamp, slotL.timestamp);
+
+    // 짝보다 오래된 프레임은 더 이상 쓰지 않는다 (양쪽을 모두 센 뒤에 버려야 서로의 짝 여부를 볼 수 있다).
+    CountDrops(kLeft, l);
+    CountDrops(kRight, r);
+    Advance(kLeft, l + 1);
+    Advance(kRight, r + 1);
+
+    const double skew = static_cast<double>(std::abs(info.skewUs));
+    ++m_stats.pairs;
+    m_skewSumUs += skew;
+    m_stats.meanSkewUs = m_skewSumUs / m_stats.pairs;
+    m_stats.maxSkewUs = std::max(m_stats.maxSkewUs, skew);
+    return true;
+}
+
+size_t StereoCapture::StereoFrameSize() const
+{
+    return 2 * static_cast<size_t>(m_settings.width) * m_settings.height;
+}
+
+StereoCapture::Stats StereoCapture::GetStats() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_stats;
+}
+
+void StereoCapture::CaptureLoop(Side side)
+{
+    Camera& camera = m_cameras[side];
+    CapturedFrame frame;
+    // 디코딩은 잠금 밖에서 하고, 끝난 버퍼를 링 칸과 교환한다 (프레임마다 할당하지 않는다).
+    // 버퍼는 [좌 | 우] 스테레오 배치이고 이 카메라의 영상은 자기 쪽 절반에 바로 디코딩한다.
+    std::vector<uint8_t> scratch(StereoFrameSize());
+    const size_t offset = (side == kLeft) ? 0 : StereoFrameSize() / 2;
+    GrayJpegDecoder jpeg;
+    while (m_running)
+    {
+        const Clock::time_point grabStart = Clock::now();
+        const bool grabbed = camera.capture->Grab(frame, kGrabTimeout);
+        const bool ok = grabbed && DecodeGray(frame, scratch.data() + offset, m_settings.width, m_settings.height, jpeg);
+        if (!ok)
+        {
+            uint64_t consecutive = 0;
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                ++m_stats.failures[side];
+                consecutive = ++m_stats.consecutiveFailures[side];
+            }
+            // 뽑힌 장치는 poll이 바로 오류를 돌려주고 OpenCV 캡처는 제한 시간을 지키지 않으므로, 실패한 캡처는
+            // 적어도 제한 시간만큼 간격을 둔다 (바로 다시 시도하면 캡처 스레드가 CPU를 다 쓰고 NextPair와 잠금을 다툰다).
+            if (!grabbed || consecutive >= kDecodeFailuresBeforeBackoff)
+            {
+                std::this_thread::sleep_until(grabStart + kGrabTimeout);
+            }
+            continue;
+        }
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_stats.consecutiveFailures[side] = 0;
+            if (camera.count == camera.ring.size())
+            {
+                CountDrops(side, 1);
+                Advance(side, 1);
+            }
+            Slot& slot = camera.ring[(camera.first + camera.count) % camera.ring.size()];
+            slot.frame.swap(scratch);
+            slot.timestamp = frame.timestamp;
+            slot.sequence = frame.sequence;
+            ++camera.count;
+            ++m_stats.captured[side];
+        }
+        m_cv.notify_all();
+    }
+}
+
+// 잠금 상태에서 호출. 짝이 있으면 링 안의 위치를 돌려준다.
+bool StereoCapture::FindPair(size_t& left, size_t& right)
+{
+    Camera& cameraL = m_cameras[kLeft];
+    Camera& cameraR = m_cameras[kRight];
+    if (cameraL.count == 0 || cameraR.count == 0)
+    {
+        return false;
+    }
+
+    // 가장 최근 왼쪽 프레임부터, 캡처 시각이 가장 가까운 오른쪽 프레임이 허용 범위 안이면 짝으로 쓴다.
+    const int64_t toleranceUs = m_settings.tolerance.count();
+    for (size_t i = cameraL.count; i-- > 0;)
+    {
+        const Clock::time_point timestamp = At(kLeft, i).timestamp;
+        size_t best = cameraR.count;
+        int64_t bestSkew = 0;
+        for (size_t j = 0; j < cameraR.count; ++j)
+        {
+            const int64_t skew = std::abs(DiffUs(At(kRight, j).timestamp, timestamp));
+            if (best == cameraR.count || skew < bestSkew)
+            {
+                best = j;
+                bestSkew = skew;
+            }
+        }
+        if (best < cameraR.count && bestSkew <= toleranceUs)
+        {
+            left = i;
+            right = best;
+            return true;
+        }
+    }
+
+    // 짝이 없을 때: 상대 카메라의 가장 최근 프레임보다 허용 범위 이상 오래된 프레임은 앞으로도 짝이 생기지 않는다.
+    const Clock::time_point newestL = At(kLeft, cameraL.count - 1).timestamp;
+    const Clock::time_point newestR = At(kRight, cameraR.count - 1).timestamp;
+    while (cameraL.count > 0 && DiffUs(newestR, At(kLeft, 0).timestamp) > toleranceUs)
+    {
+        CountDrops(kLeft, 1);
+        Advance(kLeft, 1);
+    }
+    while (cameraR.count > 0 && DiffUs(newestL, At(kRight, 0).timestamp) > toleranceUs)
+    {
+        CountDrops(kRight, 1);
+        Advance(kRight, 1);
+    }
+    return false;
+}
+
+// 링 안의 i번째 프레임과 허용 범위 안인 상대 카메라 프레임이 있는지
+bool StereoCapture::HasPartner(Side side, size_t i)
+{
+    const Side other = (side == kLeft) ? kRight : kLeft;
+    const Clock::time_point timestamp = At(side, i).timestamp;
+    for (size_t j = 0; j < m_cameras[other].count; ++j)
+    {
+        if (std::abs(DiffUs(At(other, j).timestamp, timestamp)) <= m_settings.tolerance.count())
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+// 버릴 가장 오래된 frames개를 센다: 짝이 있던 프레임은 더 최신 짝에 밀린 것(skipped), 없던 프레임은 짝 없음(unpairedDrops)
+void StereoCapture::CountDrops(Side side, size_t frames)
+{
+    frames = std::min(frames, m_cameras[side].count);
+    for (size_t i = 0; i < frames; ++i)
+    {
+        ++(HasPartner(side, i) ? m_stats.skipped[side] : m_stats.unpairedDrops[side]);
+    }
+}
+
+void StereoCapture::Advance(Side side, size_t frames)
+{
+    Camera& camera = m_cameras[side];
+    frames = std::min(frames, camera.count);
+    camera.first = (camera.first + frames) % camera.ring.size();
+    camera.count -= frames;
+}
+
+StereoCapture::Slot& StereoCapture::At(Side side, size_t i)
+{
+    Camera& camera = m_cameras[side];
+    return camera.ring[(camera.first + i) % camera.ring.size()];
+}
+
+} /// namespace aa
+} /// namespace sensor
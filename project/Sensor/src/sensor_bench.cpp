@@ -0,0 +1,359 @@
+// Sensor 오프라인 벤치마크 (AUTOSAR 런타임 없이 단독 실행)
+//
+// 사용법:
+//   sensor_bench decode <recording.mjpeg> [옵션]
+//     - 녹화된 MJPEG 프레임(JPEG를 이어 붙인 파일)을 경로별로 160x120 그레이 영상까지 디코딩해 프레임당 시간(평균/p99)과
+//       첫 경로 대비 픽셀 차이(평균/최대 절대값)를 비교한다
+//       opencv        cv::imdecode(BGR) + cv::cvtColor(BGR2GRAY) + 출력 버퍼 복사 (기존 Sensor 경로)
+//       opencv-gray   cv::imdecode(IMREAD_GRAYSCALE)을 출력 버퍼 위에 바로 디코딩
+//       libjpeg-bgr   libjpeg 컬러(BGR) 디코딩 + 정수 BGR2GRAY (OpenCV와 같은 계수, OpenCV 없이 비교할 때의 기준)
+//       luma          GrayJpegDecoder: 밝기 성분만 출력 버퍼에 바로 디코딩 (현재 Sensor 경로)
+//       --paths <p,p,...>       비교할 경로 (기본: 빌드에 포함된 모든 경로)
+//       --iterations <N>        경로마다 디코딩할 프레임 수 (기본 2000, 녹화 프레임을 반복)
+//       --width <W> --height <H> 출력 크기 (기본 160x120, 녹화가 2/4/8배 크면 luma는 축소 디코딩)
+#include "sensor/aa/gray_jpeg_decoder.h"
+
+#include <opencv2/opencv.hpp>
+
+#ifdef SENSOR_WITH_LIBJPEG
+#include <csetjmp>
+#include <cstdio>
+#include <jpeglib.h>
+#endif
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <iterator>
+#include <map>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace
+{
+
+using Clock = std::chrono::steady_clock;
+using sensor::aa::GrayJpegDecoder;
+using sensor::aa::JpegFrameSpan;
+
+double Percentile(const std::vector<double>& sorted, double percent)
+{
+    if (sorted.empty())
+    {
+        return 0.0;
+    }
+    size_t index = static_cast<size_t>(percent / 100.0 * (sorted.size() - 1) + 0.5);
+    return sorted[std::min(index, sorted.size() - 1)];
+}
+
+std::vector<std::string> SplitList(const std::string& text)
+{
+    std::vector<std::string> items;
+    std::stringstream ss(text);
+    std::string item;
+    while (std::getline(ss, item, ','))
+    {
+        if (!item.empty())
+        {
+            items.push_back(item);
+        }
+    }
+    return items;
+}
+
+// 디코딩 경로 하나: JPEG 하나를 width x height 그레이로 dst에 쓴다 (실패하면 false).
+class DecodePath
+{
+public:
+    virtual ~DecodePath() = default;
+    virtual bool Decode(const uint8_t* data, size_t size, uint8_t* dst, int width, int height) = 0;
+};
+
+cv::Mat WrapJpeg(const uint8_t* data, size_t size)
+{
+    return cv::Mat(1, static_cast<int>(size), CV_8UC1, const_cast<uint8_t*>(data));
+}
+
+// 기존 Sensor 경로: VideoCapture가 BGR로 디코딩한 프레임을 cvtColor로 변환해 출력 버퍼에 복사
+class OpenCvPath : public DecodePath
+{
+public:
+    bool Decode(const uint8_t* data, size_t size, uint8_t* dst, int width, int height) override
+    {
+        m_bgr = cv::imdecode(WrapJpeg(data, size), cv::IMREAD_COLOR);
+        if (m_bgr.empty() || m_bgr.cols != width || m_bgr.rows != height)
+        {
+            return false;
+        }
+        cv::cvtColor(m_bgr, m_gray, cv::COLOR_BGR2GRAY);
+        std::copy(m_gray.data, m_gray.data + static_cast<size_t>(width) * height, dst);
+        return true;
+    }
+
+private:
+    cv::Mat m_bgr;
+    cv::Mat m_gray;
+};
+
+class OpenCvGrayPath : public DecodePath
+{
+public:
+    bool Decode(const uint8_t* data, size_t size, uint8_t* dst, int width, int height) override
+    {
+        cv::Mat gray(height, width, CV_8UC1, dst);
+        cv::imdecode(WrapJpeg(data, size), cv::IMREAD_GRAYSCALE, &gray);
+        return gray.data == dst && gray.cols == width && gray.rows == height;
+    }
+};
+
+#ifdef SENSOR_WITH_LIBJPEG
+
+struct JpegError
+{
+    jpeg_error_mgr pub;
+    jmp_buf jump;
+};
+
+void OnJpegError(j_common_ptr cinfo)
+{
+    longjmp(reinterpret_cast<JpegError*>(cinfo->err)->jump, 1);
+}
+
+void OnJpegMessage(j_common_ptr, int)
+{
+}
+
+// libjpeg 컬러 디코딩 + BGR2GRAY: 색차 업샘플링과 색 변환까지 하는 일반 경로를 OpenCV 없이 재현한다.
+class LibjpegBgrPath : public DecodePath
+{
+public:
+    LibjpegBgrPath()
+    {
+        m_cinfo.err = jpeg_std_error(&m_error.pub);
+        m_error.pub.error_exit = OnJpegError;
+        m_error.pub.emit_message = OnJpegMessage;
+        jpeg_create_decompress(&m_cinfo);
+    }
+
+    ~LibjpegBgrPath() override
+    {
+        jpeg_destroy_decompress(&m_cinfo);
+    }
+
+    bool Decode(const uint8_t* data, size_t size, uint8_t* dst, int width, int height) override
+    {
+        m_bgr.resize(static_cast<size_t>(width) * height * 3);
+        if (setjmp(m_error.jump))
+        {
+            jpeg_abort_decompress(&m_cinfo);
+            return false;
+        }
+        jpeg_mem_src(&m_cinfo, const_cast<unsigned char*>(data), static_cast<unsigned long>(size));
+        jpeg_read_header(&m_cinfo, TRUE);
+        if (m_cinfo.image_width != static_cast<JDIMENSION>(width) || m_cinfo.image_height != static_cast<JDIMENSION>(height))
+        {
+            jpeg_abort_decompress(&m_cinfo);
+            return false;
+        }
+        m_cinfo.out_color_space = JCS_EXT_BGR;
+        jpeg_start_decompress(&m_cinfo);
+        while (m_cinfo.output_scanline < m_cinfo.output_height)
+        {
+            JSAMPROW row = m_bgr.data() + static_cast<size_t>(m_cinfo.output_scanline) * width * 3;
+            jpeg_read_scanlines(&m_cinfo, &row, 1);
+        }
+        jpeg_abort_decompress(&m_cinfo);
+
+        // cv::cvtColor(COLOR_BGR2GRAY)의 8bit 고정소수점 계수 (0.114, 0.587, 0.299) << 14
+        const uint8_t* bgr = m_bgr.data();
+        for (size_t i = 0, n = static_cast<size_t>(width) * height; i < n; ++i, bgr += 3)
+        {
+            dst[i] = static_cast<uint8_t>((bgr[0] * 1868 + bgr[1] * 9617 + bgr[2] * 4899 + (1 << 13)) >> 14);
+        }
+        return true;
+    }
+
+private:
+    jpeg_decompress_struct m_cinfo;
+    JpegError m_error;
+    std::vector<uint8_t> m_bgr;
+};
+
+#endif
+
+class LumaPath : public DecodePath
+{
+public:
+    bool Decode(const uint8_t* data, size_t size, uint8_t* dst, int width, int height) override
+    {
+        return m_decoder.Decode(data, size, dst, width, height);
+    }
+
+private:
+    GrayJpegDecoder m_decoder;
+};
+
+std::unique_ptr<DecodePath> MakePath(const std::string& name)
+{
+    if (name == "opencv")
+    {
+        return std::make_unique<OpenCvPath>();
+    }
+    if (name == "opencv-gray")
+    {
+        return std::make_unique<OpenCvGrayPath>();
+    }
+#ifdef SENSOR_WITH_LIBJPEG
+    if (name == "libjpeg-bgr")
+    {
+        return std::make_unique<LibjpegBgrPath>();
+    }
+#endif
+    if (name == "luma")
+    {
+        return std::make_unique<LumaPath>();
+    }
+    throw std::runtime_error("unknown or unavailable decode path " + name);
+}
+
+int RunDecode(const std::string& recording, const std::map<std::string, std::string>& args)
+{
+    auto arg = [&](const std::string& key, const std::string& fallback) {
+        auto it = args.find(key);
+        return it == args.end() ? fallback : it->second;
+    };
+#ifdef SENSOR_WITH_LIBJPEG
+    const std::string defaultPaths = "opencv,opencv-gray,libjpeg-bgr,luma";
+#else
+    const std::string defaultPaths = "opencv,opencv-gray,luma";
+#endif
+    const std::vector<std::string> paths = SplitList(arg("paths", defaultPaths));
+    const int iterations = std::max(1, std::atoi(arg("iterations", "2000").c_str()));
+    const int width = std::max(1, std::atoi(arg("width", "160").c_str()));
+    const int height = std::max(1, std::atoi(arg("height", "120").c_str()));
+    if (paths.empty())
+    {
+        throw std::runtime_error("no decode paths");
+    }
+
+    std::ifstream file(recording, std::ios::binary);
+    const std::vector<uint8_t> stream((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    const std::vector<JpegFrameSpan> frames = sensor::aa::SplitMjpegStream(stream.data(), stream.size());
+    if (frames.empty())
+    {
+        throw std::runtime_error("no JPEG frames in " + recording);
+    }
+    std::cout << "decode: " << frames.size() << " frames from " << recording << ", output " << width << "x" << height
+              << ", " << iterations << " decodes per path" << std::endl;
+
+    const size_t frameSize = static_cast<size_t>(width) * height;
+    std::vector<uint8_t> reference; // 첫 경로의 녹화 프레임별 결과
+    std::cout << std::left << std::setw(14) << "path" << std::right << std::setw(12) << "us/frame" << std::setw(10) << "p99"
+              << std::setw(10) << "failed" << std::setw(12) << "mean|diff|" << std::setw(12) << "max|diff|" << std::endl;
+    std::cout << std::fixed << std::setprecision(1);
+    double baselineUs = 0.0;
+    for (const std::string& name : paths)
+    {
+        std::unique_ptr<DecodePath> path = MakePath(name);
+        std::vector<uint8_t> output(frameSize * frames.size());
+
+        // 예열 겸 차이 비교용으로 녹화 프레임을 한 번씩 디코딩한다.
+        size_t failed = 0;
+        for (size_t f = 0; f < frames.size(); ++f)
+        {
+            if (!path->Decode(stream.data() + frames[f].offset, frames[f].size, output.data() + f * frameSize, width, height))
+            {
+                ++failed;
+            }
+        }
+
+        std::vector<double> latencies;
+        latencies.reserve(iterations);
+        std::vector<uint8_t> dst(frameSize);
+        for (int i = 0; i < iterations; ++i)
+        {
+            const JpegFrameSpan& span = frames[i % frames.size()];
+            const Clock::time_point start = Clock::now();
+            path->Decode(stream.data() + span.offset, span.size, dst.data(), width, height);
+            latencies.push_back(std::chrono::duration<double, std::micro>(Clock::now() - start).count());
+        }
+        double sumUs = 0.0;
+        for (double us : latencies)
+        {
+            sumUs += us;
+        }
+        const double meanUs = sumUs / latencies.size();
+        std::sort(latencies.begin(), latencies.end());
+
+        double diffSum = 0.0;
+        int diffMax = 0;
+        if (reference.empty())
+        {
+            reference = output;
+            baselineUs = meanUs;
+        }
+        for (size_t i = 0; i < output.size(); ++i)
+        {
+            const int diff = std::abs(static_cast<int>(output[i]) - static_cast<int>(reference[i]));
+            diffSum += diff;
+            diffMax = std::max(diffMax, diff);
+        }
+        std::cout << std::left << std::setw(14) << name << std::right << std::setw(12) << meanUs << std::setw(10)
+                  << Percentile(latencies, 99) << std::setw(10) << failed << std::setw(12) << std::setprecision(3)
+                  << diffSum / output.size() << std::setw(12) << diffMax << std::setprecision(1) << "   x"
+                  << baselineUs / meanUs << std::endl;
+    }
+    std::cout << "decode: diff and speedup are relative to " << paths.front() << std::endl;
+    return EXIT_SUCCESS;
+}
+
+void PrintUsage()
+{
+    std::cerr << "usage: sensor_bench decode <recording.mjpeg> [--paths p,p,...] [--iterations N] [--width W] [--height H]"
+              << std::endl;
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    if (argc < 3)
+    {
+        PrintUsage();
+        return EXIT_FAILURE;
+    }
+
+    std::string mode = argv[1];
+    if (mode != "decode")
+    {
+        PrintUsage();
+        return EXIT_FAILURE;
+    }
+    std::map<std::string, std::string> args;
+    for (int i = 3; i + 1 < argc; i += 2)
+    {
+        std::string key = argv[i];
+        if (key.compare(0, 2, "--") != 0)
+        {
+            PrintUsage();
+            return EXIT_FAILURE;
+        }
+        args[key.substr(2)] = argv[i + 1];
+    }
+    try
+    {
+        return RunDecode(argv[2], args);
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << mode << ": " << e.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+}